@@ -6,6 +6,8 @@
 #include "ThreadName.h"
 #include "net/minecraft/client/main/GameConfiguration.h"
 #include "net/minecraft/client/Minecraft.h"
+#include "net/minecraft/util/datafix/DataFixesManager.h"
+#include "net/minecraft/world/storage/WorldUpgrader.h"
 #include <nlohmann/json.hpp>
 
 
@@ -40,6 +42,8 @@ int main(int argc, char **argv) {
     args::ValueFlag<std::string> assetIndex(parser, "assetIndex", "Asset Index", {"assetIndex"});
     args::ValueFlag<std::string> userType(parser, "userType", "User Type", {"userType"}, "legacy");
     args::ValueFlag<std::string> versionType(parser, "versionType", "Version Type", {"versionType"}, "release");
+    args::ValueFlag<std::string> upgradeWorld(parser, "upgradeWorld", "Upgrade a stopped world to the current data version and exit", {"upgradeWorld"});
+    args::ValueFlag<uint32_t> upgradeThreads(parser, "upgradeThreads", "Upgrade Threads", {"upgradeThreads"}, 0);
 
     try {
         parser.ParseCLI(argc, argv);
@@ -57,6 +61,12 @@ int main(int argc, char **argv) {
         return 1;
     }
 
+    if (upgradeWorld)
+    {
+        auto datafixer = DataFixesManager::createFixer();
+        WorldUpgrader(upgradeWorld.Get(), datafixer, upgradeThreads.Get()).run();
+        return 0;
+    }
 
     auto propertymap = json::parse(userProperties.Get()).get<PropertyMap>();
     auto propertymap1 = json::parse(profileProperties.Get()).get<PropertyMap>();
@@ -8,6 +8,7 @@
 #include "../util/text/translation/I18n.h"
 #include "../world/IBlockAccess.h"
 #include "../world/chunk/BlockStateContainer.h"
+#include "state/CollisionShapeCache.h"
 #include <material/Material.h>
 
 ResourceLocation Block::AIR_ID("air");
@@ -805,6 +806,7 @@ void Block::registerBlocks() {
                 }
             }
 
+            CollisionShapeCache::build();
             return;
         }
     }
@@ -1019,6 +1021,10 @@ bool Block::isCollidable() const {
     return true;
 }
 
+bool Block::hasDynamicShape() {
+    return false;
+}
+
 void Block::randomTick(World *worldIn, const BlockPos &pos, IBlockState *state, pcg32 &random) {
     updateTick(worldIn, pos, state, random);
 }
@@ -1079,11 +1085,11 @@ void Block::dropBlockAsItem(World *worldIn, const BlockPos &pos, IBlockState *st
 void Block::dropBlockAsItemWithChance(World *worldIn, const BlockPos &pos, IBlockState *state, float chance,
                                       int32_t fortune) {
     if (!worldIn->isRemote) {
-        auto i = quantityDroppedWithBonus(fortune, worldIn->rand);
+        auto i = quantityDroppedWithBonus(fortune, worldIn->getRandom());
 
         for (auto j = 0; j < i; ++j) {
-            if (MathHelper::nextFloat(worldIn->rand) <= chance) {
-                auto *item = getItemDropped(state, worldIn->rand, fortune);
+            if (MathHelper::nextFloat(worldIn->getRandom()) <= chance) {
+                auto *item = getItemDropped(state, worldIn->getRandom(), fortune);
                 if (item != Items::AIR) {
                     spawnAsEntity(worldIn, pos, ItemStack(item, 1, damageDropped(state)));
                 }
@@ -1095,9 +1101,9 @@ void Block::dropBlockAsItemWithChance(World *worldIn, const BlockPos &pos, IBloc
 void Block::spawnAsEntity(World *worldIn, const BlockPos &pos, ItemStack stack) {
     if (!worldIn->isRemote && !stack.isEmpty() && worldIn->getGameRules().getBoolean("doTileDrops")) {
         float f = 0.5F;
-        double d0 = (double)(MathHelper::nextFloat(worldIn->rand) * 0.5F) + 0.25;
-        double d1 = (double)(MathHelper::nextFloat(worldIn->rand) * 0.5F) + 0.25;
-        double d2 = (double)(MathHelper::nextFloat(worldIn->rand) * 0.5F) + 0.25;
+        double d0 = (double)(MathHelper::nextFloat(worldIn->getRandom()) * 0.5F) + 0.25;
+        double d1 = (double)(MathHelper::nextFloat(worldIn->getRandom()) * 0.5F) + 0.25;
+        double d2 = (double)(MathHelper::nextFloat(worldIn->getRandom()) * 0.5F) + 0.25;
         EntityItem *entityitem = new EntityItem(worldIn, (double)pos.getx() + d0, (double)pos.gety() + d1,
                                                 (double)pos.getz() + d2, stack);
         entityitem->setDefaultPickupDelay();
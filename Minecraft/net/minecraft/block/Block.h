@@ -75,6 +75,10 @@ public:
     virtual bool isOpaqueCube(IBlockState *state);
     virtual bool canCollideCheck(IBlockState *state, bool hitIfLiquid);
     bool isCollidable() const;
+    // Collision boxes come from CollisionShapeCache, which asks getCollisionBoundingBox once per state. Blocks whose
+    // box depends on something the cache cannot see, such as an entity or a tile entity, return true and are asked
+    // at every position. Reads of the world itself are caught while the cache is built.
+    virtual bool hasDynamicShape();
     void randomTick(World *worldIn, const BlockPos &pos, IBlockState *state, pcg32 &random);
     virtual void randomDisplayTick(IBlockState *stateIn, World *worldIn, const BlockPos &pos, pcg32 &rand);
     void onPlayerDestroy(World *worldIn, const BlockPos &pos, IBlockState *state);
@@ -41,12 +41,12 @@ void BlockContainer::harvestBlock(World worldIn, EntityPlayer player, BlockPos p
         }
 
         int i = EnchantmentHelper.getEnchantmentLevel(Enchantments.FORTUNE, stack);
-        Item item = getItemDropped(state, worldIn.rand, i);
+        Item item = getItemDropped(state, worldIn.getRandom(), i);
         if (item == Items.AIR) {
             return;
         }
 
-        ItemStack itemstack = ItemStack(item, quantityDropped(worldIn.rand));
+        ItemStack itemstack = ItemStack(item, quantityDropped(worldIn.getRandom()));
         itemstack.setStackDisplayName(((IWorldNameable)te).getName());
         spawnAsEntity(worldIn, pos, itemstack);
     } else {
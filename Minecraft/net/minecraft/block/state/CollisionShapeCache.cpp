@@ -0,0 +1,139 @@
+#include "CollisionShapeCache.h"
+#include "IBlockState.h"
+#include "../Block.h"
+#include "../../util/math/BlockPos.h"
+#include "../../world/IBlockAccess.h"
+
+std::unordered_map<IBlockState*, CollisionShapeCache::Shape> CollisionShapeCache::shapes;
+
+namespace
+{
+	struct WorldAccessed
+	{
+	};
+
+	// Handed to getCollisionBoundingBox while the table is built. A shape that looks at the world depends on
+	// where it is placed after all, every read bails out and the state stays uncached.
+	class ShapeProbe : public IBlockAccess
+	{
+	public:
+		TileEntity* getTileEntity(const BlockPos&) override
+		{
+			throw WorldAccessed();
+		}
+
+		uint32_t getCombinedLight(const BlockPos&, uint32_t) override
+		{
+			throw WorldAccessed();
+		}
+
+		IBlockState* getBlockState(const BlockPos&) override
+		{
+			throw WorldAccessed();
+		}
+
+		bool isAirBlock(const BlockPos&) override
+		{
+			throw WorldAccessed();
+		}
+
+		Biome& getBiome(const BlockPos&) override
+		{
+			throw WorldAccessed();
+		}
+
+		uint32_t getStrongPower(const BlockPos&, EnumFacing&) override
+		{
+			throw WorldAccessed();
+		}
+
+		WorldType getWorldType() override
+		{
+			throw WorldAccessed();
+		}
+	};
+}
+
+void CollisionShapeCache::build()
+{
+	shapes.clear();
+	shapes.reserve(Block::BLOCK_STATE_IDS.size());
+	for (auto& entry : Block::BLOCK_STATE_IDS)
+	{
+		if (entry.first->getBlock()->hasDynamicShape())
+		{
+			continue;
+		}
+
+		auto shape = computeShape(entry.first);
+		if (shape)
+		{
+			shapes.emplace(entry.first, std::move(*shape));
+		}
+	}
+}
+
+const CollisionShapeCache::Shape* CollisionShapeCache::get(IBlockState* state)
+{
+	auto shape = shapes.find(state);
+	return shape == shapes.end() ? nullptr : &shape->second;
+}
+
+void CollisionShapeCache::addCollisionBoxes(const Shape& shape, const BlockPos& pos, const AxisAlignedBB& entityBox, std::vector<AxisAlignedBB>& collidingBoxes)
+{
+	switch (shape.type)
+	{
+	case ShapeType::EMPTY:
+		break;
+	case ShapeType::FULL_CUBE:
+	{
+		double x = pos.getx();
+		double y = pos.gety();
+		double z = pos.getz();
+		if (entityBox.intersects(x, y, z, x + 1.0, y + 1.0, z + 1.0))
+		{
+			collidingBoxes.emplace_back(x, y, z, x + 1.0, y + 1.0, z + 1.0);
+		}
+
+		break;
+	}
+	case ShapeType::BOXES:
+		for (auto& box : shape.boxes)
+		{
+			auto axisalignedbb = box.offset(pos);
+			if (entityBox.intersects(axisalignedbb))
+			{
+				collidingBoxes.emplace_back(axisalignedbb);
+			}
+		}
+
+		break;
+	}
+}
+
+std::optional<CollisionShapeCache::Shape> CollisionShapeCache::computeShape(IBlockState* state)
+{
+	// Block::addCollisionBoxToList adds exactly this box, blocks adding more than one have dynamic shapes
+	ShapeProbe probe;
+	std::optional<AxisAlignedBB> box;
+	try
+	{
+		box = state->getCollisionBoundingBox(&probe, BlockPos(0, 0, 0));
+	}
+	catch (const WorldAccessed&)
+	{
+		return std::nullopt;
+	}
+
+	if (!box)
+	{
+		return Shape{ShapeType::EMPTY, {}};
+	}
+
+	if (*box == Block::FULL_BLOCK_AABB)
+	{
+		return Shape{ShapeType::FULL_CUBE, {}};
+	}
+
+	return Shape{ShapeType::BOXES, {*box}};
+}
@@ -0,0 +1,41 @@
+#pragma once
+#include <cstdint>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+#include "../../util/math/AxisAlignedBB.h"
+
+class BlockPos;
+class IBlockState;
+
+// Collision boxes of every registered block state whose shape does not depend on where it is placed, taken once
+// after the blocks are registered. Blocks that return true from Block::hasDynamicShape() are left out, and so is a
+// state that reads the world while its box is taken; those ask their block each time. The table is read-only
+// after build(), so any thread may read it.
+class CollisionShapeCache
+{
+public:
+	enum class ShapeType : uint8_t
+	{
+		EMPTY,
+		FULL_CUBE,
+		BOXES
+	};
+
+	struct Shape
+	{
+		ShapeType type;
+		// relative to the block origin, only set for BOXES
+		std::vector<AxisAlignedBB> boxes;
+	};
+
+	static void build();
+	// The shape of state, or nullptr when the state has to be asked for its boxes.
+	static const Shape* get(IBlockState* state);
+	// Appends the boxes of shape placed at pos that intersect entityBox.
+	static void addCollisionBoxes(const Shape& shape, const BlockPos& pos, const AxisAlignedBB& entityBox, std::vector<AxisAlignedBB>& collidingBoxes);
+private:
+	static std::unordered_map<IBlockState*, Shape> shapes;
+
+	static std::optional<Shape> computeShape(IBlockState* state);
+};
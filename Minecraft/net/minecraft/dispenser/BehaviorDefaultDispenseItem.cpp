@@ -25,13 +25,13 @@ void BehaviorDefaultDispenseItem::doDispense(World *worldIn, const ItemStack &st
     }
 
     EntityItem* entityitem = new EntityItem(worldIn, d0, d1, d2, stack);
-    double d3 = MathHelper::nextDouble(worldIn->rand) * 0.1 + 0.2;
+    double d3 = MathHelper::nextDouble(worldIn->getRandom()) * 0.1 + 0.2;
     entityitem->motionX = (double)facing.getXOffset() * d3;
     entityitem->motionY = 0.20000000298023224;
     entityitem->motionZ = (double)facing.getZOffset() * d3;
-    entityitem->motionX += MathHelper::nextGaussian<double>(worldIn->rand) * 0.007499999832361937 * (double)speed;
-    entityitem->motionY += MathHelper::nextGaussian<double>(worldIn->rand) * 0.007499999832361937 * (double)speed;
-    entityitem->motionZ += MathHelper::nextGaussian<double>(worldIn->rand) * 0.007499999832361937 * (double)speed;
+    entityitem->motionX += MathHelper::nextGaussian<double>(worldIn->getRandom()) * 0.007499999832361937 * (double)speed;
+    entityitem->motionY += MathHelper::nextGaussian<double>(worldIn->getRandom()) * 0.007499999832361937 * (double)speed;
+    entityitem->motionZ += MathHelper::nextGaussian<double>(worldIn->getRandom()) * 0.007499999832361937 * (double)speed;
     worldIn->spawnEntity(entityitem);
 }
 
@@ -1,6 +1,8 @@
 #include "Entity.h"
 
+#include <algorithm>
 #include <typeindex>
+#include <utility>
 
 
 
@@ -33,6 +35,7 @@
 #include "text/translation/I18n.h"
 
 std::shared_ptr<spdlog::logger> Entity::LOGGER = spdlog::get("Minecraft")->clone("Entity");
+std::atomic<int32_t> Entity::nextEntityID{0};
 
 DataParameter Entity::FLAGS = EntityDataManager.createKey(Entity.class, DataSerializers.BYTE);
 DataParameter Entity::AIR = EntityDataManager.createKey(Entity.class, DataSerializers.VARINT);
@@ -41,6 +44,19 @@ DataParameter Entity::CUSTOM_NAME_VISIBLE = EntityDataManager.createKey(Entity.c
 DataParameter Entity::SILENT = EntityDataManager.createKey(Entity.class, DataSerializers.BOOLEAN);
 DataParameter Entity::NO_GRAVITY = EntityDataManager.createKey(Entity.class, DataSerializers.BOOLEAN);
 
+namespace
+{
+    // Reused by move() on every thread; nothing between filling and reading it can re-enter move().
+    thread_local std::vector<AxisAlignedBB> collisionBoxes;
+
+    std::vector<AxisAlignedBB>& gatherCollisionBoxes(World* world, Entity* entityIn, const AxisAlignedBB& aabb)
+    {
+        collisionBoxes.clear();
+        world->getCollisionBoxes(entityIn, aabb, collisionBoxes);
+        return collisionBoxes;
+    }
+}
+
 
 class EntityDataWalker :public IDataWalker
 {
@@ -64,7 +80,7 @@ public:
 Entity::Entity(World *worldIn)
     :entityId(nextEntityID++),boundingBox(ZERO_AABB),width(0.6F),height(1.8F),nextStepDistance(1),nextFlap(1.0F)
     ,firstUpdate(true),entityUniqueID(MathHelper::getRandomUUID(rand)),cachedUniqueIdString(entityUniqueID.str())
-    ,pistonDeltas({0.0, 0.0, 0.0}),world(worldIn)
+    ,world(worldIn)
 {
     fire = -getFireImmuneTicks();
     setPosition(0.0, 0.0, 0.0);
@@ -94,13 +110,51 @@ void Entity::setEntityId(int32_t id)
     entityId = id;
 }
 
+EntityHandle Entity::getHandle() const
+{
+    return handle;
+}
+
+void Entity::setHandle(EntityHandle handleIn)
+{
+    handle = handleIn;
+}
+
+bool Entity::markDataDirty(uint64_t fields)
+{
+    auto wasClean = dirtyData == 0;
+    dirtyData |= fields;
+    return wasClean;
+}
+
+bool Entity::hasDirtyData() const
+{
+    return dirtyData != 0;
+}
+
+uint64_t Entity::takeDirtyData()
+{
+    return std::exchange(dirtyData, 0);
+}
+
+Entity::ColdState& Entity::getColdState()
+{
+    if (coldState == nullptr)
+    {
+        coldState = std::make_unique<ColdState>();
+    }
+
+    return *coldState;
+}
+
 std::unordered_set<std::string> Entity::getTags() const
 {
-    return tags;
+    return coldState != nullptr ? coldState->tags : std::unordered_set<std::string>();
 }
 
 bool Entity::addTag(std::string_view tag)
 {
+    auto& tags = getColdState().tags;
     if (tags.size() >= 1024) 
     {
         return false;
@@ -114,7 +168,7 @@ bool Entity::addTag(std::string_view tag)
 
 bool Entity::removeTag(std::string_view tag)
 {
-    return tags.erase(tag);
+    return coldState != nullptr && coldState->tags.erase(tag);
 }
 
 void Entity::onKillCommand()
@@ -122,7 +176,12 @@ void Entity::onKillCommand()
     setDead();
 }
 
-EntityDataManager Entity::getDataManager()
+EntityDataManager& Entity::getDataManager()
+{
+    return dataManager;
+}
+
+const EntityDataManager& Entity::getDataManager() const
 {
     return dataManager;
 }
@@ -173,7 +232,10 @@ void Entity::onUpdate()
 
  void Entity::notifyDataManagerChange(DataParameter key)
 {
-    
+    if (world != nullptr && !world->isRemote)
+    {
+        world->markEntityDataDirty(this, key.getId());
+    }
 }
 
 EnumFacing Entity::getHorizontalFacing() const
@@ -265,7 +327,7 @@ void Entity::setCommandStat(const CommandResultStatsType &type, int32_t amount)
 {
     if (world != nullptr && !world->isRemote) 
     {
-        cmdResultStats.setCommandStatForSender(world->getMinecraftServer(), this, type, amount);
+        getColdState().cmdResultStats.setCommandStatForSender(world->getMinecraftServer(), this, type, amount);
     }
 }
 
@@ -276,12 +338,12 @@ MinecraftServer * Entity::getServer()
 
 CommandResultStats Entity::getCommandStats() const
 {
-    return cmdResultStats;
+    return coldState != nullptr ? coldState->cmdResultStats : CommandResultStats();
 }
 
 void Entity::setCommandStats(Entity *entityIn)
 {
-    cmdResultStats.addAllStats(entityIn->getCommandStats());
+    getColdState().cmdResultStats.addAllStats(entityIn->getCommandStats());
 }
 
 EnumActionResult Entity::applyPlayerInteraction(EntityPlayer *player, Vec3d vec, EnumHand hand)
@@ -581,6 +643,62 @@ void Entity::onEntityUpdate()
     world->profiler.endSection();
 }
 
+void Entity::inactiveTick()
+{
+    if (rideCooldown > 0) 
+    {
+        --rideCooldown;
+    }
+
+    decrementTimeUntilPortal();
+    if (fire > 0) 
+    {
+        if (bisImmuneToFire) 
+        {
+            fire -= 4;
+            if (fire < 0) 
+            {
+                extinguish();
+            }
+        }
+        else 
+        {
+            if (fire % 20 == 0) 
+            {
+                attackEntityFrom(DamageSource::DamageSource::ON_FIRE, 1.0F);
+            }
+
+            --fire;
+        }
+
+        setFlag(0, fire > 0);
+    }
+}
+
+void Entity::wakeUp(int32_t ticks)
+{
+    if (dormant) 
+    {
+        world->wakeEntity(this);
+    }
+
+    activatedTick = std::max(activatedTick, world->getTotalWorldTime() + ticks);
+}
+
+void Entity::onWake()
+{
+}
+
+EntityActivationRange::Category Entity::getActivationCategory()
+{
+    if (activationCategory == UINT8_MAX) 
+    {
+        activationCategory = EntityActivationRange::getCategory(this);
+    }
+
+    return static_cast<EntityActivationRange::Category>(activationCategory);
+}
+
 int32_t Entity::getMaxInPortalTime() const
 {
     return 1;
@@ -623,6 +741,8 @@ void Entity::move(const MoverType &type, double x, double y, double z)
         if (type == MoverType::PISTON) 
         {
             int64_t i = world->getTotalWorldTime();
+            auto& pistonDeltas = getColdState().pistonDeltas;
+            auto& pistonDeltasGameTime = coldState->pistonDeltasGameTime;
             if (i != pistonDeltasGameTime) 
             {
                 std::fill(pistonDeltas.begin(),pistonDeltas.end(),0.0);
@@ -691,7 +811,7 @@ void Entity::move(const MoverType &type, double x, double y, double z)
         double d4 = z;
         if ((type == MoverType::SELF || type == MoverType::PLAYER) && onGround && isSneaking() && Util::instanceof<EntityPlayer>(this)) 
         {
-            for(double var20 = 0.05; x != 0.0 && world->getCollisionBoxes(this, getEntityBoundingBox().offset(x, -stepHeight, 0.0))->empty(); d2 = x) 
+            for(double var20 = 0.05; x != 0.0 && gatherCollisionBoxes(world, this, getEntityBoundingBox().offset(x, -stepHeight, 0.0)).empty(); d2 = x) 
             {
                 if (x < 0.05 && x >= -0.05) 
                 {
@@ -707,7 +827,7 @@ void Entity::move(const MoverType &type, double x, double y, double z)
                 }
             }
 
-            for(; z != 0.0 && world->getCollisionBoxes(this, getEntityBoundingBox().offset(0.0, -stepHeight, z))->empty(); d4 = z) 
+            for(; z != 0.0 && gatherCollisionBoxes(world, this, getEntityBoundingBox().offset(0.0, -stepHeight, z)).empty(); d4 = z) 
             {
                 if (z < 0.05 && z >= -0.05) 
                 {
@@ -723,7 +843,7 @@ void Entity::move(const MoverType &type, double x, double y, double z)
                 }
             }
 
-            for(; x != 0.0 && z != 0.0 && world->getCollisionBoxes(this, getEntityBoundingBox().offset(x, -stepHeight, z))->empty(); d4 = z) 
+            for(; x != 0.0 && z != 0.0 && gatherCollisionBoxes(world, this, getEntityBoundingBox().offset(x, -stepHeight, z)).empty(); d4 = z) 
             {
                 if (x < 0.05 && x >= -0.05) 
                 {
@@ -754,14 +874,14 @@ void Entity::move(const MoverType &type, double x, double y, double z)
             }
         }
 
-        auto list1 = world->getCollisionBoxes(this, getEntityBoundingBox().expand(x, y, z));
+        auto& list1 = gatherCollisionBoxes(world, this, getEntityBoundingBox().expand(x, y, z));
         AxisAlignedBB axisalignedbb = getEntityBoundingBox();
         int32_t k5 = 0;
         int32_t j6 = 0;
 
         if (y != 0.0) 
         {
-            for(auto boxes : list1.value())
+            for(auto& boxes : list1)
             {
                 y = boxes.calculateYOffset(getEntityBoundingBox(), y);
             }
@@ -771,7 +891,7 @@ void Entity::move(const MoverType &type, double x, double y, double z)
 
         if (x != 0.0) 
         {
-            for(auto boxes : list1.value())
+            for(auto& boxes : list1)
             {
                 x = boxes.calculateXOffset(getEntityBoundingBox(), x);
             }
@@ -784,7 +904,7 @@ void Entity::move(const MoverType &type, double x, double y, double z)
 
         if (z != 0.0) 
         {
-            for(auto boxes : list1.value())
+            for(auto& boxes : list1)
             {
                 z = boxes.calculateZOffset(getEntityBoundingBox(), z);
             }
@@ -805,7 +925,7 @@ void Entity::move(const MoverType &type, double x, double y, double z)
             AxisAlignedBB axisalignedbb1 = getEntityBoundingBox();
             setEntityBoundingBox(axisalignedbb);
             y = stepHeight;
-            auto list = world->getCollisionBoxes(this, getEntityBoundingBox().expand(d2, y, d4)).value();
+            auto& list = gatherCollisionBoxes(world, this, getEntityBoundingBox().expand(d2, y, d4));
             AxisAlignedBB axisalignedbb2 = getEntityBoundingBox();
             AxisAlignedBB axisalignedbb3 = axisalignedbb2.expand(d2, 0.0, d4);
             d8 = y;
@@ -891,127 +1011,166 @@ void Entity::move(const MoverType &type, double x, double y, double z)
 
         world->profiler.endSection();
         world->profiler.startSection("rest");
-        resetPositionToBB();
-        collidedHorizontally = d2 != x || d4 != z;
-        collidedVertically = y != y;
-        onGround = collidedVertically && d3 < 0.0;
-        collided = collidedHorizontally || collidedVertically;
-        j6 = MathHelper::floor(posX);
-        int32_t i1 = MathHelper::floor(posY - 0.20000000298023224);
-        int32_t k6 = MathHelper::floor(posZ);
-        BlockPos blockpos = BlockPos(j6, i1, k6);
-        IBlockState* iblockstate = world->getBlockState(blockpos);
-        if (iblockstate->getMaterial() == Material::AIR) 
-        {
-            BlockPos blockpos1 = blockpos.down();
-            IBlockState* iblockstate1 = world->getBlockState(blockpos1);
-            Block* block1 = iblockstate1->getBlock();
-            if (Util::instanceof<BlockFence>(block1) || Util::instanceof<BlockWall>(block1) || Util::instanceof<BlockFenceGate>(block1)) 
-            {
-                iblockstate = iblockstate1;
-                blockpos = blockpos1;
-            }
-        }
+        finishMove(d10, d11, d1, d2, d3, d4, x, y, z);
+        world->profiler.endSection();
+    }
+}
+
+void Entity::moveUnobstructed(double x, double y, double z)
+{
+    world->profiler.startSection("move");
+    double d10 = posX;
+    double d11 = posY;
+    double d1 = posZ;
+    setEntityBoundingBox(getEntityBoundingBox().offset(x, y, z));
+    world->profiler.endStartSection("rest");
+    finishMove(d10, d11, d1, x, y, z, x, y, z);
+    world->profiler.endSection();
+}
+
+bool Entity::canMoveUnobstructed() const
+{
+    return !noClip && !isInWeb;
+}
 
-        updateFallState(y, onGround, iblockstate, blockpos);
-        if (d2 != x) 
+void Entity::updatePhysics(double gravity, const EntityPhysicsBatch::Drag& drag)
+{
+    if (world->queuePhysics(this, gravity, drag))
+    {
+        return;
+    }
+
+    motionY -= gravity;
+    move(MoverType::SELF, motionX, motionY, motionZ);
+    EntityPhysicsBatch::applyDrag(this, drag);
+    onPhysicsUpdate();
+}
+
+void Entity::onPhysicsUpdate()
+{
+}
+
+void Entity::finishMove(double startX, double startY, double startZ, double d2, double d3, double d4, double x, double y, double z)
+{
+    resetPositionToBB();
+    collidedHorizontally = d2 != x || d4 != z;
+    collidedVertically = d3 != y;
+    onGround = collidedVertically && d3 < 0.0;
+    collided = collidedHorizontally || collidedVertically;
+    int32_t j6 = MathHelper::floor(posX);
+    int32_t i1 = MathHelper::floor(posY - 0.20000000298023224);
+    int32_t k6 = MathHelper::floor(posZ);
+    BlockPos blockpos = BlockPos(j6, i1, k6);
+    IBlockState* iblockstate = world->getBlockState(blockpos);
+    if (iblockstate->getMaterial() == Material::AIR) 
+    {
+        BlockPos blockpos1 = blockpos.down();
+        IBlockState* iblockstate1 = world->getBlockState(blockpos1);
+        Block* block1 = iblockstate1->getBlock();
+        if (Util::instanceof<BlockFence>(block1) || Util::instanceof<BlockWall>(block1) || Util::instanceof<BlockFenceGate>(block1)) 
         {
-            motionX = 0.0;
+            iblockstate = iblockstate1;
+            blockpos = blockpos1;
         }
+    }
+
+    updateFallState(y, onGround, iblockstate, blockpos);
+    if (d2 != x) 
+    {
+        motionX = 0.0;
+    }
+
+    if (d4 != z) 
+    {
+        motionZ = 0.0;
+    }
+
+    Block* block = iblockstate->getBlock();
+    if (d3 != y) 
+    {
+        block->onLanded(world, this);
+    }
 
-        if (d4 != z) 
+    if (canTriggerWalking() && (!onGround || !isSneaking() || !
+        Util::instanceof<EntityPlayer>(this)) && !isRiding()) 
+    {
+        double d15 = posX - startX;
+        double d16 = posY - startY;
+        double d8 = posZ - startZ;
+        if (block != Blocks::LADDER) 
         {
-            motionZ = 0.0;
+            d16 = 0.0;
         }
 
-        Block* block = iblockstate->getBlock();
-        if (d3 != y) 
+        if (block != nullptr && onGround) 
         {
-            block->onLanded(world, this);
+            block->onEntityWalk(world, blockpos, this);
         }
 
-        if (canTriggerWalking() && (!onGround || !isSneaking() || !
-            Util::instanceof<EntityPlayer>(this)) && !isRiding()) 
+        distanceWalkedModified = distanceWalkedModified + MathHelper::sqrt(d15 * d15 + d8 * d8) * 0.6;
+        distanceWalkedOnStepModified = distanceWalkedOnStepModified + MathHelper::sqrt(d15 * d15 + d16 * d16 + d8 * d8) * 0.6;
+        if (distanceWalkedOnStepModified > nextStepDistance && iblockstate->getMaterial() != Material::AIR) 
         {
-            double d15 = posX - d10;
-            double d16 = posY - d11;
-            d8 = posZ - d1;
-            if (block != Blocks::LADDER) 
-            {
-                d16 = 0.0;
-            }
-
-            if (block != nullptr && onGround) 
+            nextStepDistance = distanceWalkedOnStepModified + 1;
+            if (!isInWater()) 
             {
-                block->onEntityWalk(world, blockpos, this);
+                playStepSound(blockpos, block);
             }
-
-            distanceWalkedModified = distanceWalkedModified + MathHelper::sqrt(d15 * d15 + d8 * d8) * 0.6;
-            distanceWalkedOnStepModified = distanceWalkedOnStepModified + MathHelper::sqrt(d15 * d15 + d16 * d16 + d8 * d8) * 0.6;
-            if (distanceWalkedOnStepModified > nextStepDistance && iblockstate->getMaterial() != Material::AIR) 
+            else 
             {
-                nextStepDistance = distanceWalkedOnStepModified + 1;
-                if (!isInWater()) 
+                Entity* entity = isBeingRidden() && getControllingPassenger() != nullptr ? getControllingPassenger() : this;
+                float f = entity == this ? 0.35F : 0.4F;
+                float f1 = MathHelper::sqrt(entity->motionX * entity->motionX * 0.20000000298023224 + entity->motionY * entity->motionY + entity->motionZ * entity->motionZ * 0.20000000298023224) * f;
+                if (f1 > 1.0F) 
                 {
-                    playStepSound(blockpos, block);
+                    f1 = 1.0F;
                 }
-                else 
-                {
-                    Entity* entity = isBeingRidden() && getControllingPassenger() != nullptr ? getControllingPassenger() : this;
-                    float f = entity == this ? 0.35F : 0.4F;
-                    float f1 = MathHelper::sqrt(entity->motionX * entity->motionX * 0.20000000298023224 + entity->motionY * entity->motionY + entity->motionZ * entity->motionZ * 0.20000000298023224) * f;
-                    if (f1 > 1.0F) 
-                    {
-                        f1 = 1.0F;
-                    }
 
-                    playSound(getSwimSound(), f1, 1.0F + (MathHelper::nextFloat(rand) - MathHelper::nextFloat(rand)) * 0.4F);
-                }
-            }
-            else if (distanceWalkedOnStepModified > nextFlap && makeFlySound() && iblockstate->getMaterial() == Material::AIR)
-            {
-                nextFlap = playFlySound(distanceWalkedOnStepModified);
+                playSound(getSwimSound(), f1, 1.0F + (MathHelper::nextFloat(rand) - MathHelper::nextFloat(rand)) * 0.4F);
             }
         }
-
-        try 
+        else if (distanceWalkedOnStepModified > nextFlap && makeFlySound() && iblockstate->getMaterial() == Material::AIR)
         {
-            doBlockCollisions();
-        }
-        catch (std::exception& var58) 
-        {
-            CrashReport crashreport = CrashReport::makeCrashReport(var58, "Checking entity block collision");
-            CrashReportCategory crashreportcategory = crashreport.makeCategory("Entity being checked for collision");
-            addEntityCrashInfo(crashreportcategory);
-            throw ReportedException(crashreport);
+            nextFlap = playFlySound(distanceWalkedOnStepModified);
         }
+    }
+
+    try 
+    {
+        doBlockCollisions();
+    }
+    catch (std::exception& var58) 
+    {
+        CrashReport crashreport = CrashReport::makeCrashReport(var58, "Checking entity block collision");
+        CrashReportCategory crashreportcategory = crashreport.makeCategory("Entity being checked for collision");
+        addEntityCrashInfo(crashreportcategory);
+        throw ReportedException(crashreport);
+    }
 
-        bool flag1 = isWet();
-        if (world->isFlammableWithin(getEntityBoundingBox().shrink(0.001))) 
+    bool flag1 = isWet();
+    if (world->isFlammableWithin(getEntityBoundingBox().shrink(0.001))) 
+    {
+        dealFireDamage(1);
+        if (!flag1) 
         {
-            dealFireDamage(1);
-            if (!flag1) 
+            ++fire;
+            if (fire == 0) 
             {
-                ++fire;
-                if (fire == 0) 
-                {
-                    setFire(8);
-                }
+                setFire(8);
             }
         }
-        else if (fire <= 0) 
-        {
-            fire = -getFireImmuneTicks();
-        }
-
-        if (flag1 && isBurning()) 
-        {
-            playSound(SoundEvents::ENTITY_GENERIC_EXTINGUISH_FIRE, 0.7F, 1.6F + (MathHelper::nextFloat(rand) - MathHelper::nextFloat(rand)) * 0.4F);
-            fire = -getFireImmuneTicks();
-        }
+    }
+    else if (fire <= 0) 
+    {
+        fire = -getFireImmuneTicks();
+    }
 
-        world->profiler.endSection();
+    if (flag1 && isBurning()) 
+    {
+        playSound(SoundEvents::ENTITY_GENERIC_EXTINGUISH_FIRE, 0.7F, 1.6F + (MathHelper::nextFloat(rand) - MathHelper::nextFloat(rand)) * 0.4F);
+        fire = -getFireImmuneTicks();
     }
+
 }
 
 void Entity::resetPositionToBB()
@@ -1358,6 +1517,7 @@ void Entity::addVelocity(double x, double y, double z)
     motionY += y;
     motionZ += z;
     isAirBorne = true;
+    wakeUp(EntityActivationRange::WAKE_TICKS);
 }
 
 bool Entity::attackEntityFrom(DamageSource::DamageSource source, float amount)
@@ -1509,7 +1669,11 @@ NBTTagCompound * Entity::writeToNBT(NBTTagCompound *compound)
             compound->setBoolean("CustomNameVisible", getAlwaysRenderNameTag());
         }
 
-        cmdResultStats.writeStatsToNBT(compound);
+        if (coldState != nullptr)
+        {
+            coldState->cmdResultStats.writeStatsToNBT(compound);
+        }
+
         if (isSilent()) 
         {
             compound->setBoolean("Silent", isSilent());
@@ -1527,9 +1691,9 @@ NBTTagCompound * Entity::writeToNBT(NBTTagCompound *compound)
 
         NBTTagList nbttaglist1;
         Iterator var7;
-        if (!tags.isEmpty()) {
+        if (coldState != nullptr && !coldState->tags.isEmpty()) {
             nbttaglist1 = NBTTagList();
-            var7 = tags.iterator();
+            var7 = coldState->tags.iterator();
 
             while(var7.hasNext()) {
                 auto s = (String)var7.next();
@@ -1635,12 +1799,18 @@ void Entity::readFromNBT(NBTTagCompound *compound)
         }
 
         setAlwaysRenderNameTag(compound->getBoolean("CustomNameVisible"));
-        cmdResultStats.readStatsFromNBT(compound);
+        // most saved entities carry no command stats, loading them must not allocate the cold state
+        if (compound->hasKey("CommandStats", 10))
+        {
+            getColdState().cmdResultStats.readStatsFromNBT(compound);
+        }
+
         setSilent(compound->getBoolean("Silent"));
         setNoGravity(compound->getBoolean("NoGravity"));
         setGlowing(compound->getBoolean("Glowing"));
         if (compound->hasKey("Tags", 9)) 
         {
+            auto& tags = getColdState().tags;
             tags.clear();
             NBTTagList nbttaglist1 = compound->getTagList("Tags", 8);
             auto i = MathHelper::min(nbttaglist1.tagCount(), 1024);
@@ -1,4 +1,6 @@
 #pragma once
+#include <atomic>
+#include <memory>
 #include <unordered_set>
 
 #include "EnumActionResult.h"
@@ -11,6 +13,9 @@
 #include "../tileentity/TileEntityHopper.h"
 #include "../util/text/event/HoverEvent.h"
 #include "math/AxisAlignedBB.h"
+#include "../world/EntityActivationRange.h"
+#include "../world/EntityHandle.h"
+#include "../world/EntityPhysicsBatch.h"
 
 class DataParameter;
 enum class MoverType;
@@ -38,63 +43,92 @@ class CrashReportCategory;
 
 class Entity :public ICommandSender ,public IWorldNameable
 {
+private:
+    // read or written by every tick, kept together at the front of the object
+    AxisAlignedBB boundingBox;
+    Entity* ridingEntity;
+    std::vector< Entity*> riddenByEntities;
+    int32_t entityId;
+    int32_t fire;
+    int32_t nextStepDistance;
+    float nextFlap;
+    EntityHandle handle;
+    uint64_t dirtyData = 0;
+    uint8_t activationCategory = UINT8_MAX;
+
 public:
-    bool preventEntitySpawning;
-    bool forceSpawn;
     World* world;
-    double prevPosX;
-    double prevPosY;
-    double prevPosZ;
     double posX;
     double posY;
     double posZ;
     double motionX;
     double motionY;
     double motionZ;
+    double prevPosX;
+    double prevPosY;
+    double prevPosZ;
+    double lastTickPosX;
+    double lastTickPosY;
+    double lastTickPosZ;
     float rotationYaw;
     float rotationPitch;
     float prevRotationYaw;
     float prevRotationPitch;
-    bool onGround;
-    bool collidedHorizontally;
-    bool collidedVertically;
-    bool collided;
-    bool velocityChanged;
-    bool isDead;
     float width;
     float height;
+    float stepHeight;
+    float fallDistance;
+    float entityCollisionReduction;
     float prevDistanceWalkedModified;
     float distanceWalkedModified;
     float distanceWalkedOnStepModified;
-    float fallDistance;
-    double lastTickPosX;
-    double lastTickPosY;
-    double lastTickPosZ;
-    float stepHeight;
-    bool noClip;
-    float entityCollisionReduction;
     int32_t ticksExisted;
     int32_t hurtResistantTime;
-    bool addedToChunk;
     int32_t chunkCoordX;
     int32_t chunkCoordY;
     int32_t chunkCoordZ;
-    int64_t serverPosX;
-    int64_t serverPosY;
-    int64_t serverPosZ;
-    bool ignoreFrustumCheck;
+    // last world tick this entity is fully ticked for, see EntityActivationRange
+    int64_t activatedTick = INT64_MIN;
+    bool onGround;
+    bool collidedHorizontally;
+    bool collidedVertically;
+    bool collided;
+    bool velocityChanged;
+    bool isDead;
+    bool noClip;
     bool isAirBorne;
+    bool addedToChunk;
+    // left out of the entity tick until woken, see World::setEntityDormant
+    bool dormant = false;
+    // removed from the world but still in loadedEntityList until the next World::compactEntityList
+    bool removalPending = false;
+
+    bool preventEntitySpawning;
+    bool forceSpawn;
+    bool ignoreFrustumCheck;
     int32_t timeUntilPortal;
     int32_t dimension;
+    int64_t serverPosX;
+    int64_t serverPosY;
+    int64_t serverPosZ;
 
     Entity(World* worldIn);
     int32_t getEntityId() const;
     void setEntityId(int32_t id);
+    // The slot of this entity in its world's EntitySlotMap, invalid while it is in no world.
+    EntityHandle getHandle() const;
+    void setHandle(EntityHandle handleIn);
+    // One bit per watched field changed since the entity tracker last flushed this entity, see World::markEntityDataDirty.
+    // markDataDirty is true when no field was dirty before.
+    bool markDataDirty(uint64_t fields);
+    bool hasDirtyData() const;
+    uint64_t takeDirtyData();
     std::unordered_set<std::string> getTags() const;
     bool addTag(std::string_view tag);
     bool removeTag(std::string_view tag);
     virtual void onKillCommand();
-    EntityDataManager getDataManager();
+    EntityDataManager& getDataManager();
+    const EntityDataManager& getDataManager() const;
     friend bool operator==(const Entity& lhs , const Entity& rhs);
     virtual void setDead();
     virtual void setDropItemsWhenDead(bool dropWhenDead);
@@ -102,11 +136,21 @@ public:
     void turn(float yaw, float pitch);
     virtual void onUpdate();
     virtual void onEntityUpdate();
+    virtual void inactiveTick();
+    void wakeUp(int32_t ticks);
+    virtual void onWake();
+    EntityActivationRange::Category getActivationCategory();
     int32_t getMaxInPortalTime() const;
     void setFire(int32_t seconds);
     void extinguish();
     bool isOffsetPositionInLiquid(double x, double y, double z);
     virtual void move(const MoverType& type, double x, double y, double z);
+    // move() for a displacement the caller already found free of collision boxes; skips the clipping.
+    void moveUnobstructed(double x, double y, double z);
+    // False when move() would not simply clip the displacement, in a web or without collisions.
+    bool canMoveUnobstructed() const;
+    // What onUpdate() does after its gravity and move() step, run by the physics batch when the world has one.
+    virtual void onPhysicsUpdate();
     void resetPositionToBB();
     virtual void playSound(SoundEvent soundIn, float volume, float pitch);
     bool isSilent();
@@ -296,6 +340,10 @@ protected:
     virtual SoundEvent getSwimSound();
     virtual SoundEvent getSplashSound();
     virtual void doBlockCollisions();
+    // Applies gravity, moves by the motion and applies drag, then calls onPhysicsUpdate(), now or from the world's
+    // physics batch.
+    void updatePhysics(double gravity, const EntityPhysicsBatch::Drag& drag = EntityPhysicsBatch::NO_DRAG);
+    void finishMove(double startX, double startY, double startZ, double d2, double d3, double d4, double x, double y, double z);
     virtual void onInsideBlock(IBlockState* p_191955_1_);
     virtual void playStepSound(BlockPos pos, Block* blockIn);
     float playFlySound(float p_191954_1_);
@@ -331,10 +379,11 @@ protected:
     bool inWater;
     bool firstUpdate;
     bool bisImmuneToFire;
+    // getFlag, getAir, hasNoGravity and the portal check read these every tick, they stay inline
     EntityDataManager dataManager;
     static DataParameter FLAGS;
-    bool inPortal;
-    int32_t portalCounter;
+    bool inPortal = false;
+    int32_t portalCounter = 0;
     BlockPos lastPortalPos;
     Vec3d lastPortalVec;
     EnumFacing teleportDirection;
@@ -351,26 +400,30 @@ private:
     static std::vector<> EMPTY_EQUIPMENT;
     static AxisAlignedBB ZERO_AABB = AxisAlignedBB(0.0, 0.0, 0.0, 0.0, 0.0, 0.0);
     static double renderDistanceWeight = 1.0;
-    static int32_t nextEntityID;
-    int32_t entityId;
-    std::vector< Entity*> riddenByEntities;
-    Entity* ridingEntity;
-    AxisAlignedBB boundingBox;
-    bool OutsideBorder;
-    int32_t nextStepDistance;
-    float nextFlap;
-    int32_t fire;
+    // entities are constructed on the region workers too, see RegionTicker
+    static std::atomic<int32_t> nextEntityID;
     static DataParameter AIR;
     static DataParameter CUSTOM_NAME;
     static DataParameter CUSTOM_NAME_VISIBLE;
     static DataParameter SILENT;
     static DataParameter NO_GRAVITY;
+
+    // State most entities never touch, allocated the first time it is written. The custom name stays in the data
+    // manager, it is one of the synced parameters.
+    struct ColdState
+    {
+        CommandResultStats cmdResultStats;
+        std::unordered_set<std::string> tags;
+        std::array<double,3> pistonDeltas{};
+        int64_t pistonDeltasGameTime = 0;
+    };
+
+    ColdState& getColdState();
+
+    bool OutsideBorder;
     bool invulnerable;
-    CommandResultStats cmdResultStats;
-    std::unordered_set<std::string> tags;
     bool isPositionDirty;
-    std::array<double,3> pistonDeltas;
-    int64_t pistonDeltasGameTime;
+    std::unique_ptr<ColdState> coldState;
 };
 
 template<>
@@ -128,6 +128,23 @@ void EntityAgeable::onLivingUpdate() {
       }
 }
 
+void EntityAgeable::inactiveTick() {
+    EntityCreature::inactiveTick();
+    if (!world->isRemote) {
+         int32_t i = getGrowingAge();
+         if (i < 0) {
+            ++i;
+            setGrowingAge(i);
+            if (i == 0) {
+               onGrowingAdult();
+            }
+         } else if (i > 0) {
+            --i;
+            setGrowingAge(i);
+         }
+    }
+}
+
 bool EntityAgeable::isChild() {
     return getGrowingAge() < 0;
 }
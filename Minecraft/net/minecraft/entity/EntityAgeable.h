@@ -16,6 +16,7 @@ public:
     void readEntityFromNBT(NBTTagCompound* compound) override;
     void notifyDataManagerChange(DataParameter key) override;
     void onLivingUpdate() override;
+    void inactiveTick() override;
     bool isChild() override;
     void setScaleForAge(bool child);
 
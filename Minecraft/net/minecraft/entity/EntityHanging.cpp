@@ -30,6 +30,17 @@ void EntityHanging::onUpdate() {
             onBroken(nullptr);
         }
     }
+
+    // nothing changes until the wall or the space in front of it does, the world wakes us when it does
+    if (!world->isRemote && !isDead && !isRiding() && !isBeingRidden()) 
+    {
+        world->setEntityDormant(this, getSupportPositions());
+    }
+}
+
+void EntityHanging::onWake() {
+    // recheck the surface on the first tick after waking up
+    tickCounter1 = 100;
 }
 
 bool EntityHanging::onValidSurface() {
@@ -58,6 +69,23 @@ bool EntityHanging::onValidSurface() {
       }
 }
 
+std::vector<BlockPos> EntityHanging::getSupportPositions() {
+    auto i = MathHelper::max(1, getWidthPixels() / 16);
+    auto j = MathHelper::max(1, getHeightPixels() / 16);
+    const EnumFacing enumfacing = facingDirection->rotateYCCW();
+    std::vector<BlockPos> positions;
+    positions.reserve(i * j * 2);
+    for (auto blockpos : {hangingPosition.offset(facingDirection->getOpposite()), hangingPosition}) {
+        for (auto k = 0; k < i; ++k) {
+            for (auto l = 0; l < j; ++l) {
+               positions.emplace_back(blockpos.offset(enumfacing, k + (i - 1) / -2).offset(EnumFacing::UP, l + (j - 1) / -2));
+            }
+        }
+    }
+
+    return positions;
+}
+
 bool EntityHanging::canBeCollidedWith() {
     return true;
 }
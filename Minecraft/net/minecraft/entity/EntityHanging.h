@@ -6,6 +6,7 @@ public:
     EntityHanging(World* worldIn);
     EntityHanging(World* worldIn, BlockPos hangingPositionIn);
     void onUpdate() override;
+    void onWake() override;
     virtual bool onValidSurface();
     bool canBeCollidedWith() override;
     bool hitByEntity(Entity* entityIn) override;
@@ -38,6 +39,7 @@ protected:
     BlockPos hangingPosition;
 private:
     double offs(int32_t p_190202_1_);
+    std::vector<BlockPos> getSupportPositions();
 
     int32_t tickCounter1;
 };
\ No newline at end of file
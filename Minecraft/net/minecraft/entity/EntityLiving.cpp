@@ -64,11 +64,14 @@ EntitySenses &EntityLiving::getEntitySenses() {
 }
 
 EntityLivingBase *EntityLiving::getAttackTarget() {
-    return attackTarget;
+    return static_cast<EntityLivingBase*>(world->getEntityByHandle(attackTarget));
 }
 
 void EntityLiving::setAttackTarget(EntityLivingBase *entitylivingbaseIn) {
-    attackTarget = entitylivingbaseIn;
+    attackTarget = entitylivingbaseIn != nullptr ? entitylivingbaseIn->getHandle() : EntityHandle();
+    if (entitylivingbaseIn != nullptr) {
+        wakeUp(EntityActivationRange::WAKE_TICKS);
+    }
 }
 
 bool EntityLiving::canAttackClass(std::type_index cls) {
@@ -202,13 +205,14 @@ void EntityLiving::writeEntityToNBT(NBTTagCompound *compound) {
 
     compound->setTag("HandDropChances", nbttaglist3);
     compound->setBoolean("Leashed", isLeashed);
-    if (leashHolder != nullptr) {
+    Entity* holder = getLeashHolder();
+    if (holder != nullptr) {
         nbttagcompound2 = new NBTTagCompound();
-        if (Util::instanceof<EntityLivingBase>(leashHolder)) {
-            xg::Guid uuid = leashHolder->getUniqueID();
+        if (Util::instanceof<EntityLivingBase>(holder)) {
+            xg::Guid uuid = holder->getUniqueID();
             nbttagcompound2->setUniqueId("UUID", uuid);
-        } else if (Util::instanceof<EntityHanging>(leashHolder)) {
-            BlockPos blockpos = ((EntityHanging *)leashHolder).getHangingPosition();
+        } else if (Util::instanceof<EntityHanging>(holder)) {
+            BlockPos blockpos = ((EntityHanging *)holder).getHangingPosition();
             nbttagcompound2->setInteger("X", blockpos.getx());
             nbttagcompound2->setInteger("Y", blockpos.gety());
             nbttagcompound2->setInteger("Z", blockpos.getz());
@@ -539,7 +543,7 @@ bool EntityLiving::processInitialInteract(EntityPlayer *player, EnumHand hand) {
 void EntityLiving::clearLeashed(bool sendPacket, bool dropLead) {
     if (isLeashed) {
          isLeashed = false;
-         leashHolder = nullptr;
+         leashHolder = EntityHandle();
          if (!world->isRemote && dropLead) {
             dropItem(Items::LEAD, 1);
          }
@@ -559,14 +563,14 @@ bool EntityLiving::getLeashed() const {
 }
 
 Entity * EntityLiving::getLeashHolder() const {
-    return leashHolder;
+    return world->getEntityByHandle(leashHolder);
 }
 
 void EntityLiving::setLeashHolder(Entity *entityIn, bool sendAttachNotification) {
     isLeashed = true;
-      leashHolder = entityIn;
+      leashHolder = entityIn->getHandle();
       if (!world->isRemote && sendAttachNotification && Util::instanceof<WorldServer>(world)) {
-         ((WorldServer*)world)->getEntityTracker().sendToTracking(this, new SPacketEntityAttach(this, leashHolder));
+         ((WorldServer*)world)->getEntityTracker().sendToTracking(this, new SPacketEntityAttach(this, entityIn));
       }
 
       if (isRiding()) {
@@ -677,7 +681,8 @@ void EntityLiving::updateLeashedState() {
             clearLeashed(true, true);
          }
 
-         if (leashHolder == nullptr || leashHolder->isDead) {
+         auto holder = getLeashHolder();
+         if (holder == nullptr || holder->isDead) {
             clearLeashed(true, true);
          }
       }
@@ -891,6 +896,14 @@ void EntityLiving::despawnEntity() {
       }
 }
 
+void EntityLiving::inactiveTick() {
+    EntityLivingBase::inactiveTick();
+    // the AI that normally runs the despawn check is skipped, far away mobs would otherwise never despawn
+    if (!world->isRemote) {
+        despawnEntity();
+    }
+}
+
 void EntityLiving::updateEntityActionState() {
     ++idleTime;
     world->profiler.startSection("checkDespawn");
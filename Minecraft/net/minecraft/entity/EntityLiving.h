@@ -36,6 +36,7 @@ public:
     void spawnExplosionParticle();
     void handleStatusUpdate(std::byte id) override;
     void onUpdate() override;
+    void inactiveTick() override;
     static void registerFixesMob(DataFixer fixer, std::type_index name);
     void writeEntityToNBT(NBTTagCompound* compound) override;
     void readEntityFromNBT(NBTTagCompound* compound) override;
@@ -127,7 +128,8 @@ private:
     static DataParameter AI_FLAGS;
     std::unique_ptr<EntityLookHelper> lookHelper;
     std::unique_ptr<EntityBodyHelper> bodyHelper;
-    EntityLivingBase* attackTarget;
+    // handles, so a target or holder that left the world reads as nullptr instead of dangling
+    EntityHandle attackTarget;
     EntitySenses senses;
     std::vector<ItemStack> inventoryHands;
     std::vector<ItemStack> inventoryArmor;
@@ -137,7 +139,7 @@ private:
     std::optional<ResourceLocation> deathLootTable;
     int64_t deathLootTableSeed;
     bool isLeashed;
-    Entity* leashHolder;
+    EntityHandle leashHolder;
     NBTTagCompound* leashNBTTag;
 };
 
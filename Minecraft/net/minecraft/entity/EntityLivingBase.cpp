@@ -364,6 +364,22 @@ float EntityLivingBase::getHealth() {
     return dataManager.get(HEALTH);
 }
 
+void EntityLivingBase::inactiveTick() {
+    Entity::inactiveTick();
+    ++idleTime;
+    if (hurtTime > 0) {
+        --hurtTime;
+    }
+
+    if (hurtResistantTime > 0) {
+        --hurtResistantTime;
+    }
+
+    if (recentlyHit > 0) {
+        --recentlyHit;
+    }
+}
+
 bool EntityLivingBase::attackEntityFrom(DamageSource::DamageSource source, float amount) {
     if (isEntityInvulnerable(source)) {
         return false;
@@ -371,6 +387,7 @@ bool EntityLivingBase::attackEntityFrom(DamageSource::DamageSource source, float
         return false;
     } else {
         idleTime = 0;
+        wakeUp(EntityActivationRange::WAKE_TICKS);
         if (getHealth() <= 0.0F) {
             return false;
         } else if (source.isFireDamage() && isPotionActive(MobEffects::FIRE_RESISTANCE)) {
@@ -778,7 +795,7 @@ DamageSource::DamageSource EntityLivingBase::getLastDamageSource() {
 }
 
 void EntityLivingBase::renderBrokenItemStack(const ItemStack &stack) {
-    playSound(SoundEvents::ENTITY_ITEM_BREAK, 0.8F, 0.8F + MathHelper::nextFloat(world->rand) * 0.4F);
+    playSound(SoundEvents::ENTITY_ITEM_BREAK, 0.8F, 0.8F + MathHelper::nextFloat(world->getRandom()) * 0.4F);
 
     for (int i = 0; i < 5; ++i) {
         Vec3d vec3d = Vec3d(((double)MathHelper::nextFloat(rand) - 0.5) * 0.1, MathHelper::random() * 0.1 + 0.1, 0.0);
@@ -978,28 +995,29 @@ void EntityLivingBase::updateEntityActionState() {
 }
 
 void EntityLivingBase::collideWithNearbyEntities() {
-    auto list = world->getEntitiesInAABBexcluding(this, getEntityBoundingBox(), EntitySelectors::getTeamCollisonPredicate(this));
-      if (!list.isEmpty()) {
-         auto i = world->getGameRules().getInt("maxEntityCramming");
-         if (i > 0 && list.size() > i - 1 && rand(4) == 0) {
+    world->requestEntityPush(this);
+}
+
+void EntityLivingBase::collideWithEntities(const std::vector<Entity*>& list, int32_t maxEntityCramming) {
+    if (!list.empty()) {
+        if (maxEntityCramming > 0 && list.size() > maxEntityCramming - 1 && rand(4) == 0) {
             auto j = 0;
 
-            for(auto k = 0; k < list.size(); ++k) {
-               if (!((Entity)list.get(k)).isRiding()) {
-                  ++j;
-               }
+            for(auto entity : list) {
+                if (!entity->isRiding()) {
+                    ++j;
+                }
             }
 
-            if (j > i - 1) {
-               attackEntityFrom(DamageSource::CRAMMING, 6.0F);
+            if (j > maxEntityCramming - 1) {
+                attackEntityFrom(DamageSource::CRAMMING, 6.0F);
             }
-         }
+        }
 
-         for(auto j = 0; j < list.size(); ++j) {
-            Entity* entity = (Entity*)list.get(j);
+        for(auto entity : list) {
             collideWithEntity(entity);
-         }
-      }
+        }
+    }
 }
 
 void EntityLivingBase::collideWithEntity(Entity *entityIn) {
@@ -1034,7 +1052,7 @@ void EntityLivingBase::updateActiveHand() {
 void EntityLivingBase::updateItemUse(ItemStack stack, int32_t eatingParticleCount) {
     if (!stack.isEmpty() && isHandActive()) {
          if (stack.getItemUseAction() == EnumAction::DRINK) {
-            playSound(SoundEvents::ENTITY_GENERIC_DRINK, 0.5F, MathHelper::nextFloat(world->rand) * 0.1F + 0.9F);
+            playSound(SoundEvents::ENTITY_GENERIC_DRINK, 0.5F, MathHelper::nextFloat(world->getRandom()) * 0.1F + 0.9F);
          }
 
          if (stack.getItemUseAction() == EnumAction::EAT) {
@@ -1221,9 +1239,9 @@ void EntityLivingBase::handleStatusUpdate(std::byte id) {
             setHealth(0.0F);
             onDeath(DamageSource::GENERIC);
         } else if (id == std::byte{30}) {
-            playSound(SoundEvents::ITEM_SHIELD_BREAK, 0.8F, 0.8F + MathHelper::nextFloat(world->rand) * 0.4F);
+            playSound(SoundEvents::ITEM_SHIELD_BREAK, 0.8F, 0.8F + MathHelper::nextFloat(world->getRandom()) * 0.4F);
         } else if (id == std::byte{29}) {
-            playSound(SoundEvents::ITEM_SHIELD_BLOCK, 1.0F, 0.8F + MathHelper::nextFloat(world->rand) * 0.4F);
+            playSound(SoundEvents::ITEM_SHIELD_BLOCK, 1.0F, 0.8F + MathHelper::nextFloat(world->getRandom()) * 0.4F);
         } else {
             Entity::handleStatusUpdate(id);
         }
@@ -1259,7 +1277,7 @@ void EntityLivingBase::handleStatusUpdate(std::byte id) {
 
 AbstractAttributeMap *EntityLivingBase::getAttributeMap() {
     if (attributeMap == nullptr) {
-        attributeMap = new AttributeMap();
+        attributeMap = new AttributeMap(this);
     }
 
     return attributeMap;
@@ -17,6 +17,7 @@ public:
     void onKillCommand() override;
     bool canBreatheUnderwater();
     void onEntityUpdate() override;
+    void inactiveTick() override;
     virtual bool isChild();
     pcg32& getRNG();
     EntityLivingBase* getRevengeTarget() const;
@@ -114,34 +115,38 @@ public:
     virtual bool canBeHitWithPotion();
     virtual bool attackable();
     void setPartying(BlockPos pos, bool isPartying);
+    // Pushes this entity away from list, the pushable entities its box intersects, and applies cramming damage.
+    void collideWithEntities(const std::vector<Entity*>& list, int32_t maxEntityCramming);
 
-    bool isSwingInProgress;
-    EnumHand swingingHand;
-    int32_t swingProgressInt;
-    int32_t arrowHitTimer;
+    // movement and animation state updated by every tick, ahead of what only the renderer reads
+    float moveStrafing;
+    float moveVertical;
+    float moveForward;
+    float jumpMovementFactor;
+    float randomYawVelocity;
+    float rotationYawHead;
+    float prevRotationYawHead;
+    float renderYawOffset;
+    float prevRenderYawOffset;
+    float limbSwing;
+    float limbSwingAmount;
+    float prevLimbSwingAmount;
+    float swingProgress;
+    float prevSwingProgress;
     int32_t hurtTime;
     int32_t maxHurtTime;
-    float attackedAtYaw;
     int32_t deathTime;
-    float prevSwingProgress;
-    float swingProgress;
-    float prevLimbSwingAmount;
-    float limbSwingAmount;
-    float limbSwing;
+    int32_t swingProgressInt;
+    int32_t arrowHitTimer;
     int32_t maxHurtResistantTime;
+    bool isSwingInProgress;
+    EnumHand swingingHand;
+
+    float attackedAtYaw;
     float prevCameraPitch;
     float cameraPitch;
     float randomUnused2;
     float randomUnused1;
-    float renderYawOffset;
-    float prevRenderYawOffset;
-    float rotationYawHead;
-    float prevRotationYawHead;
-    float jumpMovementFactor;
-    float moveStrafing;
-    float moveVertical;
-    float moveForward;
-    float randomYawVelocity;
 protected:
     void entityInit() override;
     virtual void applyEntityAttributes();
@@ -184,6 +189,7 @@ protected:
     float getWaterSlowDown();
     virtual float updateDistance(float p_110146_1_, float p_110146_2_);
     virtual void updateEntityActionState();
+    // Queues the push on the world, which calls collideWithEntities once per tick with what this entity touches.
     virtual void collideWithNearbyEntities();
     virtual void collideWithEntity(Entity* entityIn);
     void markVelocityChanged() override;
@@ -235,19 +241,20 @@ private:
     static DataParameter HIDE_PARTICLES;
     static DataParameter ARROW_COUNT_IN_ENTITY;
     AbstractAttributeMap* attributeMap;
-    CombatTracker combatTracker;
-    std::unordered_map<Potion,PotionEffect> activePotionsMap;
-    std::vector<ItemStack> handInventory;
-    std::vector<ItemStack> armorArray;
-    bool potionsNeedUpdate;
     EntityLivingBase* revengeTarget;
-    int32_t revengeTimer;
     EntityLivingBase* lastAttackedEntity;
-    int32_t lastAttackedEntityTime;
     float landMovementFactor;
-    int32_t jumpTicks;
     float absorptionAmount;
+    int32_t jumpTicks;
+    int32_t revengeTimer;
+    int32_t lastAttackedEntityTime;
+    bool potionsNeedUpdate;
     BlockPos prevBlockpos;
+    // containers and combat bookkeeping, only followed when there is something in them
+    std::unordered_map<Potion,PotionEffect> activePotionsMap;
+    std::vector<ItemStack> handInventory;
+    std::vector<ItemStack> armorArray;
+    CombatTracker combatTracker;
     DamageSource::DamageSource lastDamageSource;
     int64_t lastDamageStamp;
 };
\ No newline at end of file
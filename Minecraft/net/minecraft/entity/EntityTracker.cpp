@@ -1,12 +1,25 @@
 #include "EntityTracker.h"
 
+#include <algorithm>
+#include <future>
+
 #include "Entity.h"
 #include "EntityLiving.h"
 #include "EntityTrackerEntry.h"
 #include "ReportedException.h"
+#include "WorkerPool.h"
+#include "../world/WorldServer.h"
 
 std::shared_ptr<spdlog::logger> EntityTracker::LOGGER = spdlog::get("Minecraft")->clone("EntityTracker");
 
+namespace {
+    // shared by the trackers of every world, which tick one after another
+    WorkerPool* getEncodePool() {
+        static WorkerPool pool("Tracker Worker");
+        return &pool;
+    }
+}
+
 class EntityTrackerCrashReportDetail: ICrashReportDetail {
     public:
         EntityTrackerCrashReportDetail(int32_t updateFrequencyIn)
@@ -47,9 +60,10 @@ void EntityTracker::track(Entity *entityIn) {
     if (Util::instanceof<EntityPlayerMP>(entityIn)) {
          track(entityIn, 512, 2);
          auto entityplayermp = (EntityPlayerMP*)entityIn;
-         for(auto entitytrackerentry : entries){
-            if (entitytrackerentry.getTrackedEntity() != entityplayermp) {
-               entitytrackerentry.updatePlayerEntity(entityplayermp);
+         gatherEntriesNear(entityplayermp);
+         for(auto entitytrackerentry : nearbyEntries){
+            if (entitytrackerentry->getTrackedEntity() != entityplayermp) {
+               entitytrackerentry->updatePlayerEntity(entityplayermp);
             }
          }
       } else if (entityIn instanceof EntityFishHook) {
@@ -125,8 +139,9 @@ void EntityTracker::track(Entity *entityIn, int32_t trackingRange, int32_t updat
 
          EntityTrackerEntry entitytrackerentry(entityIn, trackingRange, maxTrackingDistanceThreshold, updateFrequency, sendVelocityUpdates);
          entries.emplace(entitytrackerentry);
-         trackedEntityHashTable.emplace(entityIn->getEntityId(), entitytrackerentry);
-         entitytrackerentry.updatePlayerEntities(world->playerEntities);
+         auto& tracked = trackedEntityHashTable.emplace(entityIn->getEntityId(), entitytrackerentry).first->second;
+         grid.add(&tracked);
+         tracked.updateNearbyPlayerEntities();
       } catch (std::exception& var10) {
          CrashReport crashreport = CrashReport.makeCrashReport(var10, "Adding entity to track");
          CrashReportCategory crashreportcategory = crashreport.makeCategory("Entity To Track");
@@ -146,14 +161,18 @@ void EntityTracker::track(Entity *entityIn, int32_t trackingRange, int32_t updat
 void EntityTracker::untrack(Entity *entityIn) {
     if (Util::instanceof<EntityPlayerMP>(entityIn)) {
          auto entityplayermp = (EntityPlayerMP*)entityIn;
-        for(auto entitytrackerentry : entries){
+         // not just the entries near the player, one that drifted away may still hold it
+         for(auto& [id, entitytrackerentry] : trackedEntityHashTable){
             entitytrackerentry.removeFromTrackedPlayers(entityplayermp);
          }
+
+         playerViewCenters.erase(entityplayermp);
       }
 
     auto ite = trackedEntityHashTable.find(entityIn->getEntityId());
       auto& entitytrackerentry1 = ite->second;
       if (entitytrackerentry1 != nullptr) {
+         grid.remove(&entitytrackerentry1);
          entries.erase(entitytrackerentry1);
          entitytrackerentry1.sendDestroyEntityPacketToTrackedPlayers();
       }
@@ -163,31 +182,132 @@ void EntityTracker::untrack(Entity *entityIn) {
 void EntityTracker::tick() {
     std::vector<EntityPlayerMP*> list;
 
-    for(auto entitytrackerentry : entries){
+    encodeQueue.clear();
+    for(auto& [id, entitytrackerentry] : trackedEntityHashTable){
          entitytrackerentry.updatePlayerList(world->playerEntities);
+         grid.update(&entitytrackerentry);
+         encodeQueue.emplace_back(&entitytrackerentry);
          if (entitytrackerentry.playerEntitiesUpdated) {
-             std::vector<EntityPlayerMP *>::const_iterator entity = entitytrackerentry.getTrackedEntity();
+            auto entity = entitytrackerentry.getTrackedEntity();
             if (Util::instanceof<EntityPlayerMP>(entity)) {
-               list.emplace(entity);
+               list.emplace_back((EntityPlayerMP*)entity);
             }
          }
       }
 
+    markDirtyEntities();
+
+    // sent before the players that moved pick up new entries, those get their position from the spawn packet
+    encodeEntries();
+    for (auto entitytrackerentry : encodeQueue) {
+         entitytrackerentry->flushUpdates();
+      }
+
+    // a player that moved only meets the entries in the cells around it
     for(auto entityplayermp : list){
-         for(auto entitytrackerentry1 : entries) {
-            if (entitytrackerentry1.getTrackedEntity() != entityplayermp) {
-               entitytrackerentry1.updatePlayerEntity(entityplayermp);
+         gatherEntriesNear(entityplayermp);
+         for(auto entitytrackerentry1 : nearbyEntries) {
+            if (entitytrackerentry1->getTrackedEntity() != entityplayermp) {
+               entitytrackerentry1->updatePlayerEntity(entityplayermp);
             }
          }
       }
 }
 
+void EntityTracker::markDirtyEntities() {
+    // only the entities whose watched data changed this tick are visited
+    for (auto handle : world->getDirtyEntities()) {
+        auto entity = world->getEntityByHandle(handle);
+        if (entity == nullptr) {
+            continue;
+        }
+
+        auto dirtyFields = entity->takeDirtyData();
+        auto ite = trackedEntityHashTable.find(entity->getEntityId());
+        if (dirtyFields != 0 && ite != trackedEntityHashTable.end()) {
+            ite->second.markMetadataDirty(dirtyFields);
+        }
+    }
+
+    world->clearDirtyEntities();
+}
+
+void EntityTracker::encodeEntries() {
+    if (!parallelEncoding || encodeQueue.size() < MIN_PARALLEL_ENTRIES) {
+        for (auto entitytrackerentry : encodeQueue) {
+            entitytrackerentry->encodeUpdates();
+        }
+
+        return;
+    }
+
+    nextEncodeBatch = 0;
+    error = nullptr;
+    auto batches = (encodeQueue.size() + ENCODE_BATCH_SIZE - 1) / ENCODE_BATCH_SIZE;
+    auto pool = getEncodePool();
+    auto helpers = std::min<size_t>(pool->getThreadCount(), batches - 1);
+    std::vector<std::future<void>> futures;
+    futures.reserve(helpers);
+    for (size_t i = 0; i < helpers; ++i) {
+        futures.emplace_back(pool->submit([this]() {
+            runEncodeBatches();
+        }));
+    }
+
+    runEncodeBatches();
+    for (auto& future : futures) {
+        future.get();
+    }
+
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
+
+void EntityTracker::runEncodeBatches() {
+    for (auto begin = nextEncodeBatch++ * ENCODE_BATCH_SIZE; begin < encodeQueue.size(); begin = nextEncodeBatch++ * ENCODE_BATCH_SIZE) {
+        auto end = std::min(begin + ENCODE_BATCH_SIZE, encodeQueue.size());
+        try {
+            for (auto i = begin; i < end; ++i) {
+                encodeQueue[i]->encodeUpdates();
+            }
+        } catch (...) {
+            std::lock_guard<std::mutex> guard(errorLock);
+            if (!error) {
+                error = std::current_exception();
+            }
+        }
+    }
+}
+
+void EntityTracker::gatherEntriesNear(EntityPlayerMP *player) {
+    nearbyEntries.clear();
+    auto range = (double)maxTrackingDistanceThreshold + VIEW_SLACK;
+    auto collect = [this](EntityTrackerEntry* entry) {
+        nearbyEntries.emplace_back(entry);
+    };
+
+    auto center = playerViewCenters.find(player);
+    if (center != playerViewCenters.end()) {
+        grid.forEachEntryNear(center->second.first, center->second.second, range, collect);
+    }
+
+    grid.forEachEntryNear(player->posX, player->posZ, range, collect);
+    std::sort(nearbyEntries.begin(), nearbyEntries.end());
+    nearbyEntries.erase(std::unique(nearbyEntries.begin(), nearbyEntries.end()), nearbyEntries.end());
+    playerViewCenters[player] = {player->posX, player->posZ};
+}
+
 void EntityTracker::updateVisibility(EntityPlayerMP *player) {
-      for(auto entitytrackerentry : entries) {
-         if (entitytrackerentry.getTrackedEntity() == player) {
-            entitytrackerentry.updatePlayerEntities(world->playerEntities);
-         } else {
-            entitytrackerentry.updatePlayerEntity(player);
+    auto own = trackedEntityHashTable.find(player->getEntityId());
+      if (own != trackedEntityHashTable.end()) {
+         own->second.updateNearbyPlayerEntities();
+      }
+
+      gatherEntriesNear(player);
+      for(auto entitytrackerentry : nearbyEntries) {
+         if (entitytrackerentry->getTrackedEntity() != player) {
+            entitytrackerentry->updatePlayerEntity(player);
          }
       }
 }
@@ -207,19 +327,22 @@ void EntityTracker::sendToTrackingAndSelf(Entity *entityIn, Packet packetIn) {
 }
 
 void EntityTracker::removePlayerFromTrackers(EntityPlayerMP *player) {
-    for (auto entitytrackerentry : entries){
+    // rare enough to visit every entry, which leaves no tracker holding the player
+    for (auto& [id, entitytrackerentry] : trackedEntityHashTable){
          entitytrackerentry.removeTrackedPlayerSymmetric(player);
       }
+
+      playerViewCenters.erase(player);
 }
 
 void EntityTracker::sendLeashedEntitiesInChunk(EntityPlayerMP *player, const Chunk &chunkIn) {
     std::vector<Entity*> list;
       std::vector<Entity*> list1;
 
-    for(auto entitytrackerentry : entries){
-         Entity* entity = entitytrackerentry.getTrackedEntity();
+    grid.forEachEntryInChunk(chunkIn.x, chunkIn.z, [&](EntityTrackerEntry* entitytrackerentry) {
+         Entity* entity = entitytrackerentry->getTrackedEntity();
          if (entity != player && entity->chunkCoordX == chunkIn.x && entity->chunkCoordZ == chunkIn.z) {
-            entitytrackerentry.updatePlayerEntity(player);
+            entitytrackerentry->updatePlayerEntity(player);
             if (Util::instanceof<EntityLiving>(entity) && ((EntityLiving*)entity)->getLeashHolder() != nullptr) {
                list.emplace(entity);
             }
@@ -228,7 +351,7 @@ void EntityTracker::sendLeashedEntitiesInChunk(EntityPlayerMP *player, const Chu
                list1.emplace(entity);
             }
          }
-      }
+      });
 
       if (!list.empty()) {
          for(auto entity2 : list){
@@ -243,6 +366,14 @@ void EntityTracker::sendLeashedEntitiesInChunk(EntityPlayerMP *player, const Chu
       }
 }
 
+void EntityTracker::setParallelEncoding(bool enabled) {
+    parallelEncoding = enabled;
+}
+
+bool EntityTracker::isParallelEncoding() const {
+    return parallelEncoding;
+}
+
 void EntityTracker::setViewDistance(int32_t distance) {
     maxTrackingDistanceThreshold = (distance - 1) * 16;
       for(auto entitytrackerentry : entries) {
@@ -1,11 +1,17 @@
 #pragma once
 #include "spdlog/logger.h"
+#include "EntityTrackerGrid.h"
 
 
+#include <atomic>
 #include <cstdint>
+#include <exception>
 #include <memory>
+#include <mutex>
 #include <unordered_map>
 #include <unordered_set>
+#include <utility>
+#include <vector>
 
 class Packet;
 class Chunk;
@@ -30,11 +36,35 @@ public:
     void removePlayerFromTrackers(EntityPlayerMP* player);
     void sendLeashedEntitiesInChunk(EntityPlayerMP* player, const Chunk& chunkIn);
     void setViewDistance(int32_t distance);
+    // Encodes the movement, velocity and metadata packets of the tracker entries on worker threads; follows the
+    // parallelEntityTracking game rule each tick, off by default.
+    void setParallelEncoding(bool enabled);
+    bool isParallelEncoding() const;
 
 private:
+    // hands the watched data changed this tick to the entries, whose encodeUpdates builds its packets
+    void markDirtyEntities();
+    void gatherEntriesNear(EntityPlayerMP* player);
+    void encodeEntries();
+    void runEncodeBatches();
+
+    // covers entities drifting from their cell and players moving until their visibility is updated again
+    static constexpr double VIEW_SLACK = 16.0;
+    // below this many entries the hand-off to the workers costs more than it saves
+    static constexpr size_t MIN_PARALLEL_ENTRIES = 256;
+    static constexpr size_t ENCODE_BATCH_SIZE = 64;
     static std::shared_ptr<spdlog::logger> LOGGER;
     WorldServer* world;
     std::unordered_set<EntityTrackerEntry> entries;
     std::unordered_map<int32_t,EntityTrackerEntry> trackedEntityHashTable;
     int32_t maxTrackingDistanceThreshold;
+    EntityTrackerGrid grid;
+    // where each player's visibility was last updated, the entries tracking it are near there or near it now
+    std::unordered_map<EntityPlayerMP*, std::pair<double, double>> playerViewCenters;
+    std::vector<EntityTrackerEntry*> nearbyEntries;
+    bool parallelEncoding = false;
+    std::vector<EntityTrackerEntry*> encodeQueue;
+    std::atomic<size_t> nextEncodeBatch{0};
+    std::mutex errorLock;
+    std::exception_ptr error;
 };
@@ -5,6 +5,7 @@
 #include "EntityLeashKnot.h"
 #include "EntityTracker.h"
 #include "../item/ItemMap.h"
+#include "../world/World.h"
 #include "ai/attributes/AttributeMap.h"
 #include "storage/MapData.h"
 
@@ -26,7 +27,7 @@ void EntityTrackerEntry::updatePlayerList(const std::vector<EntityPlayerMP*> &pl
          lastTrackedEntityPosZ = trackedEntity->posZ;
          updatedPlayerVisibility = true;
          playerEntitiesUpdated = true;
-         updatePlayerEntities(players);
+         updateNearbyPlayerEntities();
       }
 
       auto list = trackedEntity->getPassengers();
@@ -52,18 +53,18 @@ void EntityTrackerEntry::updatePlayerList(const std::vector<EntityPlayerMP*> &pl
                }
             }
          }
-
-         sendMetadata();
       }
+}
 
-      if (updateCounter % updateFrequency == 0 || trackedEntity->isAirBorne || trackedEntity->getDataManager().isDirty()) {
+void EntityTrackerEntry::encodeUpdates() {
+      if (updateCounter % updateFrequency == 0 || trackedEntity->isAirBorne) {
          int32_t k1 = 0;
          if (trackedEntity->isRiding()) {
             auto k1 = MathHelper::floor(trackedEntity->rotationYaw * 256.0F / 360.0F);
             auto l1 = MathHelper::floor(trackedEntity->rotationPitch * 256.0F / 360.0F);
             bool flag3 = MathHelper::abs(k1 - encodedRotationYaw) >= 1 || MathHelper::abs(l1 - encodedRotationPitch) >= 1;
             if (flag3) {
-               sendPacketToTrackedPlayers(new SPacketEntity.S16PacketEntityLook(trackedEntity->getEntityId(), (std::byte)k1, (std::byte)l1, trackedEntity->onGround));
+               queueForTracking(new SPacketEntity.S16PacketEntityLook(trackedEntity->getEntityId(), (std::byte)k1, (std::byte)l1, trackedEntity->onGround));
                encodedRotationYaw = k1;
                encodedRotationPitch = l1;
             }
@@ -71,7 +72,6 @@ void EntityTrackerEntry::updatePlayerList(const std::vector<EntityPlayerMP*> &pl
             encodedPosX = EntityTracker::getPositionLong(trackedEntity->posX);
             encodedPosY = EntityTracker::getPositionLong(trackedEntity->posY);
             encodedPosZ = EntityTracker::getPositionLong(trackedEntity->posZ);
-            sendMetadata();
             ridingEntity = true;
          } else {
             ++ticksSinceLastForcedTeleport;
@@ -120,15 +120,14 @@ void EntityTrackerEntry::updatePlayerList(const std::vector<EntityPlayerMP*> &pl
                   lastTrackedEntityMotionX = trackedEntity->motionX;
                   lastTrackedEntityMotionY = trackedEntity->motionY;
                   motionZ = trackedEntity->motionZ;
-                  sendPacketToTrackedPlayers(new SPacketEntityVelocity(trackedEntity->getEntityId(), lastTrackedEntityMotionX, lastTrackedEntityMotionY, motionZ));
+                  queueForTracking(new SPacketEntityVelocity(trackedEntity->getEntityId(), lastTrackedEntityMotionX, lastTrackedEntityMotionY, motionZ));
                }
             }
 
             if (packet1 != nullptr) {
-               sendPacketToTrackedPlayers((Packet)packet1);
+               queueForTracking((Packet)packet1);
             }
 
-            sendMetadata();
             if (flag) {
                encodedPosX = i1;
                encodedPosY = i2;
@@ -145,7 +144,7 @@ void EntityTrackerEntry::updatePlayerList(const std::vector<EntityPlayerMP*> &pl
 
          k1 = MathHelper::floor(trackedEntity->getRotationYawHead() * 256.0F / 360.0F);
          if (MathHelper::abs(k1 - lastHeadMotion) >= 1) {
-            sendPacketToTrackedPlayers(new SPacketEntityHeadLook(trackedEntity, (std::byte)k1));
+            queueForTracking(new SPacketEntityHeadLook(trackedEntity, (std::byte)k1));
             lastHeadMotion = k1;
          }
 
@@ -154,9 +153,34 @@ void EntityTrackerEntry::updatePlayerList(const std::vector<EntityPlayerMP*> &pl
 
       ++updateCounter;
       if (trackedEntity->velocityChanged) {
-         sendToTrackingAndSelf(new SPacketEntityVelocity(trackedEntity));
+         queueForTrackingAndSelf(new SPacketEntityVelocity(trackedEntity));
          trackedEntity->velocityChanged = false;
       }
+
+    if (dirtyMetadata != 0) {
+        encodeMetadata(dirtyMetadata);
+        dirtyMetadata = 0;
+    }
+}
+
+void EntityTrackerEntry::flushUpdates() {
+    for (auto& [packet, andSelf] : outbound) {
+        if (andSelf) {
+            sendToTrackingAndSelf(packet);
+        } else {
+            sendPacketToTrackedPlayers(packet);
+        }
+    }
+
+    outbound.clear();
+}
+
+void EntityTrackerEntry::queueForTracking(Packet packetIn) {
+    outbound.emplace_back(packetIn, false);
+}
+
+void EntityTrackerEntry::queueForTrackingAndSelf(Packet packetIn) {
+    outbound.emplace_back(packetIn, true);
 }
 
 void EntityTrackerEntry::sendPacketToTrackedPlayers(Packet packetIn) {
@@ -275,6 +299,19 @@ void EntityTrackerEntry::updatePlayerEntities(std::span<EntityPlayer*> players)
       }
 }
 
+void EntityTrackerEntry::updateNearbyPlayerEntities() {
+    // a tracking player that left the range is dropped here, one that entered it can only be near the entity
+    std::vector<EntityPlayerMP*> tracking(trackingPlayers.begin(), trackingPlayers.end());
+    for (auto entityplayermp : tracking) {
+        updatePlayerEntity(entityplayermp);
+    }
+
+    auto i = MathHelper::min(range, maxRange);
+    trackedEntity->world->getPlayerProximityIndex().forEachPlayerNear((double)encodedPosX / 4096.0, (double)encodedPosZ / 4096.0, i, [&](EntityPlayer* entityplayer, uint32_t) {
+        updatePlayerEntity((EntityPlayerMP*)entityplayer);
+    });
+}
+
 void EntityTrackerEntry::removeTrackedPlayerSymmetric(EntityPlayerMP *playerMP) {
     if (trackingPlayers.contains(playerMP)) {
          trackingPlayers.erase(playerMP);
@@ -295,17 +332,22 @@ void EntityTrackerEntry::resetPlayerVisibility() {
     updatedPlayerVisibility = false;
 }
 
-void EntityTrackerEntry::sendMetadata() {
-    EntityDataManager entitydatamanager = trackedEntity->getDataManager();
-      if (entitydatamanager.isDirty()) {
-         sendToTrackingAndSelf(new SPacketEntityMetadata(trackedEntity->getEntityId(), entitydatamanager, false));
+void EntityTrackerEntry::markMetadataDirty(uint64_t dirtyFields) {
+    dirtyMetadata |= dirtyFields;
+}
+
+void EntityTrackerEntry::encodeMetadata(uint64_t dirtyFields) {
+    // each packet is built once and shared by every tracking player
+    if ((dirtyFields & ~(uint64_t{1} << World::ATTRIBUTES_DATA_FIELD)) != 0) {
+         auto& entitydatamanager = trackedEntity->getDataManager();
+         queueForTrackingAndSelf(new SPacketEntityMetadata(trackedEntity->getEntityId(), entitydatamanager, false));
       }
 
-      if (Util::instanceof<EntityLivingBase>(trackedEntity)) {
+      if ((dirtyFields & uint64_t{1} << World::ATTRIBUTES_DATA_FIELD) != 0 && Util::instanceof<EntityLivingBase>(trackedEntity)) {
          AttributeMap attributemap = (AttributeMap)((EntityLivingBase*)trackedEntity)->getAttributeMap();
          auto set = attributemap.getDirtyInstances();
          if (!set.empty()) {
-            sendToTrackingAndSelf(new SPacketEntityProperties(trackedEntity->getEntityId(), set));
+            queueForTrackingAndSelf(new SPacketEntityProperties(trackedEntity->getEntityId(), set));
          }
 
          set.clear();
@@ -3,11 +3,20 @@
 #include "../../../../spdlog/include/spdlog/logger.h"
 
 #include <memory>
+#include <utility>
+#include <vector>
 
 class EntityTrackerEntry {
 public:
     EntityTrackerEntry(Entity* entityIn, int32_t rangeIn, int32_t maxRangeIn, int32_t updateFrequencyIn, bool sendVelocityUpdatesIn);
+    // Updates who sees the entity and sends the passenger and map packets; encodeUpdates follows.
     void updatePlayerList(const std::vector<EntityPlayerMP*>& players);
+    // Computes the movement, rotation and velocity deltas and encodes their packets, and those of the watched data
+    // marked by markMetadataDirty, into this entry's outbound buffer.
+    // Only this entry and its entity are touched, so entries may be encoded on different threads.
+    void encodeUpdates();
+    // Sends what encodeUpdates buffered to the tracking players, on the tick thread.
+    void flushUpdates();
     void sendPacketToTrackedPlayers(Packet packetIn);
     void sendToTrackingAndSelf(Packet packetIn);
     void sendDestroyEntityPacketToTrackedPlayers();
@@ -15,10 +24,14 @@ public:
     void updatePlayerEntity(EntityPlayerMP* playerMP);
     bool isVisibleTo(EntityPlayerMP* playerMP) const;
     void updatePlayerEntities(std::span<EntityPlayer*> players);
+    // updatePlayerEntities for the players tracking the entity and those the world's player index finds in range.
+    void updateNearbyPlayerEntities();
     void removeTrackedPlayerSymmetric(EntityPlayerMP* playerMP);
     Entity* getTrackedEntity() const;
     void setMaxRange(int32_t maxRangeIn);
     void resetPlayerVisibility();
+    // Marks the watched data and attributes behind dirtyFields for the next encodeUpdates, see World::markEntityDataDirty.
+    void markMetadataDirty(uint64_t dirtyFields);
 
 
     friend bool operator==(const EntityTrackerEntry& lhs, const EntityTrackerEntry& rhs);
@@ -26,7 +39,9 @@ public:
     int32_t updateCounter;
     bool playerEntitiesUpdated;
 private:
-    void sendMetadata();
+    void queueForTracking(Packet packetIn);
+    void queueForTrackingAndSelf(Packet packetIn);
+    void encodeMetadata(uint64_t dirtyFields);
     bool isPlayerWatchingThisChunk(EntityPlayerMP* playerMP) const;
     Packet createSpawnPacket();
 
@@ -56,6 +71,9 @@ private:
    bool ridingEntity;
    bool onGround;
    std::unordered_set<EntityPlayerMP*> trackingPlayers;
+   // packets of the last encodeUpdates, true when the tracked player gets them too
+   std::vector<std::pair<Packet, bool>> outbound;
+   uint64_t dirtyMetadata = 0;
 };
 
 namespace std
@@ -0,0 +1,156 @@
+#pragma once
+#include <algorithm>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+#include "../util/math/MathHelper.h"
+
+class EntityTrackerEntry;
+
+// Tracker entries bucketed by the chunk column their entity stands in. An entry moves between cells when its entity
+// crosses a chunk border, so a player only has to look at the entries in the columns within its view distance
+// instead of every tracked entity. Visibility is decided on the XZ plane, the grid has no vertical sections.
+// Entries only need getTrackedEntity() with posX and posZ, so the tests can grid plain stand-ins.
+template <typename Entry>
+class BasicEntityTrackerGrid {
+public:
+    static constexpr int32_t CELL_SHIFT = 4;
+
+    void add(Entry* entry);
+    void remove(Entry* entry);
+    // Moves entry to the cell of its entity's current position; true when it changed cells.
+    bool update(Entry* entry);
+    size_t size() const;
+
+    // Calls visitor(entry) for every entry whose entity stood within range of x, z on the XZ plane when it was
+    // last added or updated.
+    template <typename Visitor>
+    void forEachEntryNear(double x, double z, double range, Visitor&& visitor) const;
+    // Calls visitor(entry) for every entry in the chunk column at chunkX, chunkZ.
+    template <typename Visitor>
+    void forEachEntryInChunk(int32_t chunkX, int32_t chunkZ, Visitor&& visitor) const;
+private:
+    std::unordered_map<int64_t, std::vector<Entry*>> cells;
+    std::unordered_map<Entry*, int64_t> cellOfEntry;
+
+    static int64_t getKey(int32_t cellX, int32_t cellZ);
+    static int64_t getKey(const Entry* entry);
+    void removeFromCell(int64_t key, Entry* entry);
+};
+
+using EntityTrackerGrid = BasicEntityTrackerGrid<EntityTrackerEntry>;
+
+template <typename Entry>
+int64_t BasicEntityTrackerGrid<Entry>::getKey(int32_t cellX, int32_t cellZ) {
+    return (static_cast<int64_t>(cellX) << 32) | (static_cast<uint32_t>(cellZ) ^ 0x80000000u);
+}
+
+template <typename Entry>
+template <typename Visitor>
+void BasicEntityTrackerGrid<Entry>::forEachEntryNear(double x, double z, double range, Visitor&& visitor) const {
+    auto minX = MathHelper::floor(x - range) >> CELL_SHIFT;
+    auto maxX = MathHelper::floor(x + range) >> CELL_SHIFT;
+    auto minZ = MathHelper::floor(z - range) >> CELL_SHIFT;
+    auto maxZ = MathHelper::floor(z + range) >> CELL_SHIFT;
+    // a view wider than there are occupied cells is cheaper to answer from the occupied cells
+    if (static_cast<size_t>(maxX - minX + 1) * static_cast<size_t>(maxZ - minZ + 1) > cells.size()) {
+        for (auto& [key, entries] : cells) {
+            auto cellX = static_cast<int32_t>(key >> 32);
+            auto cellZ = static_cast<int32_t>(static_cast<uint32_t>(key) ^ 0x80000000u);
+            if (cellX >= minX && cellX <= maxX && cellZ >= minZ && cellZ <= maxZ) {
+                for (auto entry : entries) {
+                    visitor(entry);
+                }
+            }
+        }
+
+        return;
+    }
+
+    for (auto cellX = minX; cellX <= maxX; ++cellX) {
+        for (auto cellZ = minZ; cellZ <= maxZ; ++cellZ) {
+            auto ite = cells.find(getKey(cellX, cellZ));
+            if (ite != cells.end()) {
+                for (auto entry : ite->second) {
+                    visitor(entry);
+                }
+            }
+        }
+    }
+}
+
+template <typename Entry>
+template <typename Visitor>
+void BasicEntityTrackerGrid<Entry>::forEachEntryInChunk(int32_t chunkX, int32_t chunkZ, Visitor&& visitor) const {
+    auto ite = cells.find(getKey(chunkX, chunkZ));
+    if (ite != cells.end()) {
+        for (auto entry : ite->second) {
+            visitor(entry);
+        }
+    }
+}
+
+template <typename Entry>
+void BasicEntityTrackerGrid<Entry>::add(Entry* entry) {
+    auto key = getKey(entry);
+    if (cellOfEntry.emplace(entry, key).second) {
+        cells[key].emplace_back(entry);
+    }
+}
+
+template <typename Entry>
+void BasicEntityTrackerGrid<Entry>::remove(Entry* entry) {
+    auto ite = cellOfEntry.find(entry);
+    if (ite != cellOfEntry.end()) {
+        removeFromCell(ite->second, entry);
+        cellOfEntry.erase(ite);
+    }
+}
+
+template <typename Entry>
+bool BasicEntityTrackerGrid<Entry>::update(Entry* entry) {
+    auto ite = cellOfEntry.find(entry);
+    if (ite == cellOfEntry.end()) {
+        return false;
+    }
+
+    auto key = getKey(entry);
+    if (key == ite->second) {
+        return false;
+    }
+
+    removeFromCell(ite->second, entry);
+    cells[key].emplace_back(entry);
+    ite->second = key;
+    return true;
+}
+
+template <typename Entry>
+size_t BasicEntityTrackerGrid<Entry>::size() const {
+    return cellOfEntry.size();
+}
+
+template <typename Entry>
+int64_t BasicEntityTrackerGrid<Entry>::getKey(const Entry* entry) {
+    auto entity = entry->getTrackedEntity();
+    return getKey(MathHelper::floor(entity->posX) >> CELL_SHIFT, MathHelper::floor(entity->posZ) >> CELL_SHIFT);
+}
+
+template <typename Entry>
+void BasicEntityTrackerGrid<Entry>::removeFromCell(int64_t key, Entry* entry) {
+    auto cell = cells.find(key);
+    if (cell == cells.end()) {
+        return;
+    }
+
+    auto& entries = cell->second;
+    auto ite = std::find(entries.begin(), entries.end(), entry);
+    if (ite != entries.end()) {
+        *ite = entries.back();
+        entries.pop_back();
+    }
+
+    if (entries.empty()) {
+        cells.erase(cell);
+    }
+}
@@ -89,9 +89,9 @@ applyModifiersToAttributeInstance(IAttributeInstance *instance, NBTTagCompound *
          for(auto i = 0; i < nbttaglist.tagCount(); ++i) {
             AttributeModifier attributemodifier = readAttributeModifierFromNBT(nbttaglist.getCompoundTagAt(i));
             if (attributemodifier != nullptr) {
-               AttributeModifier attributemodifier1 = instance->getModifier(attributemodifier.getID());
+               const AttributeModifier* attributemodifier1 = instance->getModifier(attributemodifier.getID());
                if (attributemodifier1 != nullptr) {
-                  instance->removeModifier(attributemodifier1);
+                  instance->removeModifier(attributemodifier.getID());
                }
 
                instance->applyModifier(attributemodifier);
@@ -5,12 +5,14 @@
 
 IAttributeInstance * AbstractAttributeMap::getAttributeInstance(IAttribute *attribute)
 {
-    return attributes.find(attribute)->second;
+    auto ordinal = attribute->getOrdinal();
+    return ordinal < attributes.size() ? attributes[ordinal] : nullptr;
 }
 
 IAttributeInstance * AbstractAttributeMap::getAttributeInstanceByName(const std::string& attributeName)
 {
-    return attributesByName.find(attributeName)->second;
+    auto ite = attributesByName.find(attributeName);
+    return ite != attributesByName.end() ? ite->second : nullptr;
 }
 
 IAttributeInstance * AbstractAttributeMap::registerAttribute(IAttribute *attribute)
@@ -23,11 +25,22 @@ IAttributeInstance * AbstractAttributeMap::registerAttribute(IAttribute *attribu
     {
         IAttributeInstance* iattributeinstance = createInstance(attribute);
         attributesByName.emplace(attribute->getName(), iattributeinstance);
-        attributes.emplace(attribute, iattributeinstance);
+        auto ordinal = attribute->getOrdinal();
+        if (ordinal >= attributes.size())
+        {
+            attributes.resize(ordinal + 1, nullptr);
+        }
 
+        attributes[ordinal] = iattributeinstance;
         for(IAttribute* iattribute = attribute->getParent(); iattribute != nullptr; iattribute = iattribute->getParent()) 
         {
-            descendantsByParent.put(iattribute, attribute);
+            auto parentOrdinal = iattribute->getOrdinal();
+            if (parentOrdinal >= descendantsByParent.size())
+            {
+                descendantsByParent.resize(parentOrdinal + 1);
+            }
+
+            descendantsByParent[parentOrdinal].emplace_back(attribute);
         }
 
         return iattributeinstance;
@@ -37,10 +50,24 @@ IAttributeInstance * AbstractAttributeMap::registerAttribute(IAttribute *attribu
 std::vector<IAttributeInstance *> AbstractAttributeMap::getAllAttributes() const
 {
     std::vector<IAttributeInstance *> collection;
-    Util::Collection(collection,attributesByName);
+    for (auto iattributeinstance : attributes)
+    {
+        if (iattributeinstance != nullptr)
+        {
+            collection.emplace_back(iattributeinstance);
+        }
+    }
+
     return collection;
 }
 
+const std::vector<IAttribute*>& AbstractAttributeMap::getDescendants(IAttribute* attribute) const
+{
+    static const std::vector<IAttribute*> NONE;
+    auto ordinal = attribute->getOrdinal();
+    return ordinal < descendantsByParent.size() ? descendantsByParent[ordinal] : NONE;
+}
+
 void AbstractAttributeMap::onAttributeModified(IAttributeInstance *instance)
 {
 
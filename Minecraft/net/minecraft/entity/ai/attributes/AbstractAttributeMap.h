@@ -1,5 +1,6 @@
 #pragma once
 #include <unordered_map>
+#include <vector>
 
 #include "AttributeModifier.h"
 
@@ -16,12 +17,15 @@ public:
     virtual void onAttributeModified(IAttributeInstance* instance);
     void removeAttributeModifiers(const std::unordered_multimap<std::string,AttributeModifier>& modifiers);
     void applyAttributeModifiers(const std::unordered_multimap<std::string,AttributeModifier>& modifiers);
+    // The registered attributes that have attribute as an ancestor.
+    const std::vector<IAttribute*>& getDescendants(IAttribute* attribute) const;
 
 protected:
 
     virtual IAttributeInstance* createInstance(IAttribute* var1) = 0;
 
-    std::unordered_map<IAttribute*,IAttributeInstance*> attributes;
+    // indexed by IAttribute::getOrdinal(), nullptr for attributes this map does not have
+    std::vector<IAttributeInstance*> attributes;
     std::unordered_map<std::string,IAttributeInstance *> attributesByName;
-    std::unordered_multimap<std::string,AttributeModifier> descendantsByParent;
+    std::vector<std::vector<IAttribute*>> descendantsByParent;
 };
@@ -5,6 +5,13 @@
 #include "IAttribute.h"
 #include "IAttributeInstance.h"
 #include "Util.h"
+#include "../../Entity.h"
+#include "../../../world/World.h"
+
+AttributeMap::AttributeMap(Entity* ownerIn)
+    : owner(ownerIn)
+{
+}
 
 ModifiableAttributeInstance * AttributeMap::getAttributeInstance(IAttribute *attribute)
 {
@@ -38,13 +45,14 @@ void AttributeMap::onAttributeModified(IAttributeInstance *instance)
     if (instance->getAttribute()->getShouldWatch()) 
     {
         dirtyInstances.emplace(instance);
+        if (owner != nullptr && owner->world != nullptr && !owner->world->isRemote)
+        {
+            owner->world->markEntityDataDirty(owner, World::ATTRIBUTES_DATA_FIELD);
+        }
     }
 
-    Iterator var2 = descendantsByParent.get(instance->getAttribute()).iterator();
-
-    while(var2.hasNext()) 
+    for (auto iattribute : getDescendants(instance->getAttribute()))
     {
-        IAttribute* iattribute = (IAttribute)var2.next();
         ModifiableAttributeInstance* modifiableattributeinstance = getAttributeInstance(iattribute);
         if (modifiableattributeinstance != nullptr) 
         {
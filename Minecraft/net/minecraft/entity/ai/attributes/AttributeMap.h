@@ -2,11 +2,14 @@
 #include <unordered_set>
 #include "AbstractAttributeMap.h"
 
+class Entity;
 class ModifiableAttributeInstance;
 
 class AttributeMap :public AbstractAttributeMap
 {
 public:
+    // ownerIn, when set, is flagged on its world's dirty entity list whenever a watched attribute changes.
+    explicit AttributeMap(Entity* ownerIn = nullptr);
     ModifiableAttributeInstance* getAttributeInstance(IAttribute* attribute);
     ModifiableAttributeInstance* getAttributeInstanceByName(std::string attributeName);
     IAttributeInstance* registerAttribute(IAttribute* attribute) override;
@@ -17,7 +20,8 @@ protected:
 
     IAttributeInstance* createInstance(IAttribute* attribute) override;
 
-    std::unordered_map<std::string,IAttributeInstance> instancesByName;
+    std::unordered_map<std::string,IAttributeInstance*> instancesByName;
 private:
+    Entity* owner;
     std::unordered_set<IAttributeInstance *> dirtyInstances;
 };
\ No newline at end of file
@@ -1,5 +1,15 @@
 #include "BaseAttribute.h"
+#include <mutex>
 #include <stdexcept>
+#include <unordered_map>
+
+uint32_t BaseAttribute::getOrdinalFor(std::string_view name)
+{
+    static std::mutex lock;
+    static std::unordered_map<std::string, uint32_t> ordinals;
+    std::lock_guard<std::mutex> guard(lock);
+    return ordinals.try_emplace(std::string(name), static_cast<uint32_t>(ordinals.size())).first->second;
+}
 
 std::string BaseAttribute::getName() const
 {
@@ -27,13 +37,18 @@ IAttribute * BaseAttribute::getParent() const
     return parent;
 }
 
+uint32_t BaseAttribute::getOrdinal() const
+{
+    return ordinal;
+}
+
 std::size_t BaseAttribute::hash_code() const
 {
     return std::hash<std::string>{}(translationKey);
 }
 
 BaseAttribute::BaseAttribute(IAttribute *parentIn, std::string_view unlocalizedNameIn, double defaultValueIn)
-    :parent(parentIn),translationKey(unlocalizedNameIn),defaultValue(defaultValueIn)
+    :parent(parentIn),ordinal(getOrdinalFor(unlocalizedNameIn)),translationKey(unlocalizedNameIn),defaultValue(defaultValueIn)
 {
     if(unlocalizedNameIn.empty())
     {
@@ -9,13 +9,19 @@ public:
     bool getShouldWatch() const override;
     BaseAttribute* setShouldWatch(bool shouldWatchIn);
     IAttribute* getParent() const override;
+    uint32_t getOrdinal() const override;
     std::size_t hash_code() const;
     friend bool operator==(const BaseAttribute& lhs,const BaseAttribute& rhs) noexcept;
 
 protected:
     BaseAttribute(IAttribute* parentIn, std::string_view unlocalizedNameIn, double defaultValueIn);
 private:
+    // One ordinal per name: attributes compare by name, and the maps indexed by ordinal would otherwise grow with every
+    // attribute instance ever constructed.
+    static uint32_t getOrdinalFor(std::string_view name);
+
     IAttribute* parent;
+    uint32_t ordinal;
     std::string translationKey;
     double defaultValue;
     bool shouldWatch;
@@ -1,4 +1,5 @@
 #pragma once
+#include <cstdint>
 #include <string>
 
 class IAttribute
@@ -13,4 +14,7 @@ public:
     virtual bool getShouldWatch() const = 0;
 
     virtual IAttribute* getParent() const = 0;
+
+    // Dense index handed out in registration order, attribute maps keep their instances in an array by it.
+    virtual uint32_t getOrdinal() const = 0;
 };
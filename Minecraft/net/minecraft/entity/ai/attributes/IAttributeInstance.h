@@ -1,5 +1,6 @@
 #pragma once
 #include <cstdint>
+#include <vector>
 
 class AttributeModifier;
 
@@ -24,7 +25,8 @@ public:
 
     virtual bool hasModifier(const AttributeModifier& var1) = 0;
 
-    virtual AttributeModifier getModifier(const xg::Guid& var1) = 0;
+    // nullptr when no modifier with that id is applied, the pointer is invalidated by the next change.
+    virtual const AttributeModifier* getModifier(const xg::Guid& var1) = 0;
 
     virtual void applyModifier(const AttributeModifier& var1) = 0;
 
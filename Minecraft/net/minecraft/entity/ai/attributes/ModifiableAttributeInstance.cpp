@@ -7,14 +7,13 @@
 #include "IAttribute.h"
 #include "../../../../../../spdlog/include/spdlog/fmt/bundled/format.h"
 
+#include <algorithm>
+#include <stdexcept>
+
 ModifiableAttributeInstance::ModifiableAttributeInstance(AbstractAttributeMap *attributeMapIn,
                                                          IAttribute *genericAttributeIn)
         :attributeMap(attributeMapIn),genericAttribute(genericAttributeIn),baseValue(genericAttributeIn->getDefaultValue())
 {
-    for(auto i = 0; i < 3; ++i) 
-    {
-        mapByOperation.emplace(i, {});
-    }
 }
 
 IAttribute * ModifiableAttributeInstance::getAttribute()
@@ -31,36 +30,46 @@ void ModifiableAttributeInstance::setBaseValue(double baseValue)
 {
     if (baseValue != getBaseValue()) 
     {
-        baseValue = baseValue;
+        this->baseValue = baseValue;
         flagForUpdate();
     }
 }
 
 std::vector<AttributeModifier> ModifiableAttributeInstance::getModifiersByOperation(int32_t operation)
 {
-    return mapByOperation.find(operation)->second;
+    std::vector<AttributeModifier> list;
+    for (auto& attributemodifier : modifiers)
+    {
+        if (attributemodifier.getOperation() == operation)
+        {
+            list.emplace_back(attributemodifier);
+        }
+    }
+
+    return list;
 }
 
 std::vector<AttributeModifier> ModifiableAttributeInstance::getModifiers()
 {
-    std::unordered_set<> set;
+    return modifiers;
+}
 
-    for(auto i = 0; i < 3; ++i) 
+const AttributeModifier* ModifiableAttributeInstance::getModifier(const xg::Guid &uuid)
+{
+    for (auto& attributemodifier : modifiers)
     {
-        set.addAll(getModifiersByOperation(i));
+        if (attributemodifier.getID() == uuid)
+        {
+            return &attributemodifier;
+        }
     }
 
-    return set;    
-}
-
-AttributeModifier ModifiableAttributeInstance::getModifier(const xg::Guid &uuid)
-{
-    return mapByUUID.find(uuid)->second;
+    return nullptr;
 }
 
 bool ModifiableAttributeInstance::hasModifier(const AttributeModifier &modifier)
 {
-    return mapByUUID.find(modifier.getID()) != mapByUUID.end();
+    return getModifier(modifier.getID()) != nullptr;
 }
 
 void ModifiableAttributeInstance::applyModifier(const AttributeModifier &modifier)
@@ -69,64 +78,38 @@ void ModifiableAttributeInstance::applyModifier(const AttributeModifier &modifie
     {
         throw std::logic_error("Modifier is already applied on this attribute!");
     }
-    else 
-    {
-        Set set = (Set)mapByName.get(modifier.getName());
-        if (set.empty()) 
-        {
-            set = Sets.newHashSet();
-            mapByName.put(modifier.getName(), set);
-        }
 
-        ((Set)mapByOperation.get(modifier.getOperation())).add(modifier);
-        ((Set)set).add(modifier);
-        mapByUUID.put(modifier.getID(), modifier);
-        flagForUpdate();
-    }
+    modifiers.emplace_back(modifier);
+    flagForUpdate();
 }
 
 void ModifiableAttributeInstance::removeModifier(const AttributeModifier &modifier)
 {
-    for(auto i = 0; i < 3; ++i) 
-    {
-        Set set = (Set)mapByOperation.get(i);
-        set.remove(modifier);
-    }
-
-    Set set1 = (Set)mapByName.get(modifier.getName());
-    if (set1 != nullptr) 
-    {
-        set1.remove(modifier);
-        if (set1.isEmpty()) 
-        {
-            mapByName.remove(modifier.getName());
-        }
-    }
-
-    mapByUUID.remove(modifier.getID());
-    flagForUpdate();
+    removeModifier(modifier.getID());
 }
 
 void ModifiableAttributeInstance::removeModifier(const xg::Guid &p_188479_1_)
 {
-    AttributeModifier attributemodifier = getModifier(p_188479_1_);
-    if (attributemodifier != nullptr) 
+    // the id may belong to one of our own modifiers, compare against a copy
+    auto id = p_188479_1_;
+    auto ite = std::find_if(modifiers.begin(), modifiers.end(), [&](const AttributeModifier& attributemodifier)
+    {
+        return attributemodifier.getID() == id;
+    });
+
+    if (ite != modifiers.end())
     {
-        removeModifier(attributemodifier);
+        modifiers.erase(ite);
+        flagForUpdate();
     }
 }
 
 void ModifiableAttributeInstance::removeAllModifiers()
 {
-    std::vector<AttributeModifier> collection = getModifiers();
-    if (collection != nullptr) 
+    if (!modifiers.empty())
     {
-        Iterator var2 = Lists.newArrayList(collection).iterator();
-
-        while(var2.hasNext()) {
-            AttributeModifier attributemodifier = (AttributeModifier)var2.next();
-            removeModifier(attributemodifier);
-        }
+        modifiers.clear();
+        flagForUpdate();
     }
 }
 
@@ -150,42 +133,60 @@ void ModifiableAttributeInstance::flagForUpdate()
 double ModifiableAttributeInstance::computeValue()
 {
     double d0 = getBaseValue();
-
-    AttributeModifier attributemodifier;
-    for(Iterator var3 = getAppliedModifiers(0).iterator(); var3.hasNext(); d0 += attributemodifier.getAmount()) 
-    {
-        attributemodifier = (AttributeModifier)var3.next();
-    }
+    forEachAppliedModifier(0, [&](double amount) { d0 += amount; });
 
     double d1 = d0;
+    forEachAppliedModifier(1, [&](double amount) { d1 += d0 * amount; });
+    forEachAppliedModifier(2, [&](double amount) { d1 *= 1.0 + amount; });
 
-    Iterator var5;
-    AttributeModifier attributemodifier2;
-    for(var5 = getAppliedModifiers(1).iterator(); var5.hasNext(); d1 += d0 * attributemodifier2.getAmount()) 
+    return genericAttribute->clampValue(d1);
+}
+
+template <typename Visitor>
+void ModifiableAttributeInstance::forEachAppliedModifier(int32_t operation, Visitor&& visitor)
+{
+    for (auto& attributemodifier : modifiers)
     {
-        attributemodifier2 = (AttributeModifier)var5.next();
+        if (attributemodifier.getOperation() == operation)
+        {
+            visitor(attributemodifier.getAmount());
+        }
     }
 
-    for(var5 = getAppliedModifiers(2).iterator(); var5.hasNext(); d1 *= 1.0 + attributemodifier2.getAmount()) 
+    // a modifier already seen closer to this attribute is not applied twice
+    auto isShadowed = [&](const xg::Guid& id, IAttribute* ancestor)
     {
-        attributemodifier2 = (AttributeModifier)var5.next();
-    }
+        if (getModifier(id) != nullptr)
+        {
+            return true;
+        }
 
-    return genericAttribute->clampValue(d1);
-}
+        for (IAttribute* iattribute = genericAttribute->getParent(); iattribute != ancestor; iattribute = iattribute->getParent())
+        {
+            auto instance = static_cast<ModifiableAttributeInstance*>(attributeMap->getAttributeInstance(iattribute));
+            if (instance != nullptr && instance->getModifier(id) != nullptr)
+            {
+                return true;
+            }
+        }
 
-std::vector<AttributeModifier> ModifiableAttributeInstance::getAppliedModifiers(int32_t operation)
-{
-    Set set = Sets.newHashSet(getModifiersByOperation(operation));
+        return false;
+    };
 
     for(IAttribute* iattribute = genericAttribute->getParent(); iattribute != nullptr; iattribute = iattribute->getParent()) 
     {
-        IAttributeInstance* iattributeinstance = attributeMap->getAttributeInstance(iattribute);
-        if (iattributeinstance != nullptr) 
+        auto instance = static_cast<ModifiableAttributeInstance*>(attributeMap->getAttributeInstance(iattribute));
+        if (instance == nullptr)
         {
-            set.addAll(iattributeinstance->getModifiersByOperation(operation));
+            continue;
         }
-    }
 
-    return set;
+        for (auto& attributemodifier : instance->modifiers)
+        {
+            if (attributemodifier.getOperation() == operation && !isShadowed(attributemodifier.getID(), iattribute))
+            {
+                visitor(attributemodifier.getAmount());
+            }
+        }
+    }
 }
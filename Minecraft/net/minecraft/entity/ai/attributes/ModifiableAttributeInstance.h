@@ -1,6 +1,6 @@
 #pragma once
-#include <unordered_map>
-#include <unordered_set>
+#include <vector>
+#include "AttributeModifier.h"
 #include "IAttributeInstance.h"
 
 class AbstractAttributeMap;
@@ -15,26 +15,26 @@ public:
     void setBaseValue(double baseValue) override;
     std::vector<AttributeModifier> getModifiersByOperation(int32_t operation) override;
     std::vector<AttributeModifier> getModifiers() override;
-    AttributeModifier getModifier(const xg::Guid& uuid) override;
+    const AttributeModifier* getModifier(const xg::Guid& uuid) override;
     bool hasModifier(const AttributeModifier& modifier) override;
     void applyModifier(const AttributeModifier& modifier) override;
     void removeModifier(const AttributeModifier& modifier) override;
     void removeModifier(const xg::Guid& p_188479_1_) override;
     void removeAllModifiers() override;
     double getAttributeValue() override;
-
-protected:
+    // Drops the cached value of this instance and, through the map, of every descendant attribute.
     void flagForUpdate();
 
 private:
     double computeValue();
-    std::vector<AttributeModifier> getAppliedModifiers(int32_t operation);
+    // Calls visitor(amount) for the modifiers of operation on this instance and its ancestors, each id counted once.
+    template <typename Visitor>
+    void forEachAppliedModifier(int32_t operation, Visitor&& visitor);
 
     AbstractAttributeMap* attributeMap;
     IAttribute* genericAttribute;
-    std::unordered_map<int32_t,std::unordered_set<>> mapByOperation;
-    std::unordered_map<std::string,AttributeModifier> mapByName;
-    std::unordered_map<xg::Guid,std::unordered_set<>> mapByUUID;
+    // an instance rarely carries more than a few modifiers, a flat list beats the three maps it replaces
+    std::vector<AttributeModifier> modifiers;
     double baseValue;
     bool needsUpdate = true;
     double cachedValue;
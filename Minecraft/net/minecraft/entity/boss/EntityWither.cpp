@@ -129,7 +129,7 @@ void EntityWither::onLivingUpdate() {
          double d2 = getHeadY(i1);
          double d4 = getHeadZ(i1);
          world->spawnParticle(EnumParticleTypes::SMOKE_NORMAL, d10 + MathHelper::nextGaussian<double>(rand) * 0.30000001192092896, d2 + MathHelper::nextGaussian<double>(rand) * 0.30000001192092896, d4 + MathHelper::nextGaussian<double>(rand) * 0.30000001192092896, 0.0, 0.0, 0.0,{});
-         if (flag && world->rand(4) == 0) {
+         if (flag && world->getRandom()(4) == 0) {
             world->spawnParticle(EnumParticleTypes::SPELL_MOB, d10 + MathHelper::nextGaussian<double>(rand) * 0.30000001192092896, d2 + MathHelper::nextGaussian<double>(rand) * 0.30000001192092896, d4 + MathHelper::nextGaussian<double>(rand) * 0.30000001192092896, 0.699999988079071, 0.699999988079071, 0.5,{});
          }
       }
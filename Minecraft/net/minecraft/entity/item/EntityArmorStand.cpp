@@ -60,6 +60,8 @@ ItemStack EntityArmorStand::getItemStackFromSlot(EntityEquipmentSlot slotIn) {
 }
 
 void EntityArmorStand::setItemStackToSlot(EntityEquipmentSlot slotIn, ItemStack stack) {
+    // equipment changes go out from onUpdate
+    wakeUp(EntityActivationRange::WAKE_TICKS);
     switch(slotIn.getSlotType()) {
       case EquipmentType::HAND:
          playEquipSound(stack);
@@ -166,6 +168,7 @@ void EntityArmorStand::readEntityFromNBT(NBTTagCompound *compound) {
       noClip = hasNoGravity();
       auto nbttagcompound = compound->getCompoundTag("Pose");
       writePoseToNBT(nbttagcompound);
+      wakeUp(EntityActivationRange::WAKE_TICKS);
 }
 
 bool EntityArmorStand::canBePushed() {
@@ -174,6 +177,7 @@ bool EntityArmorStand::canBePushed() {
 
 EnumActionResult EntityArmorStand::applyPlayerInteraction(EntityPlayer *player, Vec3d vec, EnumHand hand) {
     ItemStack itemstack = player->getHeldItem(hand);
+      wakeUp(EntityActivationRange::WAKE_TICKS);
       if (!hasMarker() && itemstack.getItem() != Items::NAME_TAG) {
          if (!world->isRemote && !player->isSpectator()) {
             EntityEquipmentSlot entityequipmentslot = EntityLiving::getSlotForItemStack(itemstack);
@@ -206,6 +210,7 @@ EnumActionResult EntityArmorStand::applyPlayerInteraction(EntityPlayer *player,
 
 bool EntityArmorStand::attackEntityFrom(DamageSource::DamageSource source, float amount) {
     if (!world->isRemote && !isDead) {
+         wakeUp(EntityActivationRange::WAKE_TICKS);
          if (DamageSource::OUT_OF_WORLD == source) {
             setDead();
             return false;
@@ -348,6 +353,16 @@ void EntityArmorStand::onUpdate() {
          preventEntitySpawning = !flag;
          wasMarker = flag;
       }
+
+      if (canBecomeDormant()) {
+         world->setEntityDormant(this, {BlockPos(this), BlockPos(this).down()});
+      }
+}
+
+bool EntityArmorStand::canBecomeDormant() {
+    // a stand that cannot fall and has no timers running only changes when something touches it
+    return !world->isRemote && !isDead && activatedTick <= world->getTotalWorldTime() && (hasNoGravity() || (hasMarker() && onGround))
+        && hurtTime == 0 && !isBurning() && !isRiding() && !isBeingRidden() && getActivePotionEffects().empty();
 }
 
 void EntityArmorStand::setInvisible(bool invisible) {
@@ -685,6 +700,7 @@ void EntityArmorStand::setNoBasePlate(bool noBasePlate) {
 void EntityArmorStand::setMarker(bool marker) {
     dataManager.set(STATUS, setBit((std::byte)dataManager.get(STATUS), 16, marker));
     setSize(0.5F, 1.975F);
+    wakeUp(EntityActivationRange::WAKE_TICKS);
 }
 
 std::byte EntityArmorStand::setBit(std::byte p_184797_1_, uint8_t p_184797_2_, bool p_184797_3_) {
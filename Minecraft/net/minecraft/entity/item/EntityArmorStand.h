@@ -70,6 +70,7 @@ protected:
     void entityInit() override;
     void collideWithEntity(Entity* entityIn) override;
     void collideWithNearbyEntities() override;
+    bool canBecomeDormant();
     EntityEquipmentSlot getClickedSlot(Vec3d p_190772_1_);
     float updateDistance(float p_110146_1_, float p_110146_2_) override;
     void updatePotionMetadata() override;
@@ -27,7 +27,7 @@ float EntityExpBottle::getGravityVelocity() {
 void EntityExpBottle::onImpact(RayTraceResult result) {
     if (!world->isRemote) {
          world->playEvent(2002, BlockPos(this), PotionUtils::getPotionColor(PotionTypes::WATER));
-         auto i = 3 + world->rand(5) + world->rand(5);
+         auto i = 3 + world->getRandom()(5) + world->getRandom()(5);
 
          while(i > 0) {
             auto j = EntityXPOrb::getXPSplit(i);
@@ -57,80 +57,80 @@ void EntityFallingBlock::onUpdate() {
             }
          }
 
-         if (!hasNoGravity()) {
-            motionY -= 0.03999999910593033;
-         }
-
-         move(MoverType::SELF, motionX, motionY, motionZ);
-         if (!world->isRemote) {
-            blockpos1 = BlockPos(this);
-            bool flag = fallTile->getBlock() == Blocks::CONCRETE_POWDER;
-            bool flag1 = flag && world->getBlockState(blockpos1)->getMaterial() == Material::WATER;
-            double d0 = motionX * motionX + motionY * motionY + motionZ * motionZ;
-            if (flag && d0 > 1.0) {
-               auto raytraceresult = world->rayTraceBlocks(Vec3d(prevPosX, prevPosY, prevPosZ), Vec3d(posX, posY, posZ), true);
-               if (raytraceresult != std::nullopt && world->getBlockState(raytraceresult.getBlockPos()).getMaterial() == Material::WATER) {
-                  blockpos1 = raytraceresult.getBlockPos();
-                  flag1 = true;
-               }
-            }
-
-            if (!onGround && !flag1) {
-               if (fallTime > 100 && !world->isRemote && (blockpos1.gety() < 1 || blockpos1.gety() > 256) || fallTime > 600) {
-                  if (shouldDropItem && world->getGameRules().getBoolean("doEntityDrops")) {
-                     entityDropItem(ItemStack(block, 1, block->damageDropped(fallTile)), 0.0F);
-                  }
-
-                  setDead();
-               }
-            } else {
-               IBlockState* iblockstate = world->getBlockState(blockpos1);
-               if (!flag1 && BlockFalling::canFallThrough(world->getBlockState(BlockPos(posX, posY - 0.009999999776482582, posZ)))) {
-                  onGround = false;
-                  return;
-               }
+         updatePhysics(hasNoGravity() ? 0.0 : 0.03999999910593033);
+      }
+}
 
-               motionX *= 0.699999988079071;
-               motionZ *= 0.699999988079071;
-               motionY *= -0.5;
-               if (iblockstate->getBlock() != Blocks::PISTON_EXTENSION) {
-                  setDead();
-                  if (dontSetBlock) {
-                     if (Util::instanceof<BlockFalling>(block)) {
-                        ((BlockFalling*)block)->onBroken(world, blockpos1);
-                     }
-                  } else if (world->mayPlace(block, blockpos1, true, EnumFacing::UP, nullptr) && (flag1 || !BlockFalling::canFallThrough(world->getBlockState(blockpos1.down()))) && world->setBlockState(blockpos1, fallTile, 3)) {
-                     if (Util::instanceof<BlockFalling>(block)) {
-                        ((BlockFalling*)block)->onEndFalling(world, blockpos1, fallTile, iblockstate);
-                     }
-
-                     if (tileEntityData != nullptr && Util::instanceof<ITileEntityProvider>(block)) {
-                        TileEntity tileentity = world->getTileEntity(blockpos1);
-                        if (tileentity != nullptr) {
-                           NBTTagCompound* nbttagcompound = tileentity.writeToNBT(new NBTTagCompound());
-
-                            for(auto s :tileEntityData->getKeySet()){
-                              NBTBase* nbtbase = tileEntityData->getTag(s);
-                              if (!"x" == s && !"y" == s && !"z" == s) {
-                                 nbttagcompound->setTag(s, nbtbase.copy());
-                              }
-                           }
-
-                           tileentity.readFromNBT(nbttagcompound);
-                           tileentity.markDirty();
-                        }
-                     }
-                  } else if (shouldDropItem && world->getGameRules().getBoolean("doEntityDrops")) {
-                     entityDropItem(ItemStack(block, 1, block->damageDropped(fallTile)), 0.0F);
-                  }
-               }
-            }
-         }
+void EntityFallingBlock::onPhysicsUpdate() {
+    Block* block = fallTile->getBlock();
+    if (!world->isRemote) {
+       BlockPos blockpos1 = BlockPos(this);
+       bool flag = fallTile->getBlock() == Blocks::CONCRETE_POWDER;
+       bool flag1 = flag && world->getBlockState(blockpos1)->getMaterial() == Material::WATER;
+       double d0 = motionX * motionX + motionY * motionY + motionZ * motionZ;
+       if (flag && d0 > 1.0) {
+          auto raytraceresult = world->rayTraceBlocks(Vec3d(prevPosX, prevPosY, prevPosZ), Vec3d(posX, posY, posZ), true);
+          if (raytraceresult != std::nullopt && world->getBlockState(raytraceresult.getBlockPos()).getMaterial() == Material::WATER) {
+             blockpos1 = raytraceresult.getBlockPos();
+             flag1 = true;
+          }
+       }
+
+       if (!onGround && !flag1) {
+          if (fallTime > 100 && !world->isRemote && (blockpos1.gety() < 1 || blockpos1.gety() > 256) || fallTime > 600) {
+             if (shouldDropItem && world->getGameRules().getBoolean("doEntityDrops")) {
+                entityDropItem(ItemStack(block, 1, block->damageDropped(fallTile)), 0.0F);
+             }
+
+             setDead();
+          }
+       } else {
+          IBlockState* iblockstate = world->getBlockState(blockpos1);
+          if (!flag1 && BlockFalling::canFallThrough(world->getBlockState(BlockPos(posX, posY - 0.009999999776482582, posZ)))) {
+             onGround = false;
+             return;
+          }
+
+          motionX *= 0.699999988079071;
+          motionZ *= 0.699999988079071;
+          motionY *= -0.5;
+          if (iblockstate->getBlock() != Blocks::PISTON_EXTENSION) {
+             setDead();
+             if (dontSetBlock) {
+                if (Util::instanceof<BlockFalling>(block)) {
+                   ((BlockFalling*)block)->onBroken(world, blockpos1);
+                }
+             } else if (world->mayPlace(block, blockpos1, true, EnumFacing::UP, nullptr) && (flag1 || !BlockFalling::canFallThrough(world->getBlockState(blockpos1.down()))) && world->setBlockState(blockpos1, fallTile, 3)) {
+                if (Util::instanceof<BlockFalling>(block)) {
+                   ((BlockFalling*)block)->onEndFalling(world, blockpos1, fallTile, iblockstate);
+                }
+
+                if (tileEntityData != nullptr && Util::instanceof<ITileEntityProvider>(block)) {
+                   TileEntity tileentity = world->getTileEntity(blockpos1);
+                   if (tileentity != nullptr) {
+                      NBTTagCompound* nbttagcompound = tileentity.writeToNBT(new NBTTagCompound());
+
+                       for(auto s :tileEntityData->getKeySet()){
+                         NBTBase* nbtbase = tileEntityData->getTag(s);
+                         if (!"x" == s && !"y" == s && !"z" == s) {
+                            nbttagcompound->setTag(s, nbtbase.copy());
+                         }
+                      }
+
+                      tileentity.readFromNBT(nbttagcompound);
+                      tileentity.markDirty();
+                   }
+                }
+             } else if (shouldDropItem && world->getGameRules().getBoolean("doEntityDrops")) {
+                entityDropItem(ItemStack(block, 1, block->damageDropped(fallTile)), 0.0F);
+             }
+          }
+       }
+    }
 
-         motionX *= 0.9800000190734863;
-         motionY *= 0.9800000190734863;
-         motionZ *= 0.9800000190734863;
-      }
+    motionX *= 0.9800000190734863;
+    motionY *= 0.9800000190734863;
+    motionZ *= 0.9800000190734863;
 }
 
 void EntityFallingBlock::fall(float distance, float damageMultiplier) {
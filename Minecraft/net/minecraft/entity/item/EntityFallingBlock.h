@@ -10,6 +10,7 @@ public:
     BlockPos getOrigin();
     bool canBeCollidedWith() override;
     void onUpdate() override;
+    void onPhysicsUpdate() override;
     void fall(float distance, float damageMultiplier) override;
     static void registerFixesFallingBlock(DataFixer fixer);
     World* getWorldObj() const;
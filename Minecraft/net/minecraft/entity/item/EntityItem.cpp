@@ -30,6 +30,21 @@ EntityItem::EntityItem(World *worldIn)
     setItem(ItemStack::EMPTY);
 }
 
+void EntityItem::inactiveTick() {
+    Entity::inactiveTick();
+    if (pickupDelay > 0 && pickupDelay != 32767) {
+         --pickupDelay;
+    }
+
+    if (age != -32768) {
+         ++age;
+    }
+
+    if (!world->isRemote && age >= 6000) {
+         setDead();
+    }
+}
+
 void EntityItem::onUpdate() {
     if (getItem().isEmpty()) {
          setDead();
@@ -42,9 +57,9 @@ void EntityItem::onUpdate() {
          prevPosX = posX;
          prevPosY = posY;
          prevPosZ = posZ;
-         double d0 = motionX;
-         double d1 = motionY;
-         double d2 = motionZ;
+         lastMotionX = motionX;
+         lastMotionY = motionY;
+         lastMotionZ = motionZ;
          if (!hasNoGravity()) {
             motionY -= 0.03999999910593033;
          }
@@ -55,52 +70,56 @@ void EntityItem::onUpdate() {
             noClip = pushOutOfBlocks(posX, (getEntityBoundingBox().getminY() + getEntityBoundingBox().getmaxY()) / 2.0, posZ);
          }
 
-         move(MoverType::SELF, motionX, motionY, motionZ);
-         bool flag = (int)prevPosX != (int)posX || (int)prevPosY != (int)posY || (int)prevPosZ != (int)posZ;
-         if (flag || ticksExisted % 25 == 0) {
-            if (world->getBlockState(BlockPos(this))->getMaterial() == Material::LAVA) {
-               motionY = 0.20000000298023224;
-               motionX = (double)((MathHelper::nextFloat(rand) - MathHelper::nextFloat(rand)) * 0.2F);
-               motionZ = (double)((MathHelper::nextFloat(rand) - MathHelper::nextFloat(rand)) * 0.2F);
-               playSound(SoundEvents::ENTITY_GENERIC_BURN, 0.4F, 2.0F + MathHelper::nextFloat(rand) * 0.4F);
-            }
+         // gravity is already applied, pushOutOfBlocks must see it
+         updatePhysics(0.0);
+      }
+}
 
-            if (!world->isRemote) {
-               searchForOtherItemsNearby();
-            }
-         }
+void EntityItem::onPhysicsUpdate() {
+    bool flag = (int)prevPosX != (int)posX || (int)prevPosY != (int)posY || (int)prevPosZ != (int)posZ;
+    if (flag || ticksExisted % 25 == 0) {
+       if (world->getBlockState(BlockPos(this))->getMaterial() == Material::LAVA) {
+          motionY = 0.20000000298023224;
+          motionX = (double)((MathHelper::nextFloat(rand) - MathHelper::nextFloat(rand)) * 0.2F);
+          motionZ = (double)((MathHelper::nextFloat(rand) - MathHelper::nextFloat(rand)) * 0.2F);
+          playSound(SoundEvents::ENTITY_GENERIC_BURN, 0.4F, 2.0F + MathHelper::nextFloat(rand) * 0.4F);
+       }
 
-         float f = 0.98F;
-         if (onGround) {
-            f = world->getBlockState(BlockPos(MathHelper::floor(posX), MathHelper::floor(getEntityBoundingBox().getminY()) - 1, MathHelper::floor(posZ)))->getBlock()->slipperiness * 0.98F;
-         }
+       if (!world->isRemote) {
+          searchForOtherItemsNearby();
+       }
+    }
 
-         motionX *= (double)f;
-         motionY *= 0.9800000190734863;
-         motionZ *= (double)f;
-         if (onGround) {
-            motionY *= -0.5;
-         }
+    float f = 0.98F;
+    if (onGround) {
+       f = world->getBlockState(BlockPos(MathHelper::floor(posX), MathHelper::floor(getEntityBoundingBox().getminY()) - 1, MathHelper::floor(posZ)))->getBlock()->slipperiness * 0.98F;
+    }
 
-         if (age != -32768) {
-            ++age;
-         }
+    motionX *= (double)f;
+    motionY *= 0.9800000190734863;
+    motionZ *= (double)f;
+    if (onGround) {
+       motionY *= -0.5;
+    }
 
-         handleWaterMovement();
-         if (!world->isRemote) {
-            double d3 = motionX - d0;
-            double d4 = motionY - d1;
-            double d5 = motionZ - d2;
-            double d6 = d3 * d3 + d4 * d4 + d5 * d5;
-            if (d6 > 0.01) {
-               isAirBorne = true;
-            }
-         }
+    if (age != -32768) {
+       ++age;
+    }
 
-         if (!world->isRemote && age >= 6000) {
-            setDead();
-         }
-      }
+    handleWaterMovement();
+    if (!world->isRemote) {
+       double d3 = motionX - lastMotionX;
+       double d4 = motionY - lastMotionY;
+       double d5 = motionZ - lastMotionZ;
+       double d6 = d3 * d3 + d4 * d4 + d5 * d5;
+       if (d6 > 0.01) {
+          isAirBorne = true;
+       }
+    }
+
+    if (!world->isRemote && age >= 6000) {
+       setDead();
+    }
 }
 
 void EntityItem::setAgeToCreativeDespawnTime() {
@@ -285,11 +304,7 @@ void EntityItem::dealFireDamage(int32_t amount) {
 }
 
 void EntityItem::searchForOtherItemsNearby() {
-    auto var1 = world->getEntitiesWithinAABB<EntityItem>(getEntityBoundingBox().grow(0.5, 0.0, 0.5));
-
-    for(auto entityitem : var1){
-        combineItems(entityitem);
-    }
+    world->requestItemMerge(this);
 }
 
 bool EntityItem::combineItems(EntityItem *other) {
@@ -8,6 +8,8 @@ public:
     EntityItem(World* worldIn, double x, double y, double z, ItemStack stack);
     explicit EntityItem(World* worldIn);
     void onUpdate() override;
+    void onPhysicsUpdate() override;
+    void inactiveTick() override;
     void setAgeToCreativeDespawnTime();
     bool handleWaterMovement();
     bool attackEntityFrom(DamageSource::DamageSource source, float amount) override;
@@ -32,6 +34,7 @@ public:
     bool cannotPickup() const;
     void setNoDespawn();
     void makeFakeItem();
+    bool combineItems(EntityItem* other);
 
     float hoverStart;
 protected:
@@ -40,12 +43,15 @@ protected:
     void dealFireDamage(int32_t amount) override;
 private:
     void searchForOtherItemsNearby();
-    bool combineItems(EntityItem* other);
 
     static std::shared_ptr<spdlog::logger> LOGGER;
     static DataParameter ITEM;
     int32_t age;
     int32_t pickupDelay;
+    // motion at the start of onUpdate, for the isAirBorne check after the move
+    double lastMotionX = 0.0;
+    double lastMotionY = 0.0;
+    double lastMotionZ = 0.0;
     int32_t health;
     std::string thrower;
     std::string owner;
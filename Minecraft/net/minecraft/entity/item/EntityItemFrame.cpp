@@ -92,6 +92,7 @@ void EntityItemFrame::setDisplayedItem(ItemStack stack) {
 }
 
 void EntityItemFrame::notifyDataManagerChange(DataParameter key) {
+    EntityHanging::notifyDataManagerChange(key);
     if (key == ITEM) {
          ItemStack itemstack = getDisplayedItem();
          if (!itemstack.isEmpty() && itemstack.getItemFrame() != this) {
@@ -138,6 +139,7 @@ void EntityItemFrame::readEntityFromNBT(NBTTagCompound *compound) {
 bool EntityItemFrame::processInitialInteract(EntityPlayer *player, EnumHand hand) {
     ItemStack itemstack = player->getHeldItem(hand);
       if (!world->isRemote) {
+         wakeUp(EntityActivationRange::WAKE_TICKS);
          if (getDisplayedItem().isEmpty()) {
             if (!itemstack.isEmpty()) {
                setDisplayedItem(itemstack);
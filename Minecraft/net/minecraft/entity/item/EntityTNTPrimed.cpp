@@ -32,21 +32,11 @@ void EntityTNTPrimed::onUpdate() {
     prevPosX = posX;
       prevPosY = posY;
       prevPosZ = posZ;
-      if (!hasNoGravity()) {
-         motionY -= 0.03999999910593033;
-      }
-
-      move(MoverType::SELF, motionX, motionY, motionZ);
-      motionX *= 0.9800000190734863;
-      motionY *= 0.9800000190734863;
-      motionZ *= 0.9800000190734863;
-      if (onGround) {
-         motionX *= 0.699999988079071;
-         motionZ *= 0.699999988079071;
-         motionY *= -0.5;
-      }
+      updatePhysics(hasNoGravity() ? 0.0 : 0.03999999910593033, {0.98F, 0.98F, false, 0.699999988079071, -0.5});
+}
 
-      --fuse;
+void EntityTNTPrimed::onPhysicsUpdate() {
+    --fuse;
       if (fuse <= 0) {
          setDead();
          if (!world->isRemote) {
@@ -72,6 +62,7 @@ void EntityTNTPrimed::setFuse(int32_t fuseIn) {
 }
 
 void EntityTNTPrimed::notifyDataManagerChange(DataParameter key) {
+    Entity::notifyDataManagerChange(key);
     if (FUSE == key) {
          fuse = getFuseDataManager();
       }
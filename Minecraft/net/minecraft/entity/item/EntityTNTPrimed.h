@@ -7,6 +7,7 @@ public:
     EntityTNTPrimed(World* worldIn, double x, double y, double z, EntityLivingBase* igniter);
     bool canBeCollidedWith() override;
     void onUpdate() override;
+    void onPhysicsUpdate() override;
     EntityLivingBase* getTntPlacedBy() const;
     float getEyeHeight() const override;
     void setFuse(int32_t fuseIn);
@@ -2,6 +2,8 @@
 
 #include "DamageSource.h"
 
+#include <limits>
+
 EntityXPOrb::EntityXPOrb(World *worldIn, double x, double y, double z, int32_t expValue)
     :Entity(worldIn){
     setSize(0.5F, 0.5F);
@@ -32,6 +34,18 @@ int32_t EntityXPOrb::getBrightnessForRender() {
     return j | k << 16;
 }
 
+void EntityXPOrb::inactiveTick() {
+    Entity::inactiveTick();
+    if (delayBeforeCanPickup > 0) {
+         --delayBeforeCanPickup;
+    }
+
+    ++xpOrbAge;
+    if (xpOrbAge >= 6000) {
+         setDead();
+    }
+}
+
 void EntityXPOrb::onUpdate() {
     Entity::onUpdate();
       if (delayBeforeCanPickup > 0) {
@@ -80,17 +94,13 @@ void EntityXPOrb::onUpdate() {
          }
       }
 
-      move(MoverType::SELF, motionX, motionY, motionZ);
-      float f = 0.98F;
-      if (onGround) {
-         f = world->getBlockState(BlockPos(MathHelper::floor(posX), MathHelper::floor(getEntityBoundingBox().getminY()) - 1, MathHelper::floor(posZ)))->getBlock()->slipperiness * 0.98F;
-      }
+      // gravity is already applied, the lava check and the pull towards the player override it
+      updatePhysics(0.0, {0.98F, 0.98F, true, 1.0, -0.8999999761581421});
+}
 
-      motionX *= (double)f;
-      motionY *= 0.9800000190734863;
-      motionZ *= (double)f;
-      if (onGround) {
-         motionY *= -0.8999999761581421;
+void EntityXPOrb::onPhysicsUpdate() {
+      if (!world->isRemote && ((int)prevPosX != (int)posX || (int)prevPosY != (int)posY || (int)prevPosZ != (int)posZ || ticksExisted % 25 == 0)) {
+         world->requestItemMerge(this);
       }
 
       ++xpColor;
@@ -209,6 +219,23 @@ int32_t EntityXPOrb::getXPSplit(int32_t expValue) {
       }
 }
 
+bool EntityXPOrb::combineOrbs(EntityXPOrb *other) {
+    if (other == this || !other->isEntityAlive() || !isEntityAlive()) {
+         return false;
+      } else if (other->xpValue < xpValue) {
+         return other->combineOrbs(this);
+      } else if (other->xpValue + xpValue > getXPSplit(std::numeric_limits<int32_t>::max())) {
+         // stay within the values a split can produce
+         return false;
+      } else {
+         other->xpValue += xpValue;
+         other->delayBeforeCanPickup = MathHelper::max(other->delayBeforeCanPickup, delayBeforeCanPickup);
+         other->xpOrbAge = MathHelper::min(other->xpOrbAge, xpOrbAge);
+         setDead();
+         return true;
+      }
+}
+
 bool EntityXPOrb::canBeAttackedWithItem() {
     return false;
 }
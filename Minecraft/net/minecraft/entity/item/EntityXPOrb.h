@@ -7,6 +7,8 @@ public:
     explicit EntityXPOrb(World* worldIn);
     int32_t getBrightnessForRender() override;
     void onUpdate() override;
+    void onPhysicsUpdate() override;
+    void inactiveTick() override;
     bool handleWaterMovement();
     bool attackEntityFrom(DamageSource::DamageSource source, float amount) override;
     void writeEntityToNBT(NBTTagCompound* compound) override;
@@ -16,6 +18,7 @@ public:
     int32_t getTextureByXP() const;
     static int32_t getXPSplit(int32_t expValue);
     bool canBeAttackedWithItem() override;
+    bool combineOrbs(EntityXPOrb* other);
 
     int32_t xpColor;
     int32_t xpOrbAge;
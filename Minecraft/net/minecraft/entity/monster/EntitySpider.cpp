@@ -122,7 +122,7 @@ void EntitySpider::setBesideClimbableBlock(bool climbing) {
 
 IEntityLivingData * EntitySpider::onInitialSpawn(DifficultyInstance difficulty, IEntityLivingData *livingdata) {
     IEntityLivingData* livingdata = EntityMob::onInitialSpawn(difficulty, livingdata);
-      if (world->rand(100) == 0) {
+      if (world->getRandom()(100) == 0) {
          EntitySkeleton* entityskeleton = new EntitySkeleton(world);
          entityskeleton->setLocationAndAngles(posX, posY, posZ, rotationYaw, 0.0F);
          entityskeleton->onInitialSpawn(difficulty, nullptr);
@@ -132,8 +132,8 @@ IEntityLivingData * EntitySpider::onInitialSpawn(DifficultyInstance difficulty,
 
       if (livingdata == nullptr) {
          livingdata = new EntitySpider::GroupData();
-         if (world->getDifficulty() == EnumDifficulty::HARD && MathHelper::nextFloat(world->rand) < 0.1F * difficulty.getClampedAdditionalDifficulty()) {
-            ((EntitySpider::GroupData)livingdata).setRandomEffect(world->rand);
+         if (world->getDifficulty() == EnumDifficulty::HARD && MathHelper::nextFloat(world->getRandom()) < 0.1F * difficulty.getClampedAdditionalDifficulty()) {
+            ((EntitySpider::GroupData)livingdata).setRandomEffect(world->getRandom());
          }
       }
 
@@ -1629,7 +1629,7 @@ void EntityPlayer::damageShield(float damage) {
             }
 
             activeItemStack = ItemStack::EMPTY;
-            playSound(SoundEvents::ITEM_SHIELD_BREAK, 0.8F, 0.8F + MathHelper::nextFloat(world->rand) * 0.4F);
+            playSound(SoundEvents::ITEM_SHIELD_BREAK, 0.8F, 0.8F + MathHelper::nextFloat(world->getRandom()) * 0.4F);
          }
       }
 }
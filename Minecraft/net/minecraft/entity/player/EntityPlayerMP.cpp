@@ -10,6 +10,7 @@
 #include "../../inventory/ContainerHorseInventory.h"
 #include "../../inventory/ContainerMerchant.h"
 #include "../../inventory/SlotCrafting.h"
+#include "../../item/ItemMap.h"
 #include "../../item/ItemMapBase.h"
 #include "../../item/crafting/CraftingManager.h"
 #include "../../scoreboard/IScoreCriteria.h"
@@ -191,6 +192,7 @@ void EntityPlayerMP::onUpdate() {
       }
 
       advancements.flushDirty(this);
+      statsFile.pollStatFile();
 }
 
 void EntityPlayerMP::onUpdateEntity() {
@@ -585,6 +587,13 @@ void EntityPlayerMP::sendContainerToPlayer(Container *containerIn) {
 }
 
 void EntityPlayerMP::sendAllContents(Container *containerToSend, std::vector<ItemStack> itemsList) {
+    // start reading map files in the background before the first inventory tick asks for them
+    for(auto& itemstack : itemsList) {
+        if (Util::instanceof<ItemMap>(itemstack.getItem())) {
+            ItemMap::prefetchMapData(itemstack, world);
+        }
+    }
+
     connection.sendPacket(new SPacketWindowItems(containerToSend->windowId, itemsList));
     connection.sendPacket(new SPacketSetSlot(-1, -1, inventory.getItemStack()));
 }
@@ -284,7 +284,7 @@ bool ContainerEnchantment::enchantItem(EntityPlayer *playerIn, int32_t id)
                 tableInventory->markDirty();
                 xpSeed = playerIn->getXPSeed();
                 onCraftMatrixChanged(tableInventory);
-                world->playSound(nullptr, position, SoundEvents::BLOCK_ENCHANTMENT_TABLE_USE, SoundCategory::BLOCKS, 1.0F, world->rand.nextFloat() * 0.1F + 0.9F);
+                world->playSound(nullptr, position, SoundEvents::BLOCK_ENCHANTMENT_TABLE_USE, SoundCategory::BLOCKS, 1.0F, world->getRandom().nextFloat() * 0.1F + 0.9F);
             }
         }
 
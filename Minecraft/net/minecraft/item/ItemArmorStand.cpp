@@ -56,7 +56,7 @@ EnumActionResult ItemArmorStand::onItemUse(EntityPlayer *player, World *worldIn,
                         EntityArmorStand entityarmorstand = EntityArmorStand(worldIn, d0 + 0.5, d1, d2 + 0.5);
                         float f = (float)MathHelper::floor((MathHelper::wrapDegrees(player->rotationYaw - 180.0F) + 22.5F) / 45.0F) * 45.0F;
                         entityarmorstand.setLocationAndAngles(d0 + 0.5, d1, d2 + 0.5, f, 0.0F);
-                        applyRandomRotations(entityarmorstand, worldIn->rand);
+                        applyRandomRotations(entityarmorstand, worldIn->getRandom());
                         ItemMonsterPlacer::applyItemEntityDataToEntity(worldIn, player, itemstack, entityarmorstand);
                         worldIn->spawnEntity(entityarmorstand);
                         worldIn->playSound(nullptr, entityarmorstand.posX, entityarmorstand.posY, entityarmorstand.posZ, SoundEvents::ENTITY_ARMORSTAND_PLACE, SoundCategory::BLOCKS, 0.75F, 0.8F);
@@ -117,7 +117,7 @@ bool ItemBucket::tryPlaceContainedLiquid(EntityPlayer *player, World *worldIn, B
                 auto l = posIn.getx();
                 auto i = posIn.gety();
                 auto j = posIn.getz();
-                worldIn->playSound(player, posIn, SoundEvents::BLOCK_FIRE_EXTINGUISH, SoundCategory::BLOCKS, 0.5F, 2.6F + (MathHelper::nextFloat(worldIn->rand) - MathHelper::nextFloat(worldIn->rand)) * 0.8F);
+                worldIn->playSound(player, posIn, SoundEvents::BLOCK_FIRE_EXTINGUISH, SoundCategory::BLOCKS, 0.5F, 2.6F + (MathHelper::nextFloat(worldIn->getRandom()) - MathHelper::nextFloat(worldIn->getRandom())) * 0.8F);
 
                 for(int k = 0; k < 8; ++k) 
                 {
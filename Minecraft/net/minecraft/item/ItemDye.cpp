@@ -87,9 +87,9 @@ bool ItemDye::applyBonemeal(ItemStack stack, World *worldIn, BlockPos target)
         {
             if (!worldIn->isRemote) 
             {
-                if (igrowable->canUseBonemeal(worldIn, worldIn->rand, target, iblockstate)) 
+                if (igrowable->canUseBonemeal(worldIn, worldIn->getRandom(), target, iblockstate)) 
                 {
-                    igrowable->grow(worldIn, worldIn->rand, target, iblockstate);
+                    igrowable->grow(worldIn, worldIn->getRandom(), target, iblockstate);
                 }
 
                 stack.shrink(1);
@@ -25,7 +25,7 @@ ItemStack ItemFood::onItemUseFinish(ItemStack stack, World *worldIn, EntityLivin
     {
         EntityPlayer* entityplayer = (EntityPlayer*)entityLiving;
         entityplayer->getFoodStats().addStats(this, stack);
-        worldIn->playSound(nullptr, entityplayer->posX, entityplayer->posY, entityplayer->posZ, SoundEvents::ENTITY_PLAYER_BURP, SoundCategory::PLAYERS, 0.5F, worldIn->rand.nextFloat() * 0.1F + 0.9F);
+        worldIn->playSound(nullptr, entityplayer->posX, entityplayer->posY, entityplayer->posZ, SoundEvents::ENTITY_PLAYER_BURP, SoundCategory::PLAYERS, 0.5F, worldIn->getRandom().nextFloat() * 0.1F + 0.9F);
         onFoodEaten(stack, worldIn, entityplayer);
         entityplayer->addStat(StatList::getObjectUseStats(this));
         if (Util::instanceof< EntityPlayerMP>(entityplayer)) 
@@ -92,7 +92,7 @@ ItemFood* ItemFood::setAlwaysEdible()
 
 void ItemFood::onFoodEaten(ItemStack stack, World *worldIn, EntityPlayer *player) const
 {
-    if (!worldIn->isRemote && potionId != nullptr && worldIn->rand.nextFloat() < potionEffectProbability) 
+    if (!worldIn->isRemote && potionId != nullptr && worldIn->getRandom().nextFloat() < potionEffectProbability) 
     {
         player->addPotionEffect(PotionEffect(potionId));
     }
@@ -31,6 +31,14 @@ MapData ItemMap::loadMapData(int32_t mapId, World *worldIn)
     return worldIn->loadData<MapData>(s);
 }
 
+void ItemMap::prefetchMapData(ItemStack stack, World *worldIn)
+{
+    if (!worldIn->isRemote)
+    {
+        worldIn->getMapStorage()->prefetchData("map_" + std::to_string(stack.getMetadata()));
+    }
+}
+
 MapData ItemMap::getMapData(ItemStack stack, World *worldIn)
 {
     auto s = "map_" + stack.getMetadata();
@@ -8,6 +8,7 @@ public:
     static ItemStack setupNewMap(World* worldIn, double worldX, double worldZ, uint8_t scale, bool trackingPosition, bool unlimitedTracking);
     static MapData loadMapData(int32_t mapId, World* worldIn);
     MapData getMapData(ItemStack stack, World* worldIn);
+    static void prefetchMapData(ItemStack stack, World* worldIn);
     void updateMapData(World* worldIn, Entity* viewer, MapData data);
     static void renderBiomePreviewMap(World* worldIn, ItemStack map);
     void onUpdate(ItemStack stack, World* worldIn, Entity* entityIn, int32_t itemSlot, bool isSelected) override;
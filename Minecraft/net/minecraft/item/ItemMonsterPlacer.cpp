@@ -167,7 +167,7 @@ Entity * ItemMonsterPlacer::spawnCreature(World *worldIn, ResourceLocation entit
             if (Util::instanceof<EntityLiving>(entity)) 
             {
                 EntityLiving* entityliving = (EntityLiving*)entity;
-                entity->setLocationAndAngles(x, y, z, MathHelper::wrapDegrees(MathHelper::nextFloat(worldIn->rand) * 360.0F), 0.0F);
+                entity->setLocationAndAngles(x, y, z, MathHelper::wrapDegrees(MathHelper::nextFloat(worldIn->getRandom()) * 360.0F), 0.0F);
                 entityliving->rotationYawHead = entityliving->rotationYaw;
                 entityliving->renderYawOffset = entityliving->rotationYaw;
                 entityliving->onInitialSpawn(worldIn->getDifficultyForLocation(BlockPos(entityliving)), nullptr);
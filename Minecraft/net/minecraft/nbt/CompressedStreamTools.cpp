@@ -1,5 +1,10 @@
 #include "CompressedStreamTools.h"
+#include <algorithm>
+#include <atomic>
+#include <sstream>
 #include "gzstream.h"
+#include "ParallelDeflate.h"
+#include "WorkerPool.h"
 #include "../util/ReportedException.h"
 #include "NBTBase.h"
 #include "NBTSizeTracker.h"
@@ -8,6 +13,53 @@
 
 namespace CompressedStreamTools
 {
+	std::atomic<int32_t> compressionLevel = DEFAULT_COMPRESSION_LEVEL;
+	std::atomic<size_t> parallelThreshold = DEFAULT_PARALLEL_THRESHOLD;
+
+	void setCompressionLevel(int32_t level)
+	{
+		compressionLevel = std::clamp(level, Z_NO_COMPRESSION, Z_BEST_COMPRESSION);
+	}
+
+	int32_t getCompressionLevel()
+	{
+		return compressionLevel;
+	}
+
+	void setParallelThreshold(size_t threshold)
+	{
+		parallelThreshold = threshold;
+	}
+
+	size_t getParallelThreshold()
+	{
+		return parallelThreshold;
+	}
+
+	WorkerPool* getCompressionPool()
+	{
+		static WorkerPool pool("Compression Worker");
+		return &pool;
+	}
+
+	std::string serialize(NBTTagCompound* compound)
+	{
+		std::ostringstream rawstream(std::ios::binary);
+		CompressedStreamTools::write(compound, rawstream);
+		return rawstream.str();
+	}
+
+	std::string compress(NBTTagCompound* compound)
+	{
+		auto raw = serialize(compound);
+		if (raw.size() < parallelThreshold)
+		{
+			return ParallelDeflate::compress(raw, compressionLevel);
+		}
+
+		return ParallelDeflate::compress(raw, compressionLevel, getCompressionPool());
+	}
+
 	void writeTag(NBTBase* tag, std::ostream &output)
 	{
 		auto id = tag->getId();
@@ -48,6 +100,12 @@ namespace CompressedStreamTools
 		}
 	}
 
+	std::unique_ptr<NBTTagCompound> decompress(std::string_view compressed)
+	{
+		std::istringstream rawstream(ParallelDeflate::decompress(compressed), std::ios::binary);
+		return CompressedStreamTools::read(rawstream, NBTSizeTracker::Infinite.get());
+	}
+
 	std::unique_ptr<NBTTagCompound> readCompressed(std::istream& is)
 	{
 		std::shared_ptr<gzstreambuf> buf = std::make_shared<gzstreambuf>();
@@ -60,10 +118,8 @@ namespace CompressedStreamTools
 
 	void writeCompressed(NBTTagCompound* compound, std::ostream &outputStream)
 	{
-		std::shared_ptr<gzstreambuf> buf = std::make_shared<gzstreambuf>();
-		outputStream.rdbuf(buf.get());
-		CompressedStreamTools::write(compound, outputStream);
-
+		auto compressed = compress(compound);
+		outputStream.write(compressed.data(), compressed.size());
 	}
 
 	void safeWrite(NBTTagCompound* compound, std::filesystem::path fileIn)
@@ -2,8 +2,23 @@
 #include <filesystem>
 #include "NBTTagCompound.h"
 
+class WorkerPool;
+
 namespace CompressedStreamTools
 {
+	constexpr int32_t DEFAULT_COMPRESSION_LEVEL = 6;
+	constexpr size_t DEFAULT_PARALLEL_THRESHOLD = 256 * 1024;
+
+	void setCompressionLevel(int32_t level);
+	int32_t getCompressionLevel();
+	void setParallelThreshold(size_t threshold);
+	size_t getParallelThreshold();
+	WorkerPool* getCompressionPool();
+	std::string serialize(NBTTagCompound* compound);
+	// Fans payloads above the parallel threshold out over the compression pool and waits for them, so it must
+	// not be called from a task already running on that pool.
+	std::string compress(NBTTagCompound* compound);
+	std::unique_ptr<NBTTagCompound> decompress(std::string_view compressed);
 	std::unique_ptr<NBTTagCompound> readCompressed(std::istream &is);
 	void writeCompressed(NBTTagCompound* compound, std::ostream &outputStream);
 	void safeWrite(NBTTagCompound* compound, std::filesystem::path fileIn);
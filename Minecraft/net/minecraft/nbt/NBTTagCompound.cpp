@@ -1,6 +1,7 @@
 #include "NBTTagCompound.h"
 #include "../../../../compile-time-regular-expressions/single-header/ctre.hpp"
 #include "../util/ReportedException.h"
+#include "../util/Util.h"
 #include "NBTSizeTracker.h"
 #include "NBTTagByteArray.h"
 #include "NBTTagDouble.h"
@@ -16,7 +17,7 @@
 
 
 static constexpr auto SIMPLE_VALUE = ctll::fixed_string{ R"([A-Za-z0-9._+-]+)"};
-std::shared_ptr<spdlog::logger> NBTTagCompound::LOGGER = spdlog::get("Minecraft")->clone("NBTTagCompound");
+std::shared_ptr<spdlog::logger> NBTTagCompound::LOGGER = Util::getLogger("NBTTagCompound");
 
 void NBTTagCompound::write(std::ostream &output) const
 {
@@ -3,10 +3,11 @@
 #include "spdlog/spdlog.h"
 #include "crossguid/guid.hpp"
 #include "../util/ResourceLocation.h"
+#include "../util/Util.h"
 #include "../block/Block.h"
 #include "../block/state/BlockStateContainer.h"
 
-std::shared_ptr<spdlog::logger> LOGGER = spdlog::get("Minecraft")->clone("NBTUtil");
+std::shared_ptr<spdlog::logger> LOGGER = Util::getLogger("NBTUtil");
 
 std::optional<GameProfile> NBTUtil::readGameProfileFromNBT(NBTTagCompound compound)
 {
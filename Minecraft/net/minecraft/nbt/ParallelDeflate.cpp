@@ -0,0 +1,188 @@
+#include "ParallelDeflate.h"
+#include <array>
+#include <exception>
+#include <future>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+#include <zlib.h>
+#include "WorkerPool.h"
+
+namespace ParallelDeflate
+{
+	struct Block
+	{
+		std::string data;
+		uint32_t crc = 0;
+		size_t length = 0;
+	};
+
+	// zlib counts in uInt, a single call cannot take more than that
+	uInt toUInt(size_t value)
+	{
+		if (value > std::numeric_limits<uInt>::max())
+		{
+			throw std::length_error("Buffer too large for zlib");
+		}
+
+		return static_cast<uInt>(value);
+	}
+
+	Block deflateBlock(std::string_view raw, size_t offset, size_t length, int32_t level, bool last)
+	{
+		z_stream stream{};
+		if (deflateInit2(&stream, level, Z_DEFLATED, -MAX_WBITS, 8, Z_DEFAULT_STRATEGY) != Z_OK)
+		{
+			throw std::runtime_error("Failed to initialise deflater");
+		}
+
+		if (offset > 0)
+		{
+			auto dictionaryLength = std::min(offset, DICTIONARY_SIZE);
+			deflateSetDictionary(&stream, reinterpret_cast<const Bytef*>(raw.data() + offset - dictionaryLength), toUInt(dictionaryLength));
+		}
+
+		Block block;
+		block.length = length;
+		block.crc = static_cast<uint32_t>(crc32(0L, reinterpret_cast<const Bytef*>(raw.data() + offset), toUInt(length)));
+		block.data.resize(deflateBound(&stream, toUInt(length)) + 16);
+
+		stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(raw.data() + offset));
+		stream.avail_in = toUInt(length);
+		stream.next_out = reinterpret_cast<Bytef*>(block.data.data());
+		stream.avail_out = toUInt(block.data.size());
+
+		// sync flush leaves the block byte aligned so the next block's output can simply be appended
+		auto result = deflate(&stream, last ? Z_FINISH : Z_SYNC_FLUSH);
+		block.data.resize(stream.total_out);
+		deflateEnd(&stream);
+		if (result != (last ? Z_STREAM_END : Z_OK))
+		{
+			throw std::runtime_error("Failed to deflate block");
+		}
+
+		return block;
+	}
+
+	void writeIntLE(std::string& out, uint32_t value)
+	{
+		for (auto i = 0; i < 4; ++i)
+		{
+			out.push_back(static_cast<char>((value >> (8 * i)) & 0xFF));
+		}
+	}
+
+	std::string compress(std::string_view raw, int32_t level, WorkerPool* pool, size_t blockSize)
+	{
+		auto blockCount = std::max<size_t>(1, (raw.size() + blockSize - 1) / blockSize);
+		std::vector<Block> blocks(blockCount);
+
+		if (pool == nullptr || blockCount == 1)
+		{
+			for (size_t i = 0; i < blockCount; ++i)
+			{
+				auto offset = i * blockSize;
+				blocks[i] = deflateBlock(raw, offset, std::min(blockSize, raw.size() - offset), level, i + 1 == blockCount);
+			}
+		}
+		else
+		{
+			std::vector<std::future<Block>> pending;
+			pending.reserve(blockCount);
+			for (size_t i = 0; i < blockCount; ++i)
+			{
+				auto offset = i * blockSize;
+				auto length = std::min(blockSize, raw.size() - offset);
+				auto last = i + 1 == blockCount;
+				pending.emplace_back(pool->submit([raw, offset, length, level, last]()
+				{
+					return deflateBlock(raw, offset, length, level, last);
+				}));
+			}
+
+			// every task reads straight out of raw, so all of them have to be joined before an error
+			// can leave this frame and let the caller release the buffer
+			std::exception_ptr error;
+			for (size_t i = 0; i < blockCount; ++i)
+			{
+				try
+				{
+					blocks[i] = pending[i].get();
+				}
+				catch (...)
+				{
+					if (!error)
+					{
+						error = std::current_exception();
+					}
+				}
+			}
+
+			if (error)
+			{
+				std::rethrow_exception(error);
+			}
+		}
+
+		size_t compressedSize = 18;
+		for (auto& block : blocks)
+		{
+			compressedSize += block.data.size();
+		}
+
+		std::string out;
+		out.reserve(compressedSize);
+		static constexpr char HEADER[] = { '\x1f', '\x8b', '\x08', '\x00', '\x00', '\x00', '\x00', '\x00', '\x00', '\xff' };
+		out.append(HEADER, sizeof(HEADER));
+
+		uLong crc = crc32(0L, Z_NULL, 0);
+		for (auto& block : blocks)
+		{
+			out.append(block.data);
+			crc = crc32_combine(crc, block.crc, static_cast<z_off_t>(block.length));
+		}
+
+		writeIntLE(out, static_cast<uint32_t>(crc));
+		writeIntLE(out, static_cast<uint32_t>(raw.size()));
+		return out;
+	}
+
+	std::string compress(std::string_view raw, int32_t level)
+	{
+		return compress(raw, level, nullptr, std::max<size_t>(raw.size(), 1));
+	}
+
+	std::string decompress(std::string_view compressed)
+	{
+		z_stream stream{};
+		if (inflateInit2(&stream, 16 + MAX_WBITS) != Z_OK)
+		{
+			throw std::runtime_error("Failed to initialise inflater");
+		}
+
+		std::string body;
+		std::array<char, 64 * 1024> buffer;
+		stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(compressed.data()));
+		stream.avail_in = toUInt(compressed.size());
+		auto result = Z_OK;
+		while (result == Z_OK)
+		{
+			stream.next_out = reinterpret_cast<Bytef*>(buffer.data());
+			stream.avail_out = static_cast<uInt>(buffer.size());
+			result = inflate(&stream, Z_NO_FLUSH);
+			body.append(buffer.data(), buffer.size() - stream.avail_out);
+			if (result == Z_OK && stream.avail_in == 0 && stream.avail_out != 0)
+			{
+				result = Z_DATA_ERROR;
+			}
+		}
+
+		inflateEnd(&stream);
+		if (result != Z_STREAM_END)
+		{
+			throw std::runtime_error("Corrupt gzip data");
+		}
+
+		return body;
+	}
+}
@@ -0,0 +1,19 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+class WorkerPool;
+
+// pigz-style gzip writer: the input is cut into fixed size blocks which are deflated independently
+// (each primed with the last 32 KiB of its predecessor as dictionary) and concatenated into a single
+// gzip member that any inflater, including gzstream, reads back.
+namespace ParallelDeflate
+{
+	constexpr size_t DEFAULT_BLOCK_SIZE = 128 * 1024;
+	constexpr size_t DICTIONARY_SIZE = 32 * 1024;
+
+	std::string compress(std::string_view raw, int32_t level, WorkerPool* pool, size_t blockSize = DEFAULT_BLOCK_SIZE);
+	std::string compress(std::string_view raw, int32_t level);
+	std::string decompress(std::string_view compressed);
+}
@@ -28,6 +28,7 @@ StatBase& StatBase::registerStat()
 	}
 	else 
 	{
+		ordinal = static_cast<int32_t>(StatList::ALL_STATS.size());
 		StatList::ALL_STATS.add(this);
 		StatList::ID_TO_STAT_MAP.put(statId, this);
 		return *this;
@@ -63,3 +64,8 @@ Class* StatBase::getSerializableClazz()
 {
 	return serializableClazz;
 }
+
+int32_t StatBase::getOrdinal() const
+{
+	return ordinal;
+}
@@ -17,6 +17,7 @@ public:
 	std::string toString();
 	IScoreCriteria* getCriteria();
 	Class* getSerializableClazz();
+	int32_t getOrdinal() const;
 	
 	static IStatType* timeStatType;
 	static IStatType* distanceStatType;
@@ -31,6 +32,7 @@ private:
 	IStatType* formatter;
 	IScoreCriteria* objectiveCriteria;
 	Class serializableClazz;
+	int32_t ordinal = -1;
 	static NumberFormat numberFormat;
 	static DecimalFormat decimalFormat;
 
@@ -2,6 +2,9 @@
 
 #include "Block.h"
 
+std::vector<StatBase*> StatList::ALL_STATS;
+std::unordered_map<std::string, StatBase*> StatList::ID_TO_STAT_MAP;
+
 StatBase StatList::LEAVE_GAME = StatBasic("stat.leaveGame", TextComponentTranslation("stat.leaveGame", new Object[0]))).initIndependentStat().registerStat();
 StatBase StatList::PLAY_ONE_MINUTE;
 StatBase StatList::TIME_SINCE_DEATH;
@@ -90,3 +93,14 @@ void StatList::init()
 	initCraftableStats();
 	initPickedUpAndDroppedStats();
 }
+
+StatBase* StatList::getOneShotStat(std::string_view statName)
+{
+	auto ite = ID_TO_STAT_MAP.find(std::string(statName));
+	return ite == ID_TO_STAT_MAP.end() ? nullptr : ite->second;
+}
+
+StatBase* StatList::getStatByOrdinal(int32_t ordinal)
+{
+	return ordinal >= 0 && ordinal < static_cast<int32_t>(ALL_STATS.size()) ? ALL_STATS[ordinal] : nullptr;
+}
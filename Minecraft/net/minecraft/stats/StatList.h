@@ -71,8 +71,10 @@ public:
 	StatBase* getObjectsPickedUpStats(Item* itemIn);
 	StatBase* getDroppedObjectStats(Item* itemIn);
 	void init();
+	static StatBase* getOneShotStat(std::string_view statName);
+	static StatBase* getStatByOrdinal(int32_t ordinal);
 protected:
-	static std::unordered_map<> ID_TO_STAT_MAP;
+	static std::unordered_map<std::string, StatBase*> ID_TO_STAT_MAP;
 private:	
 	static std::vector<StatBase*> BLOCKS_STATS;
 	static std::vector<StatBase*> CRAFTS_STATS;
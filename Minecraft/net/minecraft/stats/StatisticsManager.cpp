@@ -1,25 +1,24 @@
 #include "StatisticsManager.h"
 #include "StatBase.h"
 
-void StatisticsManager::increaseStat(EntityPlayer* player, StatBase stat, int32_t amount)
+void StatisticsManager::increaseStat(EntityPlayer* player, StatBase* stat, int32_t amount)
 {
 	unlockAchievement(player, stat, readStat(stat) + amount);
 }
 
-void StatisticsManager::unlockAchievement(EntityPlayer* playerIn, StatBase statIn, int32_t p_150873_3_)
+void StatisticsManager::unlockAchievement(EntityPlayer* playerIn, StatBase* statIn, int32_t p_150873_3_)
 {
-	TupleIntJsonSerializable tupleintjsonserializable = (TupleIntJsonSerializable)this.statsData.get(statIn);
-	if (tupleintjsonserializable == nullptr) 
+	auto ordinal = static_cast<size_t>(statIn->getOrdinal());
+	if (ordinal >= statsData.size()) 
 	{
-		tupleintjsonserializable = new TupleIntJsonSerializable();
-		statsData.put(statIn, tupleintjsonserializable);
+		statsData.resize(ordinal + 1);
 	}
 
-	tupleintjsonserializable.setIntegerValue(p_150873_3_);
+	statsData[ordinal] = p_150873_3_;
 }
 
-int32_t StatisticsManager::readStat(StatBase stat)
+int32_t StatisticsManager::readStat(StatBase* stat) const
 {
-	TupleIntJsonSerializable tupleintjsonserializable = (TupleIntJsonSerializable)statsData.get(stat);
-      return tupleintjsonserializable == nullptr ? 0 : tupleintjsonserializable.getIntegerValue();
+	auto ordinal = static_cast<size_t>(stat->getOrdinal());
+	return ordinal < statsData.size() ? statsData[ordinal] : 0;
 }
@@ -1,5 +1,6 @@
 #pragma once
-#include <unordered_map>
+#include <cstdint>
+#include <vector>
 
 class EntityPlayer;
 class StatBase;
@@ -7,9 +8,10 @@ class StatBase;
 class StatisticsManager
 {
 protected:
-	std::unordered_map<StatBase,TupleIntJsonSerializable> statsData;
+	// counters indexed by StatBase::getOrdinal(), grown on first write
+	std::vector<int32_t> statsData;
 public:
-	void increaseStat(EntityPlayer* player, StatBase stat, int32_t amount);
-	virtual void unlockAchievement(EntityPlayer* playerIn, StatBase statIn, int32_t p_150873_3_);
-	int32_t readStat(StatBase stat);
+	void increaseStat(EntityPlayer* player, StatBase* stat, int32_t amount);
+	virtual void unlockAchievement(EntityPlayer* playerIn, StatBase* statIn, int32_t p_150873_3_);
+	int32_t readStat(StatBase* stat) const;
 };
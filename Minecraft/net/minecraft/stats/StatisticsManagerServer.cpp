@@ -1,80 +1,347 @@
 #include "StatisticsManagerServer.h"
 #include "spdlog/spdlog-inl.h"
 #include "BlockAnvil.h"
-#include <fstream>
 #include "StatBase.h"
+#include "StatList.h"
+#include "AsyncFileIO.h"
+#include "../util/Util.h"
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+#include <unordered_map>
+
+std::shared_ptr<spdlog::logger> StatisticsManagerServer::LOGGER = Util::getLogger("StatisticsManagerServer");
+
+namespace
+{
+	void writeVarInt(std::string& out, uint32_t value)
+	{
+		while (value >= 0x80)
+		{
+			out.push_back(static_cast<char>((value & 0x7F) | 0x80));
+			value >>= 7;
+		}
+
+		out.push_back(static_cast<char>(value));
+	}
+
+	std::optional<uint32_t> readVarInt(std::string_view data, size_t& offset)
+	{
+		uint32_t value = 0;
+		for (auto shift = 0; shift < 35 && offset < data.size(); shift += 7)
+		{
+			auto b = static_cast<uint8_t>(data[offset++]);
+			value |= static_cast<uint32_t>(b & 0x7F) << shift;
+			if ((b & 0x80) == 0)
+			{
+				return value;
+			}
+		}
 
-std::shared_ptr<spdlog::logger> StatisticsManagerServer::LOGGER = spdlog::get("Minecraft")->clone("StatisticsManagerServer");
+		return std::nullopt;
+	}
+}
 
 StatisticsManagerServer::StatisticsManagerServer(MinecraftServer* serverIn, std::string_view statsFileIn)
-	:server(serverIn),statsFile(statsFileIn)
+	:server(serverIn),statsFile(statsFileIn),binaryStatsFile(std::filesystem::path(statsFileIn).replace_extension(".dat"))
 {
 }
 
 void StatisticsManagerServer::readStatFile()
 {
-   if (std::filesystem::is_regular_file(statsFile))
+   // goes through the I/O workers so a save still queued for this file is seen; decoding happens there too
+   pendingRead = AsyncFileIO::getInstance()->read(binaryStatsFile, [binaryFile = binaryStatsFile, jsonFile = statsFile](std::optional<std::string> contents)
+   {
+      return loadStats(binaryFile, jsonFile, std::move(contents));
+   }).share();
+}
+
+bool StatisticsManagerServer::pollStatFile()
+{
+   if (!pendingRead.valid())
+   {
+      return true;
+   }
+
+   if (pendingRead.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
    {
-      try 
+      return false;
+   }
+
+   try
+   {
+      auto loaded = pendingRead.get();
+      if (loaded)
       {
-         statsData.clear();
-         std::ifstream file(statsFile);
-         statsData.put(parseJson(FileUtils.readFileToString(statsFile)));
+         // counters awarded while the file was in flight started from zero, so they add onto the loaded ones
+         if (statsData.size() < loaded->stats.size())
+         {
+            statsData.resize(loaded->stats.size());
+         }
+
+         for (size_t ordinal = 0; ordinal < loaded->stats.size(); ++ordinal)
+         {
+            statsData[ordinal] += loaded->stats[ordinal];
+         }
+
+         hasUnsavedChanges = hasUnsavedChanges || loaded->imported;
       }
-      catch (IOException var2) 
-      {
-         LOGGER->error("Couldn't read statistics file {}", statsFile, var2);
-      } catch (JsonParseException var3) 
+   }
+   catch (std::exception& e)
+   {
+      LOGGER->error("Couldn't read statistics file {}: {}", binaryStatsFile.string(), e.what());
+   }
+
+   pendingRead = {};
+   return true;
+}
+
+std::optional<StatisticsManagerServer::LoadedStats> StatisticsManagerServer::loadStats(const std::filesystem::path& binaryFile, const std::filesystem::path& jsonFile, std::optional<std::string> contents)
+{
+   if (contents)
+   {
+      auto stats = decodeStats(*contents);
+      if (stats)
       {
-         LOGGER->error("Couldn't parse statistics file {}", statsFile, var3);
+         return LoadedStats{std::move(*stats), false};
       }
+
+      LOGGER->error("Couldn't parse statistics file {}", binaryFile.string());
+   }
+
+   // the legacy json file is never written any more, so it can be read directly on this worker
+   std::ifstream input(jsonFile);
+   if (!input)
+   {
+      return std::nullopt;
+   }
+
+   std::string json((std::istreambuf_iterator<char>(input)), std::istreambuf_iterator<char>());
+   try
+   {
+      return LoadedStats{parseJson(json), true};
+   }
+   catch (nlohmann::json::exception& e)
+   {
+      LOGGER->error("Couldn't parse statistics file {}: {}", jsonFile.string(), e.what());
+      return std::nullopt;
    }
 }
 
 void StatisticsManagerServer::saveStatFile()
+{
+   // a save before the file has been applied would overwrite it with only this session's counters
+   if (!pollStatFile() || !hasUnsavedChanges)
+   {
+      return;
+   }
+
+   // one small buffer per save; the counters are copied so the tick thread can keep writing
+   hasUnsavedChanges = false;
+   AsyncFileIO::getInstance()->write(binaryStatsFile, [snapshot = statsData]()
+   {
+      return encodeStats(snapshot);
+   });
+}
+
+void StatisticsManagerServer::unlockAchievement(EntityPlayer* playerIn, StatBase* statIn, int32_t p_150873_3_)
+{
+   StatisticsManager::unlockAchievement(playerIn, statIn, p_150873_3_);
+   auto ordinal = static_cast<size_t>(statIn->getOrdinal());
+   if (ordinal >= dirty.size())
+   {
+      dirty.resize(ordinal + 1);
+   }
+
+   dirty.set(ordinal);
+   hasUnsavedChanges = true;
+}
+
+std::vector<StatBase*> StatisticsManagerServer::getDirty()
+{
+   std::vector<StatBase*> stats;
+   for (auto ordinal = dirty.find_first(); ordinal != dirty.npos; ordinal = dirty.find_next(ordinal))
+   {
+      stats.emplace_back(StatList::getStatByOrdinal(static_cast<int32_t>(ordinal)));
+   }
+
+   dirty.reset();
+   return stats;
+}
+
+void StatisticsManagerServer::importJson(std::string_view json)
 {
    try 
    {
-      std::ofstream file(statsFile);
-      FileUtils.writeStringToFile(statsFile, dumpJson(statsData));
+      statsData = parseJson(json);
+      hasUnsavedChanges = true;
    }
-   catch (IOException var2) 
+   catch (nlohmann::json::exception& var3) 
    {
-      LOGGER.error("Couldn't save stats", var2);
+      LOGGER->error("Couldn't parse statistics file {}: {}", statsFile.string(), var3.what());
    }
 }
 
-void StatisticsManagerServer::unlockAchievement(EntityPlayer* playerIn, StatBase statIn, int32_t p_150873_3_)
+std::string StatisticsManagerServer::exportJson() const
 {
-   StatisticsManager::unlockAchievement(playerIn, statIn, p_150873_3_);
-   dirty.insert(statIn);
+   return dumpJson(statsData);
 }
 
-std::set<StatBase> StatisticsManagerServer::getDirty()
+std::vector<int32_t> StatisticsManagerServer::parseJson(std::string_view p_150881_1_)
 {
-   auto set = dirty;
-   dirty.clear();
-   return set;
+   std::vector<int32_t> stats;
+   auto jsonobject = nlohmann::json::parse(p_150881_1_);
+   if (!jsonobject.is_object())
+   {
+      return stats;
+   }
+
+   for (auto& entry : jsonobject.items())
+   {
+      auto statbase = StatList::getOneShotStat(entry.key());
+      if (statbase == nullptr)
+      {
+         LOGGER->warn("Invalid statistic: Don't know what {} is", entry.key());
+         continue;
+      }
+
+      auto& value = entry.value();
+      int32_t count = 0;
+      if (value.is_number())
+      {
+         count = value.get<int32_t>();
+      }
+      else if (value.is_object() && value.contains("value") && value["value"].is_number())
+      {
+         count = value["value"].get<int32_t>();
+      }
+
+      auto ordinal = static_cast<size_t>(statbase->getOrdinal());
+      if (ordinal >= stats.size())
+      {
+         stats.resize(ordinal + 1);
+      }
+
+      stats[ordinal] = count;
+   }
+
+   return stats;
+}
+
+std::string StatisticsManagerServer::dumpJson(const std::vector<int32_t>& p_150880_0_)
+{
+   nlohmann::json jsonobject = nlohmann::json::object();
+   for (size_t ordinal = 0; ordinal < p_150880_0_.size(); ++ordinal)
+   {
+      auto statbase = StatList::getStatByOrdinal(static_cast<int32_t>(ordinal));
+      if (statbase != nullptr && p_150880_0_[ordinal] != 0)
+      {
+         jsonobject[statbase->statId] = p_150880_0_[ordinal];
+      }
+   }
+
+   return jsonobject.dump();
+}
+
+std::string StatisticsManagerServer::encodeStats(const std::vector<int32_t>& stats)
+{
+   // "MCST", version, entry count, then (id length, id, zigzag value) for every non-zero counter.
+   // Ids rather than ordinals are stored because ordinals move whenever a stat is registered.
+   std::string out(MAGIC);
+   out.push_back(static_cast<char>(FORMAT_VERSION));
+   auto count = static_cast<uint32_t>(std::count_if(stats.begin(), stats.end(), [](int32_t value) { return value != 0; }));
+   writeVarInt(out, count);
+   for (size_t ordinal = 0; ordinal < stats.size(); ++ordinal)
+   {
+      if (stats[ordinal] == 0)
+      {
+         continue;
+      }
+
+      auto statbase = StatList::getStatByOrdinal(static_cast<int32_t>(ordinal));
+      writeVarInt(out, static_cast<uint32_t>(statbase->statId.size()));
+      out.append(statbase->statId);
+      writeVarInt(out, (static_cast<uint32_t>(stats[ordinal]) << 1) ^ static_cast<uint32_t>(stats[ordinal] >> 31));
+   }
+
+   return out;
+}
+
+std::optional<std::vector<int32_t>> StatisticsManagerServer::decodeStats(std::string_view data)
+{
+   if (data.size() < MAGIC.size() + 1 || data.substr(0, MAGIC.size()) != MAGIC || static_cast<uint8_t>(data[MAGIC.size()]) != FORMAT_VERSION)
+   {
+      return std::nullopt;
+   }
+
+   size_t offset = MAGIC.size() + 1;
+   auto count = readVarInt(data, offset);
+   if (!count)
+   {
+      return std::nullopt;
+   }
+
+   std::vector<int32_t> stats;
+   stats.resize(StatList::ALL_STATS.size());
+   for (uint32_t i = 0; i < *count; ++i)
+   {
+      auto length = readVarInt(data, offset);
+      if (!length || *length > data.size() - offset)
+      {
+         return std::nullopt;
+      }
+
+      auto statId = data.substr(offset, *length);
+      offset += *length;
+      auto value = readVarInt(data, offset);
+      if (!value)
+      {
+         return std::nullopt;
+      }
+
+      auto statbase = StatList::getOneShotStat(statId);
+      if (statbase == nullptr)
+      {
+         LOGGER->warn("Dropping unknown statistic {}", statId);
+         continue;
+      }
+
+      auto ordinal = static_cast<size_t>(statbase->getOrdinal());
+      if (ordinal >= stats.size())
+      {
+         stats.resize(ordinal + 1);
+      }
+
+      stats[ordinal] = static_cast<int32_t>((*value >> 1) ^ (~(*value & 1) + 1));
+   }
+
+   return stats;
 }
 
 void StatisticsManagerServer::markAllDirty()
 {
-   dirty.addAll(statsData.keySet());
+   dirty.resize(statsData.size());
+   for (size_t ordinal = 0; ordinal < statsData.size(); ++ordinal)
+   {
+      if (statsData[ordinal] != 0)
+      {
+         dirty.set(ordinal);
+      }
+   }
 }
 
 void StatisticsManagerServer::sendStats(EntityPlayerMP* player)
 {
    auto i = server->getTickCounter();
-   std::unordered_map<StatBase,int32_t> map;
+   std::unordered_map<StatBase*,int32_t> map;
    if (i - lastStatRequest > 300) 
    {
       lastStatRequest = i;
-      Iterator var4 = getDirty().iterator();
-
-      while(var4.hasNext()) 
+      for (auto statbase : getDirty())
       {
-         StatBase statbase = (StatBase)var4.next();
-         map.insert(statbase, readStat(statbase));
+         map.emplace(statbase, readStat(statbase));
       }
    }
 
@@ -1,7 +1,9 @@
 #pragma once
 
+#include <dynamic_bitset.hpp>
 #include <filesystem>
-#include <set>
+#include <future>
+#include <optional>
 #include "spdlog/logger.h"
 #include "StatisticsManager.h"
 
@@ -11,18 +13,41 @@ class StatisticsManagerServer :public StatisticsManager
 {
 public:
 	StatisticsManagerServer(MinecraftServer* serverIn, std::string_view statsFileIn);
+	// starts reading the stats file on the I/O workers, pollStatFile applies it once it has arrived
 	void readStatFile();
+	bool pollStatFile();
 	void saveStatFile();
-	void unlockAchievement(EntityPlayer* playerIn, StatBase statIn, int32_t p_150873_3_) override;
-	std::set<StatBase> getDirty();
-	std::unordered_map<> parseJson(std::string_view p_150881_1_);
-	std::string dumpJson(std::unordered_map<>& p_150880_0_);
+	void unlockAchievement(EntityPlayer* playerIn, StatBase* statIn, int32_t p_150873_3_) override;
+	std::vector<StatBase*> getDirty();
+	void importJson(std::string_view json);
+	std::string exportJson() const;
+	static std::vector<int32_t> parseJson(std::string_view p_150881_1_);
+	static std::string dumpJson(const std::vector<int32_t>& p_150880_0_);
+	// Binary stats file: "MCST", a version byte, a varint count of the non-zero counters, then for each one a
+	// varint id length, the stat id bytes and the zigzag varint value. Unknown ids are dropped when decoding.
+	static std::string encodeStats(const std::vector<int32_t>& stats);
+	static std::optional<std::vector<int32_t>> decodeStats(std::string_view data);
 	void markAllDirty();
 	void sendStats(EntityPlayerMP* player);
 private:
 	static std::shared_ptr<spdlog::logger> LOGGER;
+	static constexpr std::string_view MAGIC = "MCST";
+	static constexpr uint8_t FORMAT_VERSION = 1;
+
+	struct LoadedStats
+	{
+		std::vector<int32_t> stats;
+		bool imported = false;
+	};
+
 	MinecraftServer* server;
+	// stats/<uuid>.json is only read to import counters written before the binary format
 	std::filesystem::path statsFile;
-	std::set<StatBase> dirty;
+	std::filesystem::path binaryStatsFile;
+	dynamic_bitset<> dirty;
+	bool hasUnsavedChanges = false;
 	int32_t lastStatRequest = -300;
+	std::shared_future<std::optional<LoadedStats>> pendingRead;
+
+	static std::optional<LoadedStats> loadStats(const std::filesystem::path& binaryFile, const std::filesystem::path& jsonFile, std::optional<std::string> contents);
 };
@@ -24,9 +24,9 @@ void MobSpawnerBaseLogic::updateSpawner()
       BlockPos blockpos = getSpawnerPosition();
       if (getSpawnerWorld()->isRemote)
       {
-         double d3 = (double)((float)blockpos.getx() + MathHelper::nextFloat(getSpawnerWorld()->rand));
-         double d4 = (double)((float)blockpos.gety() + MathHelper::nextFloat(getSpawnerWorld()->rand));
-         double d5 = (double)((float)blockpos.getz() + MathHelper::nextFloat(getSpawnerWorld()->rand));
+         double d3 = (double)((float)blockpos.getx() + MathHelper::nextFloat(getSpawnerWorld()->getRandom()));
+         double d4 = (double)((float)blockpos.gety() + MathHelper::nextFloat(getSpawnerWorld()->getRandom()));
+         double d5 = (double)((float)blockpos.getz() + MathHelper::nextFloat(getSpawnerWorld()->getRandom()));
          getSpawnerWorld()->spawnParticle(EnumParticleTypes::SMOKE_NORMAL, d3, d4, d5, 0.0, 0.0, 0.0);
          getSpawnerWorld()->spawnParticle(EnumParticleTypes::FLAME, d3, d4, d5, 0.0, 0.0, 0.0);
          if (spawnDelay > 0) 
@@ -68,9 +68,9 @@ void MobSpawnerBaseLogic::updateSpawner()
             auto nbttaglist = nbttagcompound->getTagList("Pos", 6);
             auto world = getSpawnerWorld();
             int32_t j = nbttaglist->tagCount();
-            double d0 = j >= 1 ? nbttaglist->getDoubleAt(0) : (double)blockpos.getx() + (MathHelper::nextDouble(world->rand) - MathHelper::nextDouble(world->rand)) * (double)spawnRange + 0.5;
-            double d1 = j >= 2 ? nbttaglist->getDoubleAt(1) : (double)(blockpos.gety() + world->rand(3) - 1);
-            double d2 = j >= 3 ? nbttaglist->getDoubleAt(2) : (double)blockpos.getz() + (MathHelper::nextDouble(world->rand) - MathHelper::nextDouble(world->rand)) * (double)spawnRange + 0.5;
+            double d0 = j >= 1 ? nbttaglist->getDoubleAt(0) : (double)blockpos.getx() + (MathHelper::nextDouble(world->getRandom()) - MathHelper::nextDouble(world->getRandom())) * (double)spawnRange + 0.5;
+            double d1 = j >= 2 ? nbttaglist->getDoubleAt(1) : (double)(blockpos.gety() + world->getRandom()(3) - 1);
+            double d2 = j >= 3 ? nbttaglist->getDoubleAt(2) : (double)blockpos.getz() + (MathHelper::nextDouble(world->getRandom()) - MathHelper::nextDouble(world->getRandom())) * (double)spawnRange + 0.5;
             auto entity = AnvilChunkLoader::readWorldEntityPos(nbttagcompound, world, d0, d1, d2, false);
             if (entity == nullptr) 
             {
@@ -85,7 +85,7 @@ void MobSpawnerBaseLogic::updateSpawner()
             }
 
             auto entityliving = Util::instanceof<EntityLiving>(entity) ? (EntityLiving*)entity : nullptr;
-            entity->setLocationAndAngles(entity->posX, entity->posY, entity->posZ, MathHelper::nextFloat(world->rand) * 360.0F, 0.0F);
+            entity->setLocationAndAngles(entity->posX, entity->posY, entity->posZ, MathHelper::nextFloat(world->getRandom()) * 360.0F, 0.0F);
             if (entityliving == nullptr || entityliving.getCanSpawnHere() && entityliving.isNotColliding()) 
             {
                if (spawnData.getNbt()->getSize() == 1 && spawnData.getNbt()->hasKey("id", 8) && Util::instanceof<EntityLiving>(entity)) 
@@ -129,7 +129,7 @@ void MobSpawnerBaseLogic::readFromNBT(NBTTagCompound* nbt)
    }
    else if (!potentialSpawns.empty()) 
    {
-      setNextSpawnData((WeightedSpawnerEntity)WeightedRandom::getRandomItem(getSpawnerWorld()->rand, potentialSpawns));
+      setNextSpawnData((WeightedSpawnerEntity)WeightedRandom::getRandomItem(getSpawnerWorld()->getRandom(), potentialSpawns));
    }
 
    if (nbt->hasKey("MinSpawnDelay", 99)) 
@@ -254,12 +254,12 @@ void MobSpawnerBaseLogic::resetTimer()
    else 
    {
       int32_t i = maxSpawnDelay - minSpawnDelay;
-      spawnDelay = minSpawnDelay + getSpawnerWorld()->rand(i);
+      spawnDelay = minSpawnDelay + getSpawnerWorld()->getRandom()(i);
    }
 
    if (!potentialSpawns.empty()) 
    {
-      setNextSpawnData((WeightedSpawnerEntity)WeightedRandom::getRandomItem(getSpawnerWorld()->rand, potentialSpawns));
+      setNextSpawnData((WeightedSpawnerEntity)WeightedRandom::getRandomItem(getSpawnerWorld()->getRandom(), potentialSpawns));
    }
 
    broadcastEvent(std::byte{1});
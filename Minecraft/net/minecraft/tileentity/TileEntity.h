@@ -36,6 +36,9 @@ public:
    virtual void mirror(Mirror mirrorIn);
 
    static TileEntity create(World* worldIn, NBTTagCompound* compound);
+
+   // marked for removal, dropped from the world's lists by the next World::compactTileEntityLists
+   bool removalPending = false;
 protected:
    virtual void setWorldCreate(World* worldIn);
 
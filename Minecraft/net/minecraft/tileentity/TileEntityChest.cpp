@@ -149,7 +149,7 @@ void TileEntityChest::update()
 			d1 += 0.5;
 		}
 
-		world->playSound((EntityPlayer)nullptr, d1, (double)j + 0.5, d3, SoundEvents.BLOCK_CHEST_OPEN, SoundCategory.BLOCKS, 0.5F, world->rand.nextFloat() * 0.1F + 0.9F);
+		world->playSound((EntityPlayer)nullptr, d1, (double)j + 0.5, d3, SoundEvents.BLOCK_CHEST_OPEN, SoundCategory.BLOCKS, 0.5F, world->getRandom().nextFloat() * 0.1F + 0.9F);
 	}
 
 	if (numPlayersUsing == 0 && lidAngle > 0.0F || numPlayersUsing > 0 && lidAngle < 1.0F) 
@@ -184,7 +184,7 @@ void TileEntityChest::update()
 				d3 += 0.5;
 			}
 
-			world->playSound(nullptr, d3, (double)j + 0.5, d0, SoundEvents::BLOCK_CHEST_CLOSE, SoundCategory::BLOCKS, 0.5F, MathHelper::nextFloat(world->rand) * 0.1F + 0.9F);
+			world->playSound(nullptr, d3, (double)j + 0.5, d0, SoundEvents::BLOCK_CHEST_CLOSE, SoundCategory::BLOCKS, 0.5F, MathHelper::nextFloat(world->getRandom()) * 0.1F + 0.9F);
 		}
 
 		if (lidAngle < 0.0F) 
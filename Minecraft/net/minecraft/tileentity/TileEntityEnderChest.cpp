@@ -17,7 +17,7 @@ void TileEntityEnderChest::update()
    {
       double d0 = (double)i + 0.5;
       d3 = (double)k + 0.5;
-      world->playSound(nullptr, d0, (double)j + 0.5, d3, SoundEvents::BLOCK_ENDERCHEST_OPEN, SoundCategory::BLOCKS, 0.5F, MathHelper::nextFloat(world->rand) * 0.1F + 0.9F);
+      world->playSound(nullptr, d0, (double)j + 0.5, d3, SoundEvents::BLOCK_ENDERCHEST_OPEN, SoundCategory::BLOCKS, 0.5F, MathHelper::nextFloat(world->getRandom()) * 0.1F + 0.9F);
    }
 
    if (numPlayersUsing == 0 && lidAngle > 0.0F || numPlayersUsing > 0 && lidAngle < 1.0F) 
@@ -42,7 +42,7 @@ void TileEntityEnderChest::update()
       {
          d3 = (double)i + 0.5;
          double d2 = (double)k + 0.5;
-         world->playSound(nullptr, d3, (double)j + 0.5, d2, SoundEvents::BLOCK_ENDERCHEST_CLOSE, SoundCategory::BLOCKS, 0.5F, MathHelper::nextFloat(world->rand) * 0.1F + 0.9F);
+         world->playSound(nullptr, d3, (double)j + 0.5, d2, SoundEvents::BLOCK_ENDERCHEST_CLOSE, SoundCategory::BLOCKS, 0.5F, MathHelper::nextFloat(world->getRandom()) * 0.1F + 0.9F);
       }
 
       if (lidAngle < 0.0F) 
@@ -515,7 +515,7 @@ IInventory* TileEntityHopper::getInventoryAtPosition(World* worldIn, double x, d
 		auto list = worldIn->getEntitiesInAABBexcluding((Entity)nullptr, AxisAlignedBB(x - 0.5, y - 0.5, z - 0.5, x + 0.5, y + 0.5, z + 0.5), EntitySelectors::HAS_INVENTORY);
 		if (!list.isEmpty()) 
 		{
-			iinventory = (IInventory)list.get(worldIn->rand(list.size()));
+			iinventory = (IInventory)list.get(worldIn->getRandom()(list.size()));
 		}
 	}
 
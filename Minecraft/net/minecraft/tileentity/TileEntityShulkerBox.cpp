@@ -80,7 +80,7 @@ void TileEntityShulkerBox::openInventory(EntityPlayer* player)
       ++openCount;
       world->addBlockEvent(pos, getBlockType(), 1, openCount);
       if (openCount == 1) {
-         world->playSound(nullptr, pos, SoundEvents::BLOCK_SHULKER_BOX_OPEN, SoundCategory::BLOCKS, 0.5F, MathHelper::nextFloat(world->rand) * 0.1F + 0.9F);
+         world->playSound(nullptr, pos, SoundEvents::BLOCK_SHULKER_BOX_OPEN, SoundCategory::BLOCKS, 0.5F, MathHelper::nextFloat(world->getRandom()) * 0.1F + 0.9F);
       }
    }
 }
@@ -230,7 +230,7 @@ void TileEntityShulkerBox::closeInventory(EntityPlayer* player)
       --openCount;
       world->addBlockEvent(pos, getBlockType(), 1, openCount);
       if (openCount <= 0) {
-         world->playSound(nullptr, pos, SoundEvents::BLOCK_SHULKER_BOX_CLOSE, SoundCategory::BLOCKS, 0.5F, MathHelper::nextFloat(world->rand) * 0.1F + 0.9F);
+         world->playSound(nullptr, pos, SoundEvents::BLOCK_SHULKER_BOX_CLOSE, SoundCategory::BLOCKS, 0.5F, MathHelper::nextFloat(world->getRandom()) * 0.1F + 0.9F);
       }
    }
 }
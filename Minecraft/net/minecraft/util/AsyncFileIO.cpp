@@ -0,0 +1,129 @@
+#include "AsyncFileIO.h"
+#include <fstream>
+#include "spdlog/spdlog.h"
+#include "Util.h"
+
+std::shared_ptr<spdlog::logger> AsyncFileIO::LOGGER = Util::getLogger("AsyncFileIO");
+
+AsyncFileIO* AsyncFileIO::getInstance()
+{
+	static AsyncFileIO instance(2);
+	return &instance;
+}
+
+AsyncFileIO::AsyncFileIO(uint32_t threadCount)
+	: pool("File IO", threadCount)
+{
+}
+
+void AsyncFileIO::write(const std::filesystem::path& path, std::function<std::string()> serializer)
+{
+	bool schedule;
+	{
+		std::lock_guard<std::mutex> guard(lock);
+		auto& entry = entries[path.string()];
+		schedule = !entry.pending && !entry.running;
+		entry.pending = std::move(serializer);
+	}
+
+	if (schedule)
+	{
+		pool.execute([this, path]() { drain(path); });
+	}
+}
+
+std::future<std::optional<std::string>> AsyncFileIO::read(const std::filesystem::path& path)
+{
+	return read(path, [](std::optional<std::string> contents) { return contents; });
+}
+
+void AsyncFileIO::scheduleRead(const std::filesystem::path& path, std::function<void()> task)
+{
+	{
+		std::lock_guard<std::mutex> guard(lock);
+		auto entry = entries.find(path.string());
+		if (entry != entries.end())
+		{
+			entry->second.afterWrite.emplace_back(std::move(task));
+			return;
+		}
+	}
+
+	pool.execute(std::move(task));
+}
+
+std::optional<std::string> AsyncFileIO::readFile(const std::filesystem::path& path)
+{
+	if (!std::filesystem::is_regular_file(path))
+	{
+		return std::nullopt;
+	}
+
+	std::ifstream input(path, std::ios::binary);
+	return std::string(std::istreambuf_iterator<char>(input), std::istreambuf_iterator<char>());
+}
+
+void AsyncFileIO::waitForFinish()
+{
+	std::unique_lock<std::mutex> guard(lock);
+	finished.wait(guard, [this]() { return entries.empty(); });
+}
+
+size_t AsyncFileIO::getPendingCount()
+{
+	std::lock_guard<std::mutex> guard(lock);
+	return entries.size();
+}
+
+void AsyncFileIO::drain(const std::filesystem::path& path)
+{
+	auto key = path.string();
+	while (true)
+	{
+		std::function<std::string()> serializer;
+		{
+			std::lock_guard<std::mutex> guard(lock);
+			auto& entry = entries[key];
+			if (!entry.pending)
+			{
+				auto reads = std::move(entry.afterWrite);
+				entries.erase(key);
+				for (auto& read : reads)
+				{
+					pool.execute(std::move(read));
+				}
+
+				finished.notify_all();
+				return;
+			}
+
+			serializer = std::move(entry.pending);
+			entry.pending = nullptr;
+			entry.running = true;
+		}
+
+		try
+		{
+			auto contents = serializer();
+			auto temporary = path;
+			temporary += ".tmp";
+			{
+				std::ofstream output(temporary, std::ios::binary | std::ios::trunc);
+				output.write(contents.data(), static_cast<std::streamsize>(contents.size()));
+				if (!output)
+				{
+					throw std::runtime_error("Failed to write " + temporary.string());
+				}
+			}
+
+			std::filesystem::rename(temporary, path);
+		}
+		catch (std::exception& e)
+		{
+			LOGGER->error("Failed to save {}: {}", path.string(), e.what());
+		}
+
+		std::lock_guard<std::mutex> guard(lock);
+		entries[key].running = false;
+	}
+}
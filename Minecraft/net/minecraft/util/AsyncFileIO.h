@@ -0,0 +1,66 @@
+#pragma once
+#include <condition_variable>
+#include <filesystem>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "WorkerPool.h"
+
+namespace spdlog {
+	class logger;
+}
+
+// Small-file I/O off the main thread. The caller snapshots its state and hands over a serializer that
+// runs on a worker; the result is written to a temporary file and renamed over the target. Writes to one
+// path are applied in order and an unstarted write is replaced by a newer one. Reads wait for the
+// writes already queued for their path, so a read never sees data older than the last write.
+class AsyncFileIO
+{
+public:
+	static AsyncFileIO* getInstance();
+	explicit AsyncFileIO(uint32_t threadCount);
+
+	void write(const std::filesystem::path& path, std::function<std::string()> serializer);
+	std::future<std::optional<std::string>> read(const std::filesystem::path& path);
+	// Runs continuation(contents) on the I/O worker once the read finished, so callers that decode the file
+	// never have to block a thread of another pool waiting for it.
+	template<typename Function>
+	auto read(const std::filesystem::path& path, Function&& continuation) -> std::future<decltype(continuation(std::optional<std::string>()))>;
+	void waitForFinish();
+	size_t getPendingCount();
+private:
+	struct Entry
+	{
+		std::function<std::string()> pending;
+		bool running = false;
+		std::vector<std::function<void()>> afterWrite;
+	};
+
+	static std::shared_ptr<spdlog::logger> LOGGER;
+	std::mutex lock;
+	std::condition_variable finished;
+	std::unordered_map<std::string, Entry> entries;
+	WorkerPool pool;
+
+	void drain(const std::filesystem::path& path);
+	void scheduleRead(const std::filesystem::path& path, std::function<void()> task);
+	static std::optional<std::string> readFile(const std::filesystem::path& path);
+};
+
+template <typename Function>
+auto AsyncFileIO::read(const std::filesystem::path& path, Function&& continuation) -> std::future<decltype(continuation(std::optional<std::string>()))>
+{
+	using Result = decltype(continuation(std::optional<std::string>()));
+	auto packaged = std::make_shared<std::packaged_task<Result()>>([path, continuation = std::forward<Function>(continuation)]() mutable
+	{
+		return continuation(readFile(path));
+	});
+
+	auto future = packaged->get_future();
+	scheduleRead(path, [packaged]() { (*packaged)(); });
+	return future;
+}
@@ -31,35 +31,39 @@ bool EntitySelectors::NOT_SPECTATING(const Entity * lhs)
 	return !(Util::instanceof<EntityPlayer>(lhs)) || !((EntityPlayer*)lhs)->isSpectator();
 }
 
-std::function<bool(const Entity *)> EntitySelectors::getTeamCollisionPredicate(const Entity * entityIn)
+bool EntitySelectors::canTeamCollide(const Entity * entityIn, const Entity * lhs)
 {
 	const Team* team = entityIn->getTeam();
 	const Team::CollisionRule team$collisionrule = team == nullptr ? Team::CollisionRule::ALWAYS : team->getCollisionRule();
-	auto ret = team$collisionrule == Team::CollisionRule::NEVER ? [](const Entity * lhs){return false;} : [&](const Entity * lhs){
-        if (!lhs->canBePushed()) {
-		    return false;
-	    }
-	    else if (entityIn->world->isRemote && (!(Util::instanceof<EntityPlayer>(lhs)) || !((EntityPlayer*)lhs)->isUser())) {
-		    return false;
-	    }
-	    else {
-		    Team* team1 = lhs->getTeam();
-		    Team::CollisionRule team$collisionrule1 = team1 == nullptr ? Team::CollisionRule::ALWAYS : team1->getCollisionRule();
-		    if (team$collisionrule1 == Team::CollisionRule::NEVER) {
-			    return false;
-		    }
-		    else {
-			    bool flag = team != nullptr && team->isSameTeam(team1);
-			    if ((team$collisionrule == Team::CollisionRule::HIDE_FOR_OWN_TEAM || team$collisionrule1 == Team::CollisionRule::HIDE_FOR_OWN_TEAM) && flag) {
-				    return false;
-			    }
-			    else {
-				    return team$collisionrule != Team::CollisionRule::HIDE_FOR_OTHER_TEAMS && team$collisionrule1 != Team::CollisionRule::HIDE_FOR_OTHER_TEAMS || flag;
-			    }
-		    }
-	    }
-    };
-	return ret;
+	if (team$collisionrule == Team::CollisionRule::NEVER || !lhs->canBePushed()) {
+		return false;
+	}
+	else if (entityIn->world->isRemote && (!(Util::instanceof<EntityPlayer>(lhs)) || !((EntityPlayer*)lhs)->isUser())) {
+		return false;
+	}
+	else {
+		Team* team1 = lhs->getTeam();
+		Team::CollisionRule team$collisionrule1 = team1 == nullptr ? Team::CollisionRule::ALWAYS : team1->getCollisionRule();
+		if (team$collisionrule1 == Team::CollisionRule::NEVER) {
+			return false;
+		}
+		else {
+			bool flag = team != nullptr && team->isSameTeam(team1);
+			if ((team$collisionrule == Team::CollisionRule::HIDE_FOR_OWN_TEAM || team$collisionrule1 == Team::CollisionRule::HIDE_FOR_OWN_TEAM) && flag) {
+				return false;
+			}
+			else {
+				return team$collisionrule != Team::CollisionRule::HIDE_FOR_OTHER_TEAMS && team$collisionrule1 != Team::CollisionRule::HIDE_FOR_OTHER_TEAMS || flag;
+			}
+		}
+	}
+}
+
+std::function<bool(const Entity *)> EntitySelectors::getTeamCollisionPredicate(const Entity * entityIn)
+{
+	return [entityIn](const Entity * lhs){
+		return canTeamCollide(entityIn, lhs);
+	};
 }
 
 bool EntitySelectors::notRiding(const Entity * p_191324_0_, const Entity *p_apply_1_)
@@ -11,6 +11,8 @@ namespace EntitySelectors
 	bool CAN_AI_TARGET(const Entity* lhs);
 	bool NOT_SPECTATING(const Entity* lhs);
 	bool withinRange(const Entity* lhs,const double x, const double y, const double z, double range);
+	// Whether entityIn may push lhs under the collision rules of both teams.
+	bool canTeamCollide(const Entity* entityIn, const Entity* lhs);
 	std::function<bool(const Entity *)> getTeamCollisionPredicate(const Entity* entityIn);
 	bool notRiding(const Entity* p_191324_0_, const Entity *p_apply_1_);
 };
\ No newline at end of file
@@ -2,6 +2,7 @@
 #include <chrono>
 #include <string_view>
 #include <locale>
+#include "spdlog/spdlog.h"
 
 Util::EnumOS Util::getOSType()
 {
@@ -27,6 +28,12 @@ bool Util::startwith(std::string_view prefix, std::string_view toCheck)
 	return std::mismatch(prefix.begin(), prefix.end(), toCheck.begin()).first == prefix.end();
 }
 
+std::shared_ptr<spdlog::logger> Util::getLogger(std::string_view name)
+{
+	auto parent = spdlog::get("Minecraft");
+	return (parent != nullptr ? parent : spdlog::default_logger())->clone(std::string(name));
+}
+
 int64_t Util::getStringHash(std::string_view str)
 {
 	auto size = str.size();
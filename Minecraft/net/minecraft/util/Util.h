@@ -1,7 +1,9 @@
 #pragma once
 #include <cstdint>
+#include <memory>
 #include <optional>
 #include <random>
+#include <string_view>
 
 namespace spdlog {
 	class logger;
@@ -49,6 +51,10 @@ namespace Util
 
 	bool startwith(std::string_view prefix,std::string_view toCheck);
 
+	// A child of the "Minecraft" logger, or of spdlog's default logger in binaries that never register it, such as
+	// the tests. Safe to call from static initialisers.
+	std::shared_ptr<spdlog::logger> getLogger(std::string_view name);
+
 	int64_t getStringHash(std::string_view);
 
 	template <typename U = uint64_t>
@@ -0,0 +1,96 @@
+#include "WorkerPool.h"
+#include "ThreadName.h"
+
+WorkerPool::WorkerPool(std::string_view nameIn, uint32_t threadCount)
+	: name(nameIn)
+{
+	if (threadCount == 0)
+	{
+		threadCount = getDefaultThreadCount();
+	}
+
+	workers.reserve(threadCount);
+	for (uint32_t i = 0; i < threadCount; ++i)
+	{
+		workers.emplace_back(&WorkerPool::run, this);
+		setName(workers.back(), name + " #" + std::to_string(i));
+	}
+}
+
+WorkerPool::~WorkerPool()
+{
+	{
+		std::lock_guard<std::mutex> guard(lock);
+		stopping = true;
+	}
+
+	taskAvailable.notify_all();
+	for (auto& worker : workers)
+	{
+		worker.join();
+	}
+}
+
+void WorkerPool::execute(std::function<void()> task)
+{
+	{
+		std::lock_guard<std::mutex> guard(lock);
+		tasks.emplace_back(std::move(task));
+	}
+
+	taskAvailable.notify_one();
+}
+
+void WorkerPool::waitForIdle()
+{
+	std::unique_lock<std::mutex> guard(lock);
+	idle.wait(guard, [this]() { return tasks.empty() && runningTasks == 0; });
+}
+
+uint32_t WorkerPool::getThreadCount() const
+{
+	return static_cast<uint32_t>(workers.size());
+}
+
+size_t WorkerPool::getQueuedCount()
+{
+	std::lock_guard<std::mutex> guard(lock);
+	return tasks.size();
+}
+
+uint32_t WorkerPool::getDefaultThreadCount()
+{
+	auto cores = std::thread::hardware_concurrency();
+	return cores > 1 ? cores - 1 : 1;
+}
+
+void WorkerPool::run()
+{
+	while (true)
+	{
+		std::function<void()> task;
+		{
+			std::unique_lock<std::mutex> guard(lock);
+			taskAvailable.wait(guard, [this]() { return stopping || !tasks.empty(); });
+			if (tasks.empty())
+			{
+				return;
+			}
+
+			task = std::move(tasks.front());
+			tasks.pop_front();
+			++runningTasks;
+		}
+
+		task();
+
+		{
+			std::lock_guard<std::mutex> guard(lock);
+			--runningTasks;
+			if (tasks.empty() && runningTasks == 0)
+			{
+				idle.notify_all();
+			}
+		}
+	}
+}
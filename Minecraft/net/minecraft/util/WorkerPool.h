@@ -0,0 +1,49 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+class WorkerPool
+{
+public:
+	explicit WorkerPool(std::string_view nameIn, uint32_t threadCount = 0);
+	~WorkerPool();
+	WorkerPool(const WorkerPool&) = delete;
+	WorkerPool& operator=(const WorkerPool&) = delete;
+
+	template<typename Function>
+	auto submit(Function&& task) -> std::future<decltype(task())>;
+	void execute(std::function<void()> task);
+	void waitForIdle();
+	uint32_t getThreadCount() const;
+	size_t getQueuedCount();
+
+	static uint32_t getDefaultThreadCount();
+private:
+	std::string name;
+	std::vector<std::thread> workers;
+	std::deque<std::function<void()>> tasks;
+	std::mutex lock;
+	std::condition_variable taskAvailable;
+	std::condition_variable idle;
+	uint32_t runningTasks = 0;
+	bool stopping = false;
+
+	void run();
+};
+
+template <typename Function>
+auto WorkerPool::submit(Function&& task) -> std::future<decltype(task())>
+{
+	using Result = decltype(task());
+	auto packaged = std::make_shared<std::packaged_task<Result()>>(std::forward<Function>(task));
+	auto future = packaged->get_future();
+	execute([packaged]() { (*packaged)(); });
+	return future;
+}
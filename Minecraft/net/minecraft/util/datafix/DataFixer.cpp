@@ -4,6 +4,8 @@
 #include "IFixableData.h"
 #include "IDataWalker.h"
 
+#include <algorithm>
+
 std::shared_ptr<spdlog::logger> DataFixer::LOGGER = spdlog::get("Minecraft")->clone("DataFixer");
 
 DataFixer::DataFixer(int32_t versionIn)
@@ -15,7 +17,7 @@ DataFixer::DataFixer(int32_t versionIn)
 std::shared_ptr < NBTTagCompound> DataFixer::process(IFixType type, std::shared_ptr < NBTTagCompound> compound)
 {
 	auto i = compound->hasKey("DataVersion", 99) ? compound->getInteger("DataVersion") : -1;
-	return i >= 1343 ? compound : process(type, compound, i);
+	return i >= version ? compound : process(type, compound, i);
 }
 
 std::shared_ptr < NBTTagCompound> DataFixer::process(IFixType type, std::shared_ptr < NBTTagCompound> compound, int32_t versionIn)
@@ -28,16 +30,27 @@ std::shared_ptr < NBTTagCompound> DataFixer::process(IFixType type, std::shared_
 	return compound;
 }
 
+int32_t DataFixer::getVersion() const
+{
+	return version;
+}
+
+bool DataFixer::needsFixing(IFixType type, int32_t versionIn) const
+{
+	if (versionIn >= version) {
+		return false;
+	}
+
+	auto& pipeline = getPipeline(type);
+	return !pipeline.walkers.empty() || (!pipeline.versions.empty() && pipeline.versions.back() > versionIn);
+}
+
 std::shared_ptr < NBTTagCompound> DataFixer::processFixes(IFixType type, std::shared_ptr < NBTTagCompound> compound, int32_t versionIn)
 {
-	List list = (List)fixMap.get(type);
-	if (list != ) {
-		for (int i = 0; i < list.size(); ++i) {
-			auto ifixabledata = (IFixableData)list.get(i);
-			if (ifixabledata.getFixVersion() > versionIn) {
-				compound = ifixabledata.fixTagCompound(compound);
-			}
-		}
+	auto& pipeline = getPipeline(type);
+	auto first = std::upper_bound(pipeline.versions.begin(), pipeline.versions.end(), versionIn) - pipeline.versions.begin();
+	for (auto i = static_cast<size_t>(first); i < pipeline.fixes.size(); ++i) {
+		compound = pipeline.fixes[i]->fixTagCompound(compound);
 	}
 
 	return compound;
@@ -45,43 +58,44 @@ std::shared_ptr < NBTTagCompound> DataFixer::processFixes(IFixType type, std::sh
 
 std::shared_ptr < NBTTagCompound> DataFixer::processWalkers(IFixType type, std::shared_ptr < NBTTagCompound> compound, int32_t versionIn)
 {
-	List list = (List)walkerMap.get(type);
-	if (list != ) {
-		for (int i = 0; i < list.size(); ++i) {
-			compound = ((IDataWalker)list.get(i)).process(this, compound, versionIn);
+	// a walker returns the compound it was given, or a replacement it allocated and hands over to us
+	for (auto& walker : getPipeline(type).walkers) {
+		auto result = walker->process(this, compound.get(), versionIn);
+		if (result != compound.get()) {
+			compound.reset(result);
 		}
 	}
 
 	return compound;
 }
 
-void DataFixer::registerWalker(FixTypes type, IDataWalker walker)
+const DataFixer::Pipeline& DataFixer::getPipeline(IFixType type) const
+{
+	return pipelines[static_cast<size_t>(type)];
+}
+
+void DataFixer::registerWalker(FixTypes type, IDataWalker* walker)
 {
 	registerVanillaWalker(type, walker);
 }
 
-void DataFixer::registerVanillaWalker(IFixType type, IDataWalker walker)
+void DataFixer::registerVanillaWalker(IFixType type, IDataWalker* walker)
 {
-	getTypeList(walkerMap, type).add(walker);
+	pipelines[static_cast<size_t>(type)].walkers.emplace_back(walker);
 }
 
-void DataFixer::registerFix(IFixType type, IFixableData fixable)
+void DataFixer::registerFix(IFixType type, IFixableData* fixable)
 {
-	List list = getTypeList(fixMap, type);
-	int i = fixable.getFixVersion();
+	std::shared_ptr<IFixableData> fix(fixable);
+	auto& pipeline = pipelines[static_cast<size_t>(type)];
+	auto i = fix->getFixVersion();
 	if (i > version) {
 		LOGGER->warn("Ignored fix registered for version: {} as the DataVersion of the game is: {}", i, version);
 	}
-	else if (!list.isEmpty() && ((IFixableData)Util.getLastElement(list)).getFixVersion() > i) {
-		for (int j = 0; j < list.size(); ++j) {
-			if (((IFixableData)list.get(j)).getFixVersion() > i) {
-				list.add(j, fixable);
-				break;
-			}
-		}
-	}
 	else {
-		list.add(fixable);
+		// after any fix of the same version, so equal versions keep their registration order
+		auto position = std::upper_bound(pipeline.versions.begin(), pipeline.versions.end(), i) - pipeline.versions.begin();
+		pipeline.versions.insert(pipeline.versions.begin() + position, i);
+		pipeline.fixes.insert(pipeline.fixes.begin() + position, std::move(fix));
 	}
 }
-
@@ -1,10 +1,11 @@
 #pragma once
+#include <array>
+#include <vector>
 #include "spdlog/spdlog.h"
 #include "IDataFixer.h"
 
 class IFixableData;
 class IDataWalker;
-enum class FixTypes;
 class NBTTagCompound;
 
 class DataFixer : public IDataFixer
@@ -14,31 +15,28 @@ public:
 	std::shared_ptr < NBTTagCompound> process(IFixType type, std::shared_ptr < NBTTagCompound> compound);
 	std::shared_ptr < NBTTagCompound> process(IFixType type, std::shared_ptr < NBTTagCompound> compound, int32_t versionIn) override;
 
-	void registerWalker(FixTypes type, IDataWalker walker);
-	void registerVanillaWalker(IFixType type, IDataWalker walker);
-	void registerFix(IFixType type, IFixableData fixable);
+	void registerWalker(FixTypes type, IDataWalker* walker);
+	void registerVanillaWalker(IFixType type, IDataWalker* walker);
+	void registerFix(IFixType type, IFixableData* fixable);
+	int32_t getVersion() const;
+	bool needsFixing(IFixType type, int32_t versionIn) const;
 
 private:
+	// Every fix of one type in a flat array sorted by fix version, with the versions kept alongside so a
+	// lookup is a binary search instead of a virtual call per registered fix. Data that is already newer
+	// than the last fix of its type skips straight to the walkers.
+	struct Pipeline
+	{
+		std::vector<int32_t> versions;
+		std::vector<std::shared_ptr<IFixableData>> fixes;
+		std::vector<std::shared_ptr<IDataWalker>> walkers;
+	};
+
 	static std::shared_ptr<spdlog::logger> LOGGER;
-	std::unordered_map<IFixType,IDataWalker> walkerMap;
-	std::unordered_map<IFixType,IFixableData> fixMap;
+	std::array<Pipeline, FIX_TYPE_COUNT> pipelines;
 	int32_t version;
 
 	std::shared_ptr < NBTTagCompound> processFixes(IFixType type, std::shared_ptr < NBTTagCompound> compound, int32_t versionIn);
 	std::shared_ptr < NBTTagCompound> processWalkers(IFixType type, std::shared_ptr < NBTTagCompound> compound, int32_t versionIn);
-
-	template<class T>
-	List getTypeList(T map, IFixType type);
+	const Pipeline& getPipeline(IFixType type) const;
 };
-
-template<class T>
-List DataFixer::getTypeList(T map, IFixType type)
-{
-	List list = (List)map.get(type);
-	if (list == null) {
-		list = Lists.newArrayList();
-		map.put(type, list);
-	}
-
-	return (List)list;
-}
@@ -1,4 +1,6 @@
 #pragma once
+#include <cstddef>
+
 enum class FixTypes
 {
 	LEVEL,
@@ -10,3 +12,7 @@ enum class FixTypes
 	OPTIONS,
 	STRUCTURE
 };
+
+using IFixType = FixTypes;
+
+constexpr size_t FIX_TYPE_COUNT = static_cast<size_t>(FixTypes::STRUCTURE) + 1;
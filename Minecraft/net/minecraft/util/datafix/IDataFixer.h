@@ -1,5 +1,6 @@
 #pragma once
 #include "NBTTagCompound.h"
+#include "FixTypes.h"
 
 class IDataFixer
 {
@@ -1,8 +1,10 @@
 #pragma once
 #include "NBTTagCompound.h"
 
- class IFixableData {
+class IFixableData
+{
+public:
+	virtual ~IFixableData() = default;
 	virtual int32_t getFixVersion() = 0;
-
 	virtual std::shared_ptr<NBTTagCompound> fixTagCompound(std::shared_ptr<NBTTagCompound> var1) = 0;
- };
+};
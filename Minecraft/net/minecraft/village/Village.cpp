@@ -32,7 +32,7 @@ void Village::tick(int32_t tickCounterIn)
       }
 
       auto i = numVillagers / 10;
-      if (numIronGolems < i && villageDoorInfoList.size() > 20 && world->rand(7000) == 0) {
+      if (numIronGolems < i && villageDoorInfoList.size() > 20 && world->getRandom()(7000) == 0) {
          Vec3d vec3d = findRandomSpawnPos(center, 2, 4, 2);
          if (vec3d != fmt::internal::null) {
             EntityIronGolem* entityirongolem = new EntityIronGolem(world);
@@ -109,7 +109,7 @@ void Village::removeDeadAndOldAgressors()
 void Village::removeDeadAndOutOfRangeDoors()
 {
    bool flag = false;
-   bool flag1 = world.rand(50) == 0;
+   bool flag1 = world.getRandom()(50) == 0;
    Iterator iterator = this.villageDoorInfoList.iterator();
 
    while(true) {
@@ -477,7 +477,7 @@ void Village::setDefaultPlayerReputation(int32_t defaultReputation)
 std::optional<Vec3d> Village::findRandomSpawnPos(BlockPos pos, int32_t x, int32_t y, int32_t z)
 {
 	for(auto i = 0; i < 10; ++i) {
-         BlockPos blockpos = pos.add(world->rand(16) - 8, world->rand(6) - 3, world->rand(16) - 8);
+         BlockPos blockpos = pos.add(world->getRandom()(16) - 8, world->getRandom()(6) - 3, world->getRandom()(16) - 8);
          if (isBlockPosWithinSqVillageRadius(blockpos) && isAreaClearAround(BlockPos(x, y, z), blockpos)) {
             return Vec3d((double)blockpos.getx(), (double)blockpos.gety(), (double)blockpos.getz());
          }
@@ -22,7 +22,7 @@ void VillageSiege::tick()
             return;
          }
 
-         siegeState = world->rand(10) == 0 ? 1 : 2;
+         siegeState = world->getRandom()(10) == 0 ? 1 : 2;
          hasSetupSiege = false;
          if (siegeState == 2) 
          {
@@ -107,7 +107,7 @@ bool VillageSiege::trySetupSiege()
       bool flag = false;
 
       for(int i = 0; i < 10; ++i) {
-         float f1 = MathHelper::nextFloat(world->rand) * 6.2831855F;
+         float f1 = MathHelper::nextFloat(world->getRandom()) * 6.2831855F;
          spawnX = blockpos.getx() + (int)((double)(MathHelper::cos(f1) * f) * 0.9);
          spawnY = blockpos.gety();
          spawnZ = blockpos.getz() + (int)((double)(MathHelper::sin(f1) * f) * 0.9);
@@ -164,7 +164,7 @@ bool VillageSiege::spawnZombie()
          return false;
       }
 
-      entityzombie->setLocationAndAngles(vec3d.getx(), vec3d.gety(), vec3d.getz(), MathHelper::nextFloat(world->rand) * 360.0F, 0.0F);
+      entityzombie->setLocationAndAngles(vec3d.getx(), vec3d.gety(), vec3d.getz(), MathHelper::nextFloat(world->getRandom()) * 360.0F, 0.0F);
       world->spawnEntity(entityzombie);
       BlockPos blockpos = village.getCenter();
       entityzombie->setHomePosAndDistance(blockpos, village.getVillageRadius());
@@ -176,7 +176,7 @@ std::optional<Vec3d> VillageSiege::findRandomSpawnPos(BlockPos pos)
 {
    for(int i = 0; i < 10; ++i) 
    {
-      BlockPos blockpos = pos.add((int32_t)world->rand(16) - 8, world->rand(6) - 3, world->rand(16) - 8);
+      BlockPos blockpos = pos.add((int32_t)world->getRandom()(16) - 8, world->getRandom()(6) - 3, world->getRandom()(16) - 8);
       if (village.isBlockPosWithinSqVillageRadius(blockpos) && WorldEntitySpawner::canCreatureTypeSpawnAtLocation(EntityLiving::SpawnPlacementType.ON_GROUND, world, blockpos)) 
       {
          return Vec3d((double)blockpos.getx(), (double)blockpos.gety(), (double)blockpos.getz());
@@ -0,0 +1,89 @@
+#include "DormantEntityIndex.h"
+#include "../util/math/BlockPos.h"
+
+#include <algorithm>
+
+void DormantEntityIndex::add(Entity* entityIn, const std::vector<BlockPos>& supportPositions)
+{
+	auto entry = supports.try_emplace(entityIn);
+	if (!entry.second)
+	{
+		return;
+	}
+
+	auto& positions = entry.first->second;
+	positions.reserve(supportPositions.size());
+	for (auto& pos : supportPositions)
+	{
+		auto key = pos.toLong();
+		if (std::find(positions.begin(), positions.end(), key) == positions.end())
+		{
+			positions.emplace_back(key);
+			supported[key].emplace_back(entityIn);
+		}
+	}
+}
+
+bool DormantEntityIndex::remove(Entity* entityIn)
+{
+	auto entry = supports.find(entityIn);
+	if (entry == supports.end())
+	{
+		return false;
+	}
+
+	unlink(entityIn, entry->second, INT64_MIN);
+	supports.erase(entry);
+	return true;
+}
+
+void DormantEntityIndex::takeSupportedBy(const BlockPos& pos, std::vector<Entity*>& woken)
+{
+	auto key = pos.toLong();
+	auto entities = supported.find(key);
+	if (entities == supported.end())
+	{
+		return;
+	}
+
+	auto list = std::move(entities->second);
+	supported.erase(entities);
+	for (auto entity : list)
+	{
+		auto entry = supports.find(entity);
+		unlink(entity, entry->second, key);
+		supports.erase(entry);
+		woken.emplace_back(entity);
+	}
+}
+
+bool DormantEntityIndex::empty() const
+{
+	return supports.empty();
+}
+
+size_t DormantEntityIndex::size() const
+{
+	return supports.size();
+}
+
+void DormantEntityIndex::unlink(Entity* entityIn, const std::vector<int64_t>& positions, int64_t skip)
+{
+	for (auto key : positions)
+	{
+		if (key == skip)
+		{
+			continue;
+		}
+
+		auto entities = supported.find(key);
+		auto& list = entities->second;
+		auto position = std::find(list.begin(), list.end(), entityIn);
+		*position = list.back();
+		list.pop_back();
+		if (list.empty())
+		{
+			supported.erase(entities);
+		}
+	}
+}
@@ -0,0 +1,25 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+class BlockPos;
+class Entity;
+
+// Entities that have nothing to do until a block they rest on or occupy changes, keyed by those positions.
+class DormantEntityIndex
+{
+public:
+	void add(Entity* entityIn, const std::vector<BlockPos>& supportPositions);
+	bool remove(Entity* entityIn);
+	// Removes every entity supported by pos and appends it to woken.
+	void takeSupportedBy(const BlockPos& pos, std::vector<Entity*>& woken);
+	bool empty() const;
+	size_t size() const;
+private:
+	std::unordered_map<int64_t, std::vector<Entity*>> supported;
+	std::unordered_map<Entity*, std::vector<int64_t>> supports;
+
+	void unlink(Entity* entityIn, const std::vector<int64_t>& positions, int64_t skip);
+};
@@ -0,0 +1,127 @@
+#include "EntityActivationRange.h"
+#include "EntitySpatialIndex.h"
+#include "GameRules.h"
+#include "../entity/EntityLiving.h"
+#include "../entity/INpc.h"
+#include "../entity/IProjectile.h"
+#include "../entity/MultiPartEntityPart.h"
+#include "../entity/boss/EntityDragon.h"
+#include "../entity/boss/EntityWither.h"
+#include "../entity/item/EntityEnderCrystal.h"
+#include "../entity/item/EntityFallingBlock.h"
+#include "../entity/item/EntityFireworkRocket.h"
+#include "../entity/item/EntityTNTPrimed.h"
+#include "../entity/monster/IMob.h"
+#include "../entity/passive/IAnimals.h"
+#include "../entity/player/EntityPlayer.h"
+#include "../util/Util.h"
+
+#include <algorithm>
+#include <cmath>
+
+const std::array<std::string, EntityActivationRange::ALWAYS_ACTIVE> EntityActivationRange::RANGE_RULES =
+{
+	"monsterActivationRange", "animalActivationRange", "villagerActivationRange", "miscActivationRange"
+};
+
+EntityActivationRange::Category EntityActivationRange::getCategory(Entity* entityIn)
+{
+	if (Util::instanceof<EntityPlayer>(entityIn) || Util::instanceof<IProjectile>(entityIn) || Util::instanceof<MultiPartEntityPart>(entityIn)
+		|| Util::instanceof<EntityDragon>(entityIn) || Util::instanceof<EntityWither>(entityIn) || Util::instanceof<EntityEnderCrystal>(entityIn)
+		|| Util::instanceof<EntityFallingBlock>(entityIn) || Util::instanceof<EntityFireworkRocket>(entityIn) || Util::instanceof<EntityTNTPrimed>(entityIn))
+	{
+		return ALWAYS_ACTIVE;
+	}
+
+	if (Util::instanceof<IMob>(entityIn))
+	{
+		return MONSTER;
+	}
+
+	if (Util::instanceof<INpc>(entityIn))
+	{
+		return VILLAGER;
+	}
+
+	if (Util::instanceof<IAnimals>(entityIn))
+	{
+		return ANIMAL;
+	}
+
+	return MISC;
+}
+
+void EntityActivationRange::setRange(Category category, int32_t blocks)
+{
+	if (category != ALWAYS_ACTIVE)
+	{
+		ranges[category] = blocks;
+	}
+}
+
+int32_t EntityActivationRange::getRange(Category category) const
+{
+	return category == ALWAYS_ACTIVE ? 0 : ranges[category];
+}
+
+void EntityActivationRange::readRanges(GameRules& rules)
+{
+	for (size_t category = 0; category < RANGE_RULES.size(); ++category)
+	{
+		ranges[category] = rules.getInt(RANGE_RULES[category]);
+	}
+}
+
+void EntityActivationRange::activateEntities(const EntitySpatialIndex& index, const std::vector<EntityPlayer*>& players, int64_t tick)
+{
+	statistics = {active.exchange(0), inactive.exchange(0)};
+	auto maxRange = getMaxRange();
+	if (maxRange <= 0)
+	{
+		return;
+	}
+
+	for (auto player : players)
+	{
+		auto aabb = player->getEntityBoundingBox().grow(maxRange);
+		index.forEachEntityWithinAABB(aabb, EntitySpatialIndex::ALL & ~EntitySpatialIndex::PLAYER, [&](Entity* entityIn)
+		{
+			if (entityIn->activatedTick >= tick)
+			{
+				return;
+			}
+
+			auto range = getRange(entityIn->getActivationCategory());
+			if (std::abs(entityIn->posX - player->posX) <= range && std::abs(entityIn->posY - player->posY) <= range
+				&& std::abs(entityIn->posZ - player->posZ) <= range)
+			{
+				entityIn->activatedTick = tick;
+			}
+		});
+	}
+}
+
+bool EntityActivationRange::checkIfActive(Entity* entityIn, int64_t tick)
+{
+	auto isActive = getRange(entityIn->getActivationCategory()) <= 0 || entityIn->activatedTick >= tick
+		|| entityIn->ticksExisted < WAKE_TICKS || entityIn->isRiding() || entityIn->isBeingRidden() || !entityIn->onGround
+		|| entityIn->isInWater() || entityIn->motionX * entityIn->motionX + entityIn->motionZ * entityIn->motionZ > MIN_MOTION * MIN_MOTION;
+	if (!isActive && Util::instanceof<EntityLivingBase>(entityIn))
+	{
+		auto entitylivingbase = (EntityLivingBase*)entityIn;
+		isActive = entitylivingbase->hurtTime > 0 || (Util::instanceof<EntityLiving>(entityIn) && ((EntityLiving*)entityIn)->getAttackTarget() != nullptr);
+	}
+
+	(isActive ? active : inactive).fetch_add(1, std::memory_order_relaxed);
+	return isActive;
+}
+
+EntityActivationRange::Statistics EntityActivationRange::getStatistics() const
+{
+	return statistics;
+}
+
+int32_t EntityActivationRange::getMaxRange() const
+{
+	return *std::max_element(ranges.begin(), ranges.end());
+}
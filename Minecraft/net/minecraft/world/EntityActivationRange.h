@@ -0,0 +1,60 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+class Entity;
+class EntityPlayer;
+class EntitySpatialIndex;
+class GameRules;
+
+// Entities further than their category's range from every player only get Entity::inactiveTick(), which
+// advances ages, fire and timers but skips AI, pathfinding and movement. Damage, a push or an attack target
+// wake an entity up early, and anything falling, moving, swimming or carrying a rider stays active anyway.
+class EntityActivationRange
+{
+public:
+	enum Category : uint8_t
+	{
+		MONSTER,
+		ANIMAL,
+		VILLAGER,
+		MISC,
+		ALWAYS_ACTIVE
+	};
+
+	struct Statistics
+	{
+		uint32_t active;
+		uint32_t inactive;
+	};
+
+	// how long damage, a push or a new target keeps an entity fully ticked
+	static constexpr int32_t WAKE_TICKS = 20;
+	// horizontal speed below which an entity counts as standing still
+	static constexpr double MIN_MOTION = 1.0E-2;
+
+	static Category getCategory(Entity* entityIn);
+	// A range of 0 or less keeps the whole category active.
+	void setRange(Category category, int32_t blocks);
+	int32_t getRange(Category category) const;
+	// Takes the ranges from the monsterActivationRange, animalActivationRange, villagerActivationRange and
+	// miscActivationRange game rules.
+	void readRanges(GameRules& rules);
+	// Marks every entity within its category's range of a player as active for tick.
+	void activateEntities(const EntitySpatialIndex& index, const std::vector<EntityPlayer*>& players, int64_t tick);
+	bool checkIfActive(Entity* entityIn, int64_t tick);
+	// Counts of the previous tick.
+	Statistics getStatistics() const;
+private:
+	static const std::array<std::string, ALWAYS_ACTIVE> RANGE_RULES;
+
+	std::array<int32_t, ALWAYS_ACTIVE> ranges = {32, 32, 32, 16};
+	std::atomic<uint32_t> active{0};
+	std::atomic<uint32_t> inactive{0};
+	Statistics statistics{0, 0};
+
+	int32_t getMaxRange() const;
+};
@@ -0,0 +1,19 @@
+#pragma once
+#include <cstdint>
+
+// Weak reference to an entity of a world: a slot of its EntitySlotMap and the generation the slot had when the
+// entity took it. Resolving a handle whose entity left the world gives nullptr instead of a dangling pointer.
+struct EntityHandle
+{
+	static constexpr uint32_t INVALID_INDEX = UINT32_MAX;
+
+	uint32_t index = INVALID_INDEX;
+	uint32_t generation = 0;
+
+	bool isValid() const
+	{
+		return index != INVALID_INDEX;
+	}
+
+	bool operator==(const EntityHandle& other) const = default;
+};
@@ -0,0 +1,203 @@
+#include "EntityPhysicsBatch.h"
+#include "World.h"
+#include "../entity/Entity.h"
+#include "../entity/MoverType.h"
+#include "../block/Block.h"
+
+#include <algorithm>
+
+void EntityPhysicsBatch::applyDrag(Entity* entityIn, const Drag& drag)
+{
+	auto factors = getDragFactors(entityIn, drag);
+	entityIn->motionX = entityIn->motionX * factors.horizontal * factors.groundHorizontal;
+	entityIn->motionY = entityIn->motionY * factors.vertical * factors.groundVertical;
+	entityIn->motionZ = entityIn->motionZ * factors.horizontal * factors.groundHorizontal;
+}
+
+void EntityPhysicsBatch::add(Entity* entityIn, double gravityIn, const Drag& drag)
+{
+	bodies.emplace_back(entityIn);
+	gravity.emplace_back(gravityIn);
+	drags.emplace_back(drag);
+}
+
+void EntityPhysicsBatch::run(World* worldIn)
+{
+	statistics = {bodies.size(), 0};
+	if (bodies.empty())
+	{
+		return;
+	}
+
+	gather();
+	integrate();
+	findUnobstructed(worldIn);
+	scatter();
+	applyDrag();
+
+	for (auto body : bodies)
+	{
+		if (!body->isDead)
+		{
+			body->onPhysicsUpdate();
+		}
+	}
+
+	bodies.clear();
+	gravity.clear();
+	drags.clear();
+}
+
+size_t EntityPhysicsBatch::size() const
+{
+	return bodies.size();
+}
+
+EntityPhysicsBatch::Statistics EntityPhysicsBatch::getStatistics() const
+{
+	return statistics;
+}
+
+void EntityPhysicsBatch::gather()
+{
+	auto count = bodies.size();
+	for (auto component : {&motionX, &motionY, &motionZ, &minX, &minY, &minZ, &maxX, &maxY, &maxZ})
+	{
+		component->resize(count);
+	}
+
+	unobstructed.assign(count, 0);
+	for (size_t i = 0; i < count; ++i)
+	{
+		auto body = bodies[i];
+		auto box = body->getEntityBoundingBox();
+		motionX[i] = body->motionX;
+		motionY[i] = body->motionY;
+		motionZ[i] = body->motionZ;
+		minX[i] = box.getminX();
+		minY[i] = box.getminY();
+		minZ[i] = box.getminZ();
+		maxX[i] = box.getmaxX();
+		maxY[i] = box.getmaxY();
+		maxZ[i] = box.getmaxZ();
+	}
+}
+
+void EntityPhysicsBatch::integrate()
+{
+	auto count = bodies.size();
+	for (size_t i = 0; i < count; ++i)
+	{
+		motionY[i] -= gravity[i];
+	}
+
+	// the boxes become the volume swept by this tick's motion
+	for (size_t i = 0; i < count; ++i)
+	{
+		minX[i] += std::min(motionX[i], 0.0);
+		minY[i] += std::min(motionY[i], 0.0);
+		minZ[i] += std::min(motionZ[i], 0.0);
+		maxX[i] += std::max(motionX[i], 0.0);
+		maxY[i] += std::max(motionY[i], 0.0);
+		maxZ[i] += std::max(motionZ[i], 0.0);
+	}
+}
+
+void EntityPhysicsBatch::findUnobstructed(World* worldIn)
+{
+	for (size_t i = 0; i < bodies.size(); ++i)
+	{
+		auto body = bodies[i];
+		// a body on the ground almost always touches it, move() gathers the same boxes anyway
+		if (body->isDead || body->onGround || !body->canMoveUnobstructed())
+		{
+			continue;
+		}
+
+		collisionBoxes.clear();
+		worldIn->getCollisionBoxes(body, AxisAlignedBB(minX[i], minY[i], minZ[i], maxX[i], maxY[i], maxZ[i]), collisionBoxes);
+		if (collisionBoxes.empty())
+		{
+			unobstructed[i] = 1;
+			++statistics.unobstructed;
+		}
+	}
+}
+
+void EntityPhysicsBatch::scatter()
+{
+	for (size_t i = 0; i < bodies.size(); ++i)
+	{
+		auto body = bodies[i];
+		if (body->isDead)
+		{
+			continue;
+		}
+
+		body->motionY = motionY[i];
+		if (unobstructed[i] != 0)
+		{
+			body->moveUnobstructed(motionX[i], motionY[i], motionZ[i]);
+		}
+		else
+		{
+			body->move(MoverType::SELF, motionX[i], motionY[i], motionZ[i]);
+		}
+	}
+}
+
+void EntityPhysicsBatch::applyDrag()
+{
+	// the factors depend on where each body ended up, only the multiplication is left to plain loops
+	auto count = bodies.size();
+	for (auto component : {&horizontalDrag, &verticalDrag, &groundHorizontalDrag, &groundVerticalDrag})
+	{
+		component->resize(count);
+	}
+
+	for (size_t i = 0; i < count; ++i)
+	{
+		auto body = bodies[i];
+		auto factors = body->isDead ? DragFactors{1.0, 1.0, 1.0, 1.0} : getDragFactors(body, drags[i]);
+		motionX[i] = body->motionX;
+		motionY[i] = body->motionY;
+		motionZ[i] = body->motionZ;
+		horizontalDrag[i] = factors.horizontal;
+		verticalDrag[i] = factors.vertical;
+		groundHorizontalDrag[i] = factors.groundHorizontal;
+		groundVerticalDrag[i] = factors.groundVertical;
+	}
+
+	for (size_t i = 0; i < count; ++i)
+	{
+		motionX[i] = motionX[i] * horizontalDrag[i] * groundHorizontalDrag[i];
+		motionY[i] = motionY[i] * verticalDrag[i] * groundVerticalDrag[i];
+		motionZ[i] = motionZ[i] * horizontalDrag[i] * groundHorizontalDrag[i];
+	}
+
+	for (size_t i = 0; i < count; ++i)
+	{
+		auto body = bodies[i];
+		body->motionX = motionX[i];
+		body->motionY = motionY[i];
+		body->motionZ = motionZ[i];
+	}
+}
+
+EntityPhysicsBatch::DragFactors EntityPhysicsBatch::getDragFactors(Entity* entityIn, const Drag& drag)
+{
+	if (!entityIn->onGround)
+	{
+		return {drag.horizontal, drag.vertical, 1.0, 1.0};
+	}
+
+	auto horizontal = drag.horizontal;
+	if (drag.slippery)
+	{
+		auto world = entityIn->world;
+		auto below = BlockPos(MathHelper::floor(entityIn->posX), MathHelper::floor(entityIn->getEntityBoundingBox().getminY()) - 1, MathHelper::floor(entityIn->posZ));
+		horizontal = world->getBlockState(below)->getBlock()->slipperiness * drag.horizontal;
+	}
+
+	return {horizontal, drag.vertical, drag.groundHorizontal, drag.groundVertical};
+}
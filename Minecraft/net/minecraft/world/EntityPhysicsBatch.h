@@ -0,0 +1,79 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "math/AxisAlignedBB.h"
+
+class Entity;
+class World;
+
+// The gravity and move() step of dropped items, XP orbs, falling blocks and primed TNT, run for all of them at once
+// after the entity tick. Positions and motion are gathered into one array per component so gravity and the swept
+// boxes are computed in loops the compiler vectorises. Bodies in the air whose swept box meets no collision box are
+// moved without clipping; the rest go through move(). Drag and ground friction are multiplied in the same way,
+// then each body runs its onPhysicsUpdate(), in queue order.
+class EntityPhysicsBatch
+{
+public:
+	struct Statistics
+	{
+		size_t bodies;
+		size_t unobstructed;
+	};
+
+	// Motion factors applied right after the move. On the ground the horizontal factor is scaled by the
+	// slipperiness of the block below when slippery is set, then the ground factors are applied on top.
+	struct Drag
+	{
+		float horizontal;
+		float vertical;
+		bool slippery;
+		double groundHorizontal;
+		double groundVertical;
+	};
+
+	static constexpr Drag NO_DRAG{1.0F, 1.0F, false, 1.0, 1.0};
+
+	// What the batch does to a body's motion after its move, for callers moving it themselves.
+	static void applyDrag(Entity* entityIn, const Drag& drag);
+	void add(Entity* entityIn, double gravity, const Drag& drag);
+	void run(World* worldIn);
+	size_t size() const;
+	Statistics getStatistics() const;
+private:
+	struct DragFactors
+	{
+		double horizontal;
+		double vertical;
+		double groundHorizontal;
+		double groundVertical;
+	};
+
+	std::vector<Entity*> bodies;
+	std::vector<double> gravity;
+	std::vector<Drag> drags;
+	std::vector<double> horizontalDrag;
+	std::vector<double> verticalDrag;
+	std::vector<double> groundHorizontalDrag;
+	std::vector<double> groundVerticalDrag;
+	std::vector<double> motionX;
+	std::vector<double> motionY;
+	std::vector<double> motionZ;
+	std::vector<double> minX;
+	std::vector<double> minY;
+	std::vector<double> minZ;
+	std::vector<double> maxX;
+	std::vector<double> maxY;
+	std::vector<double> maxZ;
+	std::vector<uint8_t> unobstructed;
+	std::vector<AxisAlignedBB> collisionBoxes;
+	Statistics statistics{};
+
+	void gather();
+	void integrate();
+	void findUnobstructed(World* worldIn);
+	void scatter();
+	void applyDrag();
+
+	static DragFactors getDragFactors(Entity* entityIn, const Drag& drag);
+};
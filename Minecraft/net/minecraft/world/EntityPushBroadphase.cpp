@@ -0,0 +1,190 @@
+#include "EntityPushBroadphase.h"
+#include "../entity/EntityLivingBase.h"
+#include "../util/EntitySelectors.h"
+#include "../util/math/MathHelper.h"
+
+#include <algorithm>
+
+void EntityPushBroadphase::requestPush(EntityLivingBase* entityIn)
+{
+	pending.emplace_back(entityIn);
+}
+
+void EntityPushBroadphase::resolve(const std::vector<Entity*>& entities, int32_t maxEntityCramming)
+{
+	statistics = {};
+	if (pending.empty())
+	{
+		return;
+	}
+
+	gatherParticipants(entities);
+	findPairs();
+	applyPushes(maxEntityCramming);
+	pending.clear();
+}
+
+size_t EntityPushBroadphase::getPendingCount() const
+{
+	return pending.size();
+}
+
+EntityPushBroadphase::Statistics EntityPushBroadphase::getStatistics() const
+{
+	return statistics;
+}
+
+int64_t EntityPushBroadphase::getBand(double z)
+{
+	return static_cast<int64_t>(MathHelper::floor(z)) >> BAND_SHIFT;
+}
+
+void EntityPushBroadphase::gatherParticipants(const std::vector<Entity*>& entities)
+{
+	pushers.clear();
+	pusherIndex.clear();
+	participants.clear();
+	for (auto entity : pending)
+	{
+		// an entity that ticked twice still pushes once
+		if (entity->isDead || !pusherIndex.emplace(entity, static_cast<uint32_t>(pushers.size())).second)
+		{
+			continue;
+		}
+
+		participants.push_back({entity, entity->getEntityBoundingBox(), static_cast<uint32_t>(pushers.size())});
+		pushers.emplace_back(entity);
+	}
+
+	for (auto entity : entities)
+	{
+		if (!entity->isDead && entity->canBePushed() && pusherIndex.find(entity) == pusherIndex.end())
+		{
+			participants.push_back({entity, entity->getEntityBoundingBox(), NOT_PUSHER});
+		}
+	}
+
+	statistics.pushers = pushers.size();
+	statistics.candidates = participants.size();
+}
+
+void EntityPushBroadphase::findPairs()
+{
+	proxies.clear();
+	oversized.clear();
+	contacts.clear();
+	for (uint32_t i = 0; i < participants.size(); ++i)
+	{
+		auto& box = participants[i].box;
+		auto minBand = getBand(box.getminZ());
+		auto maxBand = getBand(box.getmaxZ());
+		if (maxBand - minBand >= MAX_BANDS)
+		{
+			oversized.emplace_back(i);
+			continue;
+		}
+
+		for (auto band = minBand; band <= maxBand; ++band)
+		{
+			proxies.push_back({band, box.getminX(), i});
+		}
+	}
+
+	std::sort(proxies.begin(), proxies.end(), [](const Proxy& lhs, const Proxy& rhs)
+	{
+		if (lhs.band != rhs.band)
+		{
+			return lhs.band < rhs.band;
+		}
+
+		return lhs.minX != rhs.minX ? lhs.minX < rhs.minX : lhs.participant < rhs.participant;
+	});
+
+	for (size_t begin = 0; begin < proxies.size();)
+	{
+		auto band = proxies[begin].band;
+		auto end = begin;
+		active.clear();
+		for (; end < proxies.size() && proxies[end].band == band; ++end)
+		{
+			auto& proxy = proxies[end];
+			auto& box = participants[proxy.participant].box;
+			active.erase(std::remove_if(active.begin(), active.end(), [&](uint32_t other)
+			{
+				return participants[other].box.getmaxX() <= proxy.minX;
+			}), active.end());
+
+			for (auto other : active)
+			{
+				auto& otherBox = participants[other].box;
+				// a pair whose boxes share several bands is only reported in the band where the later one starts
+				if (box.intersects(otherBox) && std::max(getBand(box.getminZ()), getBand(otherBox.getminZ())) == band)
+				{
+					addPair(other, proxy.participant);
+				}
+			}
+
+			active.emplace_back(proxy.participant);
+		}
+
+		begin = end;
+	}
+
+	for (size_t i = 0; i < oversized.size(); ++i)
+	{
+		auto& box = participants[oversized[i]].box;
+		for (uint32_t other = 0; other < participants.size(); ++other)
+		{
+			auto& otherBox = participants[other].box;
+			auto otherOversized = getBand(otherBox.getmaxZ()) - getBand(otherBox.getminZ()) >= MAX_BANDS;
+			if (other != oversized[i] && !(otherOversized && other < oversized[i]) && box.intersects(otherBox))
+			{
+				addPair(oversized[i], other);
+			}
+		}
+	}
+}
+
+void EntityPushBroadphase::addPair(uint32_t first, uint32_t second)
+{
+	auto& firstParticipant = participants[first];
+	auto& secondParticipant = participants[second];
+	++statistics.pairs;
+	if (firstParticipant.pusher != NOT_PUSHER && EntitySelectors::canTeamCollide(firstParticipant.entity, secondParticipant.entity))
+	{
+		contacts.emplace_back(firstParticipant.pusher, secondParticipant.entity);
+	}
+
+	if (secondParticipant.pusher != NOT_PUSHER && EntitySelectors::canTeamCollide(secondParticipant.entity, firstParticipant.entity))
+	{
+		contacts.emplace_back(secondParticipant.pusher, firstParticipant.entity);
+	}
+}
+
+void EntityPushBroadphase::applyPushes(int32_t maxEntityCramming)
+{
+	// bucket the contacts by pusher, counting sort keeps them in the order they were found
+	contactOffsets.assign(pushers.size() + 1, 0);
+	for (auto& contact : contacts)
+	{
+		++contactOffsets[contact.first + 1];
+	}
+
+	for (size_t i = 1; i < contactOffsets.size(); ++i)
+	{
+		contactOffsets[i] += contactOffsets[i - 1];
+	}
+
+	sortedContacts.resize(contacts.size());
+	for (auto& contact : contacts)
+	{
+		sortedContacts[contactOffsets[contact.first]++] = contact.second;
+	}
+
+	for (size_t i = 0; i < pushers.size(); ++i)
+	{
+		auto begin = i == 0 ? 0 : contactOffsets[i - 1];
+		neighbours.assign(sortedContacts.begin() + begin, sortedContacts.begin() + contactOffsets[i]);
+		pushers[i]->collideWithEntities(neighbours, maxEntityCramming);
+	}
+}
@@ -0,0 +1,70 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+#include "math/AxisAlignedBB.h"
+
+class Entity;
+class EntityLivingBase;
+
+// Entity pushing and cramming resolved once per tick instead of one box query per living entity. Living entities
+// queue themselves where they used to look for neighbours; resolve() sorts the boxes of every band of z by their
+// minimum x, sweeps each band to find every overlapping pair once and gives both sides of a pair to each other,
+// so the push is applied in both directions and the cramming count comes out of the same pass.
+class EntityPushBroadphase
+{
+public:
+	struct Statistics
+	{
+		size_t pushers;
+		size_t candidates;
+		size_t pairs;
+	};
+
+	static constexpr int32_t BAND_SHIFT = 3;
+	// boxes spanning more bands than this are kept apart and tested against everything
+	static constexpr int32_t MAX_BANDS = 4;
+
+	void requestPush(EntityLivingBase* entityIn);
+	// Pushes every queued entity away from the pushable entities among entities that its box intersects.
+	void resolve(const std::vector<Entity*>& entities, int32_t maxEntityCramming);
+	size_t getPendingCount() const;
+	Statistics getStatistics() const;
+private:
+	struct Participant
+	{
+		Entity* entity;
+		AxisAlignedBB box;
+		// index into pushers, or NOT_PUSHER for entities that are only pushed
+		uint32_t pusher;
+	};
+
+	struct Proxy
+	{
+		int64_t band;
+		double minX;
+		uint32_t participant;
+	};
+
+	static constexpr uint32_t NOT_PUSHER = UINT32_MAX;
+
+	std::vector<EntityLivingBase*> pending;
+	std::vector<EntityLivingBase*> pushers;
+	std::unordered_map<Entity*, uint32_t> pusherIndex;
+	std::vector<Participant> participants;
+	std::vector<Proxy> proxies;
+	std::vector<uint32_t> oversized;
+	std::vector<uint32_t> active;
+	std::vector<std::pair<uint32_t, Entity*>> contacts;
+	std::vector<uint32_t> contactOffsets;
+	std::vector<Entity*> sortedContacts;
+	std::vector<Entity*> neighbours;
+	Statistics statistics{};
+
+	static int64_t getBand(double z);
+	void gatherParticipants(const std::vector<Entity*>& entities);
+	void findPairs();
+	void addPair(uint32_t first, uint32_t second);
+	void applyPushes(int32_t maxEntityCramming);
+};
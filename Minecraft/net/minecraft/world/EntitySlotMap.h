@@ -0,0 +1,178 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "EntityHandle.h"
+
+class Entity;
+
+// The entities of a world in generational slots. Freed slots are reused with a new generation, so stale handles
+// resolve to nullptr. Network ids find their slot through pages indexed by the id itself; ids are handed out in
+// sequence, so the pages of long gone ids are empty and released. Stored types only need getEntityId(),
+// getHandle() and setHandle(), which lets the tests use a stand-in instead of a full Entity.
+template <typename EntityType>
+class BasicEntitySlotMap
+{
+public:
+	static constexpr int32_t PAGE_SHIFT = 12;
+	static constexpr int32_t PAGE_SIZE = 1 << PAGE_SHIFT;
+
+	// Gives entityIn a slot, stores its handle on it and registers its id.
+	EntityHandle add(EntityType* entityIn);
+	void remove(EntityType* entityIn);
+	EntityType* get(EntityHandle handle) const;
+	EntityType* getById(int32_t id) const;
+	size_t size() const;
+private:
+	struct Slot
+	{
+		EntityType* entity = nullptr;
+		uint32_t generation = 0;
+		uint32_t nextFree = EntityHandle::INVALID_INDEX;
+	};
+
+	struct IdPage
+	{
+		std::array<uint32_t, PAGE_SIZE> slots;
+		uint32_t used = 0;
+	};
+
+	std::vector<Slot> slots;
+	uint32_t freeHead = EntityHandle::INVALID_INDEX;
+	size_t count = 0;
+	std::vector<std::unique_ptr<IdPage>> idPages;
+
+	void setId(int32_t id, uint32_t slot);
+	void clearId(int32_t id, uint32_t slot);
+};
+
+using EntitySlotMap = BasicEntitySlotMap<Entity>;
+
+template <typename EntityType>
+EntityHandle BasicEntitySlotMap<EntityType>::add(EntityType* entityIn)
+{
+	uint32_t index;
+	if (freeHead != EntityHandle::INVALID_INDEX)
+	{
+		index = freeHead;
+		freeHead = slots[index].nextFree;
+	}
+	else
+	{
+		index = static_cast<uint32_t>(slots.size());
+		slots.emplace_back();
+	}
+
+	auto& slot = slots[index];
+	slot.entity = entityIn;
+	slot.nextFree = EntityHandle::INVALID_INDEX;
+	++count;
+
+	EntityHandle handle{index, slot.generation};
+	entityIn->setHandle(handle);
+	setId(entityIn->getEntityId(), index);
+	return handle;
+}
+
+template <typename EntityType>
+void BasicEntitySlotMap<EntityType>::remove(EntityType* entityIn)
+{
+	auto handle = entityIn->getHandle();
+	if (get(handle) != entityIn)
+	{
+		return;
+	}
+
+	auto& slot = slots[handle.index];
+	clearId(entityIn->getEntityId(), handle.index);
+	slot.entity = nullptr;
+	++slot.generation;
+	slot.nextFree = freeHead;
+	freeHead = handle.index;
+	--count;
+	entityIn->setHandle(EntityHandle());
+}
+
+template <typename EntityType>
+EntityType* BasicEntitySlotMap<EntityType>::get(EntityHandle handle) const
+{
+	if (handle.index >= slots.size())
+	{
+		return nullptr;
+	}
+
+	auto& slot = slots[handle.index];
+	return slot.generation == handle.generation ? slot.entity : nullptr;
+}
+
+template <typename EntityType>
+EntityType* BasicEntitySlotMap<EntityType>::getById(int32_t id) const
+{
+	auto page = static_cast<size_t>(id) >> PAGE_SHIFT;
+	if (id < 0 || page >= idPages.size() || idPages[page] == nullptr)
+	{
+		return nullptr;
+	}
+
+	auto index = idPages[page]->slots[id & (PAGE_SIZE - 1)];
+	return index == EntityHandle::INVALID_INDEX ? nullptr : slots[index].entity;
+}
+
+template <typename EntityType>
+size_t BasicEntitySlotMap<EntityType>::size() const
+{
+	return count;
+}
+
+template <typename EntityType>
+void BasicEntitySlotMap<EntityType>::setId(int32_t id, uint32_t slot)
+{
+	if (id < 0)
+	{
+		return;
+	}
+
+	auto page = static_cast<size_t>(id) >> PAGE_SHIFT;
+	if (page >= idPages.size())
+	{
+		idPages.resize(page + 1);
+	}
+
+	if (idPages[page] == nullptr)
+	{
+		idPages[page] = std::make_unique<IdPage>();
+		idPages[page]->slots.fill(EntityHandle::INVALID_INDEX);
+	}
+
+	auto& entry = idPages[page]->slots[id & (PAGE_SIZE - 1)];
+	if (entry == EntityHandle::INVALID_INDEX)
+	{
+		++idPages[page]->used;
+	}
+
+	entry = slot;
+}
+
+template <typename EntityType>
+void BasicEntitySlotMap<EntityType>::clearId(int32_t id, uint32_t slot)
+{
+	auto page = static_cast<size_t>(id) >> PAGE_SHIFT;
+	if (id < 0 || page >= idPages.size() || idPages[page] == nullptr)
+	{
+		return;
+	}
+
+	auto& entry = idPages[page]->slots[id & (PAGE_SIZE - 1)];
+	if (entry != slot)
+	{
+		return;
+	}
+
+	entry = EntityHandle::INVALID_INDEX;
+	if (--idPages[page]->used == 0)
+	{
+		idPages[page].reset();
+	}
+}
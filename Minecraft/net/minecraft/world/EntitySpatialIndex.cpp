@@ -0,0 +1,175 @@
+#include "EntitySpatialIndex.h"
+#include "../entity/EntityHanging.h"
+#include "../entity/EntityLivingBase.h"
+#include "../entity/IProjectile.h"
+#include "../entity/item/EntityBoat.h"
+#include "../entity/item/EntityItem.h"
+#include "../entity/item/EntityMinecart.h"
+#include "../entity/item/EntityXPOrb.h"
+#include "../entity/monster/IMob.h"
+#include "../entity/passive/IAnimals.h"
+#include "../entity/player/EntityPlayer.h"
+#include "../util/Util.h"
+
+uint32_t EntitySpatialIndex::getCategories(Entity* entityIn)
+{
+	uint32_t categories = 0;
+	if (Util::instanceof<EntityPlayer>(entityIn))
+	{
+		categories |= PLAYER;
+	}
+
+	if (Util::instanceof<EntityLivingBase>(entityIn))
+	{
+		categories |= LIVING;
+	}
+
+	if (Util::instanceof<IMob>(entityIn))
+	{
+		categories |= MONSTER;
+	}
+	else if (Util::instanceof<IAnimals>(entityIn))
+	{
+		categories |= ANIMAL;
+	}
+
+	if (Util::instanceof<EntityItem>(entityIn))
+	{
+		categories |= ITEM;
+	}
+	else if (Util::instanceof<EntityXPOrb>(entityIn))
+	{
+		categories |= XP_ORB;
+	}
+	else if (Util::instanceof<IProjectile>(entityIn))
+	{
+		categories |= PROJECTILE;
+	}
+	else if (Util::instanceof<EntityMinecart>(entityIn) || Util::instanceof<EntityBoat>(entityIn))
+	{
+		categories |= VEHICLE;
+	}
+	else if (Util::instanceof<EntityHanging>(entityIn))
+	{
+		categories |= HANGING;
+	}
+
+	return categories == 0 ? OTHER : categories;
+}
+
+void EntitySpatialIndex::add(Entity* entityIn)
+{
+	if (locations.find(entityIn) == locations.end())
+	{
+		insert(entityIn, entityIn->getEntityBoundingBox(), getCategories(entityIn));
+	}
+}
+
+void EntitySpatialIndex::remove(Entity* entityIn)
+{
+	auto location = locations.find(entityIn);
+	if (location != locations.end())
+	{
+		erase(location->second);
+		locations.erase(location);
+	}
+}
+
+void EntitySpatialIndex::update(Entity* entityIn)
+{
+	auto location = locations.find(entityIn);
+	if (location == locations.end())
+	{
+		return;
+	}
+
+	auto aabb = entityIn->getEntityBoundingBox();
+	auto oversize = isOversized(aabb);
+	auto key = getKey(MathHelper::floor(aabb.getminX()) >> CELL_SHIFT, MathHelper::floor(aabb.getminY()) >> CELL_SHIFT, MathHelper::floor(aabb.getminZ()) >> CELL_SHIFT);
+	if (oversize == location->second.oversized && (oversize || key == location->second.key))
+	{
+		return;
+	}
+
+	auto categories = location->second.categories;
+	erase(location->second);
+	locations.erase(location);
+	insert(entityIn, aabb, categories);
+}
+
+void EntitySpatialIndex::clear()
+{
+	cells.clear();
+	locations.clear();
+	oversized = Cell();
+}
+
+size_t EntitySpatialIndex::size() const
+{
+	return locations.size();
+}
+
+void EntitySpatialIndex::getEntitiesWithinAABB(const AxisAlignedBB& aabb, uint32_t categories, std::vector<Entity*>& listToFill) const
+{
+	forEachEntityWithinAABB(aabb, categories, [&listToFill](Entity* entity)
+	{
+		listToFill.emplace_back(entity);
+	});
+}
+
+bool EntitySpatialIndex::isOversized(const AxisAlignedBB& aabb)
+{
+	return aabb.getmaxX() - aabb.getminX() > MAX_EXTENT || aabb.getmaxY() - aabb.getminY() > MAX_EXTENT || aabb.getmaxZ() - aabb.getminZ() > MAX_EXTENT
+		|| aabb.hasNaN();
+}
+
+void EntitySpatialIndex::insert(Entity* entityIn, const AxisAlignedBB& aabb, uint32_t categories)
+{
+	Location location{0, 0, categories, isOversized(aabb)};
+	Cell* cell = &oversized;
+	if (!location.oversized)
+	{
+		location.key = getKey(MathHelper::floor(aabb.getminX()) >> CELL_SHIFT, MathHelper::floor(aabb.getminY()) >> CELL_SHIFT, MathHelper::floor(aabb.getminZ()) >> CELL_SHIFT);
+		cell = &cells[location.key];
+	}
+
+	location.index = static_cast<uint32_t>(cell->entities.size());
+	cell->entities.emplace_back(entityIn);
+	cell->categories.emplace_back(categories);
+	cell->mask |= categories;
+	locations.emplace(entityIn, location);
+}
+
+void EntitySpatialIndex::erase(const Location& location)
+{
+	auto ite = cells.end();
+	Cell* cell = &oversized;
+	if (!location.oversized)
+	{
+		ite = cells.find(location.key);
+		cell = &ite->second;
+	}
+
+	// swap with the last entry and patch its location, then rebuild the mask from what is left
+	auto last = cell->entities.size() - 1;
+	if (location.index != last)
+	{
+		cell->entities[location.index] = cell->entities[last];
+		cell->categories[location.index] = cell->categories[last];
+		locations.at(cell->entities[location.index]).index = location.index;
+	}
+
+	cell->entities.pop_back();
+	cell->categories.pop_back();
+	if (cell->entities.empty() && ite != cells.end())
+	{
+		cells.erase(ite);
+		return;
+	}
+
+	cell->mask = 0;
+	for (auto categories : cell->categories)
+	{
+		cell->mask |= categories;
+	}
+}
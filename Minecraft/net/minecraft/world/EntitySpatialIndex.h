@@ -0,0 +1,211 @@
+#pragma once
+#include <algorithm>
+#include <cstdint>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+#include "../entity/Entity.h"
+#include "../util/math/MathHelper.h"
+#include "math/AxisAlignedBB.h"
+
+class EntityBoat;
+class EntityHanging;
+class EntityItem;
+class EntityLiving;
+class EntityLivingBase;
+class EntityMinecart;
+class EntityPlayer;
+class EntityPlayerMP;
+class EntityXPOrb;
+class IMob;
+class IProjectile;
+
+// Broad phase for entity box queries. Entities are hashed into 8 block cells by the minimum corner of
+// their box, and every cell keeps a mask of the categories it holds so that, say, an item query skips
+// cells with nothing but mobs in them. Queries visit candidates in place and never allocate.
+class EntitySpatialIndex
+{
+public:
+	enum Category : uint32_t
+	{
+		PLAYER = 1 << 0,
+		ITEM = 1 << 1,
+		XP_ORB = 1 << 2,
+		LIVING = 1 << 3,
+		MONSTER = 1 << 4,
+		ANIMAL = 1 << 5,
+		PROJECTILE = 1 << 6,
+		VEHICLE = 1 << 7,
+		HANGING = 1 << 8,
+		OTHER = 1 << 9,
+		ALL = 0xFFFFFFFF
+	};
+
+	static constexpr int32_t CELL_SHIFT = 3;
+	static constexpr int32_t MIN_CELL_Y = -2048;
+	static constexpr int32_t MAX_CELL_Y = 2047;
+	// entities wider or taller than this are kept apart and checked by every query
+	static constexpr double MAX_EXTENT = 4.0;
+	// how far an entity may drift from its indexed box between two updates, same slack the chunk lists use
+	static constexpr double SLACK = 2.0;
+
+	static uint32_t getCategories(Entity* entityIn);
+	// Categories that can hold a Class; exact when isExactCategory<Class>() so no per-entity type check is needed.
+	template <class Class>
+	static constexpr uint32_t getCategories();
+	template <class Class>
+	static constexpr bool isExactCategory();
+	void add(Entity* entityIn);
+	void remove(Entity* entityIn);
+	void update(Entity* entityIn);
+	void clear();
+	size_t size() const;
+
+	// Calls visitor for every indexed entity of one of the given categories whose current box intersects aabb.
+	template <typename Visitor>
+	void forEachEntityWithinAABB(const AxisAlignedBB& aabb, uint32_t categories, Visitor&& visitor) const;
+	void getEntitiesWithinAABB(const AxisAlignedBB& aabb, uint32_t categories, std::vector<Entity*>& listToFill) const;
+private:
+	struct Cell
+	{
+		std::vector<Entity*> entities;
+		std::vector<uint32_t> categories;
+		uint32_t mask = 0;
+	};
+
+	struct Location
+	{
+		int64_t key;
+		uint32_t index;
+		uint32_t categories;
+		bool oversized;
+	};
+
+	std::unordered_map<int64_t, Cell> cells;
+	std::unordered_map<Entity*, Location> locations;
+	Cell oversized;
+
+	static int64_t getKey(int32_t x, int32_t y, int32_t z);
+	static bool isOversized(const AxisAlignedBB& aabb);
+	void insert(Entity* entityIn, const AxisAlignedBB& aabb, uint32_t categories);
+	void erase(const Location& location);
+};
+
+inline int64_t EntitySpatialIndex::getKey(int32_t x, int32_t y, int32_t z)
+{
+	return (static_cast<int64_t>(x & 0x3FFFFFF) << 38) | (static_cast<int64_t>(z & 0x3FFFFFF) << 12) | static_cast<int64_t>(std::clamp(y, MIN_CELL_Y, MAX_CELL_Y) & 0xFFF);
+}
+
+template <class Class>
+constexpr uint32_t EntitySpatialIndex::getCategories()
+{
+	if constexpr (std::is_same_v<Class, EntityPlayer> || std::is_same_v<Class, EntityPlayerMP>)
+	{
+		return PLAYER;
+	}
+	else if constexpr (std::is_same_v<Class, EntityItem>)
+	{
+		return ITEM;
+	}
+	else if constexpr (std::is_same_v<Class, EntityXPOrb>)
+	{
+		return XP_ORB;
+	}
+	else if constexpr (std::is_same_v<Class, EntityLivingBase> || std::is_same_v<Class, EntityLiving>)
+	{
+		return LIVING;
+	}
+	else if constexpr (std::is_same_v<Class, IMob>)
+	{
+		return MONSTER;
+	}
+	else if constexpr (std::is_same_v<Class, IProjectile>)
+	{
+		return PROJECTILE;
+	}
+	else if constexpr (std::is_same_v<Class, EntityMinecart> || std::is_same_v<Class, EntityBoat>)
+	{
+		return VEHICLE;
+	}
+	else if constexpr (std::is_same_v<Class, EntityHanging>)
+	{
+		return HANGING;
+	}
+	else
+	{
+		return ALL;
+	}
+}
+
+template <class Class>
+constexpr bool EntitySpatialIndex::isExactCategory()
+{
+	return std::is_same_v<Class, Entity> || std::is_same_v<Class, EntityPlayer> || std::is_same_v<Class, EntityItem>
+		|| std::is_same_v<Class, EntityXPOrb> || std::is_same_v<Class, EntityLivingBase> || std::is_same_v<Class, IMob>
+		|| std::is_same_v<Class, IProjectile> || std::is_same_v<Class, EntityHanging>;
+}
+
+template <typename Visitor>
+void EntitySpatialIndex::forEachEntityWithinAABB(const AxisAlignedBB& aabb, uint32_t categories, Visitor&& visitor) const
+{
+	auto visitCell = [&](const Cell& cell)
+	{
+		if ((cell.mask & categories) == 0)
+		{
+			return;
+		}
+
+		for (size_t i = 0; i < cell.entities.size(); ++i)
+		{
+			if ((cell.categories[i] & categories) != 0 && cell.entities[i]->getEntityBoundingBox().intersects(aabb))
+			{
+				visitor(cell.entities[i]);
+			}
+		}
+	};
+
+	visitCell(oversized);
+	if (cells.empty())
+	{
+		return;
+	}
+
+	auto minX = MathHelper::floor(aabb.getminX() - MAX_EXTENT - SLACK) >> CELL_SHIFT;
+	auto minY = std::max(MathHelper::floor(aabb.getminY() - MAX_EXTENT - SLACK) >> CELL_SHIFT, MIN_CELL_Y);
+	auto minZ = MathHelper::floor(aabb.getminZ() - MAX_EXTENT - SLACK) >> CELL_SHIFT;
+	auto maxX = MathHelper::floor(aabb.getmaxX() + SLACK) >> CELL_SHIFT;
+	auto maxY = std::min(MathHelper::floor(aabb.getmaxY() + SLACK) >> CELL_SHIFT, MAX_CELL_Y);
+	auto maxZ = MathHelper::floor(aabb.getmaxZ() + SLACK) >> CELL_SHIFT;
+	if (minY > maxY)
+	{
+		return;
+	}
+
+	auto volume = static_cast<uint64_t>(maxX - minX + 1) * static_cast<uint64_t>(maxY - minY + 1) * static_cast<uint64_t>(maxZ - minZ + 1);
+
+	if (volume > cells.size())
+	{
+		// a huge box touches more cells than exist, walking the occupied ones is cheaper
+		for (auto& cell : cells)
+		{
+			visitCell(cell.second);
+		}
+
+		return;
+	}
+
+	for (auto x = minX; x <= maxX; ++x)
+	{
+		for (auto z = minZ; z <= maxZ; ++z)
+		{
+			for (auto y = minY; y <= maxY; ++y)
+			{
+				auto cell = cells.find(getKey(x, y, z));
+				if (cell != cells.end())
+				{
+					visitCell(cell->second);
+				}
+			}
+		}
+	}
+}
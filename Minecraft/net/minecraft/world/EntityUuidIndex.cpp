@@ -0,0 +1,116 @@
+#include "EntityUuidIndex.h"
+
+#include <cstring>
+
+void EntityUuidIndex::put(const xg::Guid& uuid, Entity* entityIn)
+{
+	if ((count + 1) * 4 > entries.size() * 3)
+	{
+		grow();
+	}
+
+	auto mask = entries.size() - 1;
+	for (auto i = hash(uuid) & mask;; i = (i + 1) & mask)
+	{
+		auto& entry = entries[i];
+		if (entry.entity == nullptr)
+		{
+			entry.uuid = uuid;
+			entry.entity = entityIn;
+			++count;
+			return;
+		}
+
+		if (entry.uuid == uuid)
+		{
+			entry.entity = entityIn;
+			return;
+		}
+	}
+}
+
+void EntityUuidIndex::remove(const xg::Guid& uuid)
+{
+	auto i = find(uuid);
+	if (i == entries.size())
+	{
+		return;
+	}
+
+	// pull back every following entry of the cluster that may sit at or before the hole
+	auto mask = entries.size() - 1;
+	for (auto j = (i + 1) & mask; entries[j].entity != nullptr; j = (j + 1) & mask)
+	{
+		auto home = hash(entries[j].uuid) & mask;
+		if (((j - home) & mask) >= ((j - i) & mask))
+		{
+			entries[i] = entries[j];
+			i = j;
+		}
+	}
+
+	entries[i] = Entry();
+	--count;
+}
+
+Entity* EntityUuidIndex::get(const xg::Guid& uuid) const
+{
+	auto i = find(uuid);
+	return i == entries.size() ? nullptr : entries[i].entity;
+}
+
+size_t EntityUuidIndex::size() const
+{
+	return count;
+}
+
+void EntityUuidIndex::clear()
+{
+	entries.clear();
+	count = 0;
+}
+
+uint64_t EntityUuidIndex::hash(const xg::Guid& uuid)
+{
+	uint64_t halves[2];
+	std::memcpy(halves, uuid.bytes().data(), sizeof(halves));
+	auto h = (halves[0] ^ (halves[1] << 32 | halves[1] >> 32)) * 0x9E3779B97F4A7C15ULL;
+	return h ^ (h >> 29);
+}
+
+size_t EntityUuidIndex::find(const xg::Guid& uuid) const
+{
+	if (count == 0)
+	{
+		return entries.size();
+	}
+
+	auto mask = entries.size() - 1;
+	for (auto i = hash(uuid) & mask;; i = (i + 1) & mask)
+	{
+		auto& entry = entries[i];
+		if (entry.entity == nullptr)
+		{
+			return entries.size();
+		}
+
+		if (entry.uuid == uuid)
+		{
+			return i;
+		}
+	}
+}
+
+void EntityUuidIndex::grow()
+{
+	auto old = std::move(entries);
+	entries.assign(old.empty() ? MIN_CAPACITY : old.size() * 2, Entry());
+	count = 0;
+	for (auto& entry : old)
+	{
+		if (entry.entity != nullptr)
+		{
+			put(entry.uuid, entry.entity);
+		}
+	}
+}
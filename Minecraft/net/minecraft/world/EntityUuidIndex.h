@@ -0,0 +1,35 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <crossguid/guid.hpp>
+
+class Entity;
+
+// Entities by UUID in one open addressed table with linear probing. UUIDs are random already, so the hash only folds
+// the two halves together; removal shifts the following entries back instead of leaving tombstones.
+class EntityUuidIndex
+{
+public:
+	// Indexes entityIn under uuid, replacing whatever was there.
+	void put(const xg::Guid& uuid, Entity* entityIn);
+	void remove(const xg::Guid& uuid);
+	Entity* get(const xg::Guid& uuid) const;
+	size_t size() const;
+	void clear();
+private:
+	struct Entry
+	{
+		xg::Guid uuid;
+		Entity* entity = nullptr;
+	};
+
+	static constexpr size_t MIN_CAPACITY = 64;
+
+	std::vector<Entry> entries;
+	size_t count = 0;
+
+	static uint64_t hash(const xg::Guid& uuid);
+	size_t find(const xg::Guid& uuid) const;
+	void grow();
+};
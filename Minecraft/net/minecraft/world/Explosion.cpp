@@ -35,7 +35,7 @@ void Explosion::doExplosionA()
 					d1 /= d3;
 					d2 /= d3;
 					std::uniform_real_distribution<float> e;
-					float f = size * (0.7F + e(world->rand) * 0.6F);
+					float f = size * (0.7F + e(world->getRandom()) * 0.6F);
 					double d4 = x;
 					double d6 = y;
 					double d8 = z;
@@ -121,7 +121,7 @@ void Explosion::doExplosionA()
 void Explosion::doExplosionB(bool spawnParticles)
 {
 	std::uniform_real_distribution<float> e;
-	world->playSound(nullptr, x, y, z, SoundEvents::ENTITY_GENERIC_EXPLODE, SoundCategory::BLOCKS, 4.0F, (1.0F + (e(world->rand) - e(world->rand)) * 0.2F) * 0.7F);
+	world->playSound(nullptr, x, y, z, SoundEvents::ENTITY_GENERIC_EXPLODE, SoundCategory::BLOCKS, 4.0F, (1.0F + (e(world->getRandom()) - e(world->getRandom())) * 0.2F) * 0.7F);
 	if (size >= 2.0F && damagesTerrain) 
 	{
 		world->spawnParticle(EnumParticleTypes::EXPLOSION_HUGE, x, y, z, 1.0, 0.0, 0.0);
@@ -138,9 +138,9 @@ void Explosion::doExplosionB(bool spawnParticles)
 			auto block = iblockstate->getBlock();
 			if (spawnParticles) 
 			{
-				double d0 = blockpos.getx() + e(world->rand);
-				double d1 = blockpos.gety() + e(world->rand);
-				double d2 = blockpos.getz() + e(world->rand);
+				double d0 = blockpos.getx() + e(world->getRandom());
+				double d1 = blockpos.gety() + e(world->getRandom());
+				double d2 = blockpos.getz() + e(world->getRandom());
 				double d3 = d0 - x;
 				double d4 = d1 - y;
 				double d5 = d2 - z;
@@ -149,7 +149,7 @@ void Explosion::doExplosionB(bool spawnParticles)
 				d4 /= d6;
 				d5 /= d6;
 				double d7 = 0.5 / (d6 / size + 0.1);
-				d7 *= (e(world->rand) * e(world->rand) + 0.3F);
+				d7 *= (e(world->getRandom()) * e(world->getRandom()) + 0.3F);
 				d3 *= d7;
 				d4 *= d7;
 				d5 *= d7;
@@ -174,7 +174,7 @@ void Explosion::doExplosionB(bool spawnParticles)
 	{
 		for (BlockPos blockpos : affectedBlockPositions)
 		{
-			if (world->getBlockState(blockpos)->getMaterial() == Material::AIR && world->getBlockState(blockpos.down())->isFullBlock() && world->rand(3) == 0) 
+			if (world->getBlockState(blockpos)->getMaterial() == Material::AIR && world->getBlockState(blockpos.down())->isFullBlock() && world->getRandom()(3) == 0) 
 			{
 				world->setBlockState(blockpos, Blocks::FIRE->getDefaultState());
 			}
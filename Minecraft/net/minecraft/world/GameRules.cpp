@@ -74,6 +74,13 @@ GameRules::GameRules()
 	addGameRule("maxCommandChainLength", "65536", ValueType::NUMERICAL_VALUE);
 	addGameRule("announceAdvancements", "true", ValueType::BOOLEAN_VALUE);
 	addGameRule("gameLoopFunction", "-", ValueType::FUNCTION);
+	addGameRule("parallelEntityTicking", "false", ValueType::BOOLEAN_VALUE);
+	addGameRule("batchedEntityPhysics", "false", ValueType::BOOLEAN_VALUE);
+	addGameRule("parallelEntityTracking", "false", ValueType::BOOLEAN_VALUE);
+	addGameRule("monsterActivationRange", "32", ValueType::NUMERICAL_VALUE);
+	addGameRule("animalActivationRange", "32", ValueType::NUMERICAL_VALUE);
+	addGameRule("villagerActivationRange", "32", ValueType::NUMERICAL_VALUE);
+	addGameRule("miscActivationRange", "16", ValueType::NUMERICAL_VALUE);
 }
 
 void GameRules::addGameRule(std::string key, std::string value, ValueType type)
@@ -0,0 +1,204 @@
+#include "ItemMergeIndex.h"
+#include "../entity/item/EntityItem.h"
+#include "../entity/item/EntityXPOrb.h"
+#include "../util/Util.h"
+#include "../util/math/MathHelper.h"
+
+#include <algorithm>
+
+size_t ItemMergeIndex::BucketKeyHash::operator()(const BucketKey& key) const
+{
+	return std::hash<int64_t>()(key.section) ^ (std::hash<uint64_t>()(key.mergeKey) * 0x9E3779B97F4A7C15ULL);
+}
+
+bool ItemMergeIndex::isMergeable(Entity* entityIn)
+{
+	return Util::instanceof<EntityItem>(entityIn) || Util::instanceof<EntityXPOrb>(entityIn);
+}
+
+void ItemMergeIndex::add(Entity* entityIn)
+{
+	if (isMergeable(entityIn) && locations.find(entityIn) == locations.end())
+	{
+		auto bucket = getBucketKey(entityIn);
+		insert(entityIn, bucket);
+		locations.emplace(entityIn, Location{bucket, false});
+	}
+}
+
+void ItemMergeIndex::remove(Entity* entityIn)
+{
+	auto location = locations.find(entityIn);
+	if (location != locations.end())
+	{
+		erase(entityIn, location->second.bucket);
+		locations.erase(location);
+	}
+}
+
+void ItemMergeIndex::update(Entity* entityIn)
+{
+	auto location = locations.find(entityIn);
+	if (location == locations.end())
+	{
+		return;
+	}
+
+	auto bucket = getBucketKey(entityIn);
+	if (!(bucket == location->second.bucket))
+	{
+		erase(entityIn, location->second.bucket);
+		insert(entityIn, bucket);
+		location->second.bucket = bucket;
+	}
+}
+
+void ItemMergeIndex::requestMerge(Entity* entityIn)
+{
+	auto location = locations.find(entityIn);
+	if (location != locations.end() && !location->second.queued)
+	{
+		location->second.queued = true;
+		pending.emplace_back(entityIn);
+	}
+}
+
+void ItemMergeIndex::processMerges()
+{
+	auto remaining = budget;
+	while (!pending.empty() && remaining > 0)
+	{
+		auto entity = pending.front();
+		pending.pop_front();
+		auto location = locations.find(entity);
+		if (location == locations.end())
+		{
+			continue;
+		}
+
+		location->second.queued = false;
+		if (!entity->isEntityAlive())
+		{
+			continue;
+		}
+
+		// the stack may have changed since it was bucketed, nothing else tells us about that
+		update(entity);
+		remaining -= std::min(remaining, merge(entity, location->second.bucket, remaining));
+	}
+}
+
+void ItemMergeIndex::setBudget(uint32_t comparisons)
+{
+	budget = std::max<uint32_t>(comparisons, 1);
+}
+
+uint32_t ItemMergeIndex::getBudget() const
+{
+	return budget;
+}
+
+size_t ItemMergeIndex::size() const
+{
+	return locations.size();
+}
+
+size_t ItemMergeIndex::getPendingCount() const
+{
+	return pending.size();
+}
+
+int64_t ItemMergeIndex::getSectionKey(int32_t x, int32_t y, int32_t z)
+{
+	return (static_cast<int64_t>(x & 0x3FFFFFF) << 38) | (static_cast<int64_t>(z & 0x3FFFFFF) << 12) | static_cast<int64_t>(y & 0xFFF);
+}
+
+uint64_t ItemMergeIndex::getMergeKey(Entity* entityIn)
+{
+	if (!Util::instanceof<EntityItem>(entityIn))
+	{
+		return XP_ORB_KEY;
+	}
+
+	auto itemstack = ((EntityItem*)entityIn)->getItem();
+	auto item = itemstack.getItem();
+	auto metadata = item != nullptr && item->getHasSubtypes() ? static_cast<uint32_t>(itemstack.getMetadata()) : 0;
+	return static_cast<uint64_t>(reinterpret_cast<uintptr_t>(item)) * 31 + metadata;
+}
+
+ItemMergeIndex::BucketKey ItemMergeIndex::getBucketKey(Entity* entityIn)
+{
+	return {getSectionKey(MathHelper::floor(entityIn->posX) >> 4, MathHelper::floor(entityIn->posY) >> 4, MathHelper::floor(entityIn->posZ) >> 4), getMergeKey(entityIn)};
+}
+
+void ItemMergeIndex::insert(Entity* entityIn, const BucketKey& bucket)
+{
+	buckets[bucket].emplace_back(entityIn);
+}
+
+void ItemMergeIndex::erase(Entity* entityIn, const BucketKey& bucket)
+{
+	auto entities = buckets.find(bucket);
+	auto& list = entities->second;
+	*std::find(list.begin(), list.end(), entityIn) = list.back();
+	list.pop_back();
+	if (list.empty())
+	{
+		buckets.erase(entities);
+	}
+}
+
+uint32_t ItemMergeIndex::merge(Entity* entityIn, const BucketKey& bucket, uint32_t remaining)
+{
+	// same box the item search used to take, widened by how far a neighbour's box reaches past its position
+	auto aabb = entityIn->getEntityBoundingBox().grow(0.5, 0.0, 0.5);
+	auto minX = MathHelper::floor(aabb.getminX() - MAX_EXTENT) >> 4;
+	auto minY = MathHelper::floor(aabb.getminY() - MAX_EXTENT) >> 4;
+	auto minZ = MathHelper::floor(aabb.getminZ() - MAX_EXTENT) >> 4;
+	auto maxX = MathHelper::floor(aabb.getmaxX() + MAX_EXTENT) >> 4;
+	auto maxY = MathHelper::floor(aabb.getmaxY() + MAX_EXTENT) >> 4;
+	auto maxZ = MathHelper::floor(aabb.getmaxZ() + MAX_EXTENT) >> 4;
+	candidates.clear();
+	for (auto x = minX; x <= maxX; ++x)
+	{
+		for (auto z = minZ; z <= maxZ; ++z)
+		{
+			for (auto y = minY; y <= maxY; ++y)
+			{
+				auto entities = buckets.find({getSectionKey(x, y, z), bucket.mergeKey});
+				if (entities != buckets.end())
+				{
+					candidates.insert(candidates.end(), entities->second.begin(), entities->second.end());
+				}
+			}
+		}
+	}
+
+	// merging changes stacks and kills entities, so work on a copy of the buckets. Every candidate looked at
+	// counts against the budget, a crowded bucket of dead or out of reach entities costs as much as live ones.
+	uint32_t comparisons = 0;
+	for (auto candidate : candidates)
+	{
+		if (comparisons == remaining || !entityIn->isEntityAlive())
+		{
+			break;
+		}
+
+		++comparisons;
+		if (candidate == entityIn || !candidate->isEntityAlive() || !candidate->getEntityBoundingBox().intersects(aabb))
+		{
+			continue;
+		}
+
+		if (bucket.mergeKey == XP_ORB_KEY)
+		{
+			((EntityXPOrb*)entityIn)->combineOrbs((EntityXPOrb*)candidate);
+		}
+		else
+		{
+			((EntityItem*)entityIn)->combineItems((EntityItem*)candidate);
+		}
+	}
+
+	return comparisons;
+}
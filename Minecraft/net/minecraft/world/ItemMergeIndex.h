@@ -0,0 +1,65 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <unordered_map>
+#include <vector>
+
+class Entity;
+
+// Dropped items and XP orbs bucketed by chunk section and by what they can merge with, so a merge only
+// compares stacks of the same item and damage in the sections around it. Merges are queued by the entities
+// themselves and run once per tick until the budget of comparisons is spent; the rest wait for the next tick.
+class ItemMergeIndex
+{
+public:
+	static constexpr uint32_t DEFAULT_BUDGET = 1024;
+
+	static bool isMergeable(Entity* entityIn);
+	void add(Entity* entityIn);
+	void remove(Entity* entityIn);
+	// Moves entityIn to the bucket of its current section, call when it crossed into another one.
+	void update(Entity* entityIn);
+	void requestMerge(Entity* entityIn);
+	void processMerges();
+	void setBudget(uint32_t comparisons);
+	uint32_t getBudget() const;
+	size_t size() const;
+	size_t getPendingCount() const;
+private:
+	struct BucketKey
+	{
+		int64_t section;
+		uint64_t mergeKey;
+
+		bool operator==(const BucketKey& other) const = default;
+	};
+
+	struct BucketKeyHash
+	{
+		size_t operator()(const BucketKey& key) const;
+	};
+
+	struct Location
+	{
+		BucketKey bucket;
+		bool queued;
+	};
+
+	static constexpr uint64_t XP_ORB_KEY = UINT64_MAX;
+	// how far the box of an item or orb reaches past its position
+	static constexpr double MAX_EXTENT = 0.5;
+
+	std::unordered_map<BucketKey, std::vector<Entity*>, BucketKeyHash> buckets;
+	std::unordered_map<Entity*, Location> locations;
+	std::deque<Entity*> pending;
+	std::vector<Entity*> candidates;
+	uint32_t budget = DEFAULT_BUDGET;
+
+	static int64_t getSectionKey(int32_t x, int32_t y, int32_t z);
+	static uint64_t getMergeKey(Entity* entityIn);
+	static BucketKey getBucketKey(Entity* entityIn);
+	void insert(Entity* entityIn, const BucketKey& bucket);
+	void erase(Entity* entityIn, const BucketKey& bucket);
+	uint32_t merge(Entity* entityIn, const BucketKey& bucket, uint32_t remaining);
+};
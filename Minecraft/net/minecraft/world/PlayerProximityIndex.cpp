@@ -0,0 +1,34 @@
+#include "PlayerProximityIndex.h"
+#include "../entity/player/EntityPlayer.h"
+
+void PlayerProximityIndex::rebuild(const std::vector<EntityPlayer*>& players)
+{
+	entries.clear();
+	entries.reserve(players.size());
+	for (size_t i = 0; i < players.size(); ++i)
+	{
+		auto player = players[i];
+		entries.push_back({getKey(MathHelper::floor(player->posX) >> CELL_SHIFT, MathHelper::floor(player->posZ) >> CELL_SHIFT), static_cast<uint32_t>(i), player});
+	}
+
+	std::sort(entries.begin(), entries.end(), [](const Entry& lhs, const Entry& rhs)
+	{
+		return lhs.key < rhs.key;
+	});
+	dirty = false;
+}
+
+void PlayerProximityIndex::markDirty()
+{
+	dirty = true;
+}
+
+bool PlayerProximityIndex::isDirty() const
+{
+	return dirty;
+}
+
+size_t PlayerProximityIndex::size() const
+{
+	return entries.size();
+}
@@ -0,0 +1,76 @@
+#pragma once
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+#include "../util/math/MathHelper.h"
+
+class EntityPlayer;
+
+// Players of one world bucketed into 64 block columns, rebuilt once per tick or when a player joins or
+// leaves. Nearest and range queries only look at columns within reach instead of every player; callers
+// still measure the live position, SLACK covers how far a player may have moved since the rebuild.
+class PlayerProximityIndex
+{
+public:
+	static constexpr int32_t CELL_SHIFT = 6;
+	static constexpr double SLACK = 8.0;
+
+	void rebuild(const std::vector<EntityPlayer*>& players);
+	void markDirty();
+	bool isDirty() const;
+	size_t size() const;
+
+	// Calls visitor(player, order) for every player that may lie within range on the XZ plane, where order is
+	// the player's position in World::playerEntities so callers can keep the old tie-breaking.
+	template <typename Visitor>
+	void forEachPlayerNear(double x, double z, double range, Visitor&& visitor) const;
+private:
+	struct Entry
+	{
+		int64_t key;
+		uint32_t order;
+		EntityPlayer* player;
+	};
+
+	std::vector<Entry> entries;
+	bool dirty = true;
+
+	static int64_t getKey(int32_t cellX, int32_t cellZ);
+};
+
+inline int64_t PlayerProximityIndex::getKey(int32_t cellX, int32_t cellZ)
+{
+	return (static_cast<int64_t>(cellX) << 32) | (static_cast<uint32_t>(cellZ) ^ 0x80000000u);
+}
+
+template <typename Visitor>
+void PlayerProximityIndex::forEachPlayerNear(double x, double z, double range, Visitor&& visitor) const
+{
+	auto minX = MathHelper::floor(x - range - SLACK) >> CELL_SHIFT;
+	auto maxX = MathHelper::floor(x + range + SLACK) >> CELL_SHIFT;
+	auto minZ = MathHelper::floor(z - range - SLACK) >> CELL_SHIFT;
+	auto maxZ = MathHelper::floor(z + range + SLACK) >> CELL_SHIFT;
+	if (static_cast<size_t>(maxX - minX + 1) >= entries.size())
+	{
+		for (auto& entry : entries)
+		{
+			visitor(entry.player, entry.order);
+		}
+
+		return;
+	}
+
+	// one binary search per row of columns, entries are sorted by (cellX, cellZ)
+	for (auto cellX = minX; cellX <= maxX; ++cellX)
+	{
+		auto last = getKey(cellX, maxZ);
+		auto ite = std::lower_bound(entries.begin(), entries.end(), getKey(cellX, minZ), [](const Entry& entry, int64_t key)
+		{
+			return entry.key < key;
+		});
+		for (; ite != entries.end() && ite->key <= last; ++ite)
+		{
+			visitor(ite->player, ite->order);
+		}
+	}
+}
@@ -0,0 +1,245 @@
+#include "RegionTicker.h"
+#include "WorkerPool.h"
+#include "../entity/Entity.h"
+#include "../tileentity/TileEntity.h"
+#include "../util/math/MathHelper.h"
+
+#include <algorithm>
+#include <future>
+
+thread_local RegionTicker::Region* RegionTicker::currentRegion = nullptr;
+
+namespace
+{
+	int32_t floorDiv(int32_t value, int32_t divisor)
+	{
+		auto quotient = value / divisor;
+		return (value % divisor != 0 && (value < 0) != (divisor < 0)) ? quotient - 1 : quotient;
+	}
+
+	int64_t getCellKey(int32_t cellX, int32_t cellZ)
+	{
+		return (static_cast<int64_t>(cellX) << 32) | static_cast<uint32_t>(cellZ);
+	}
+}
+
+RegionTicker::RegionTicker(uint32_t threadCount)
+	:pool(std::make_unique<WorkerPool>("Region Worker", threadCount))
+{
+}
+
+RegionTicker::~RegionTicker() = default;
+
+void RegionTicker::defer(std::function<void()> action)
+{
+	currentRegion->deferred.emplace_back(std::move(action));
+}
+
+bool RegionTicker::isTickingRegion()
+{
+	return currentRegion != nullptr;
+}
+
+pcg32* RegionTicker::getRegionRandom()
+{
+	return currentRegion != nullptr ? &currentRegion->random : nullptr;
+}
+
+void RegionTicker::setMargin(int32_t chunks)
+{
+	margin = std::max(chunks, 1);
+}
+
+int32_t RegionTicker::getMargin() const
+{
+	return margin;
+}
+
+void RegionTicker::partition(const std::vector<Entity*>& entities, const std::vector<TileEntity*>& tileEntities, pcg32& random)
+{
+	// Chunks are grouped into cells of margin x margin chunks and occupied cells touching each other, corners
+	// included, are joined. Two chunks no more than margin apart always share or touch a cell, so entities in
+	// different regions are always more than margin chunks apart.
+	cellIndex.clear();
+	parents.clear();
+	entityCells.clear();
+	tileEntityCells.clear();
+	for (auto entity : entities)
+	{
+		entityCells.emplace_back(getCell(MathHelper::floor(entity->posX), MathHelper::floor(entity->posZ)));
+	}
+
+	for (auto tileentity : tileEntities)
+	{
+		auto pos = tileentity->getPos();
+		tileEntityCells.emplace_back(getCell(pos.getx(), pos.getz()));
+	}
+
+	for (auto& cell : cellIndex)
+	{
+		auto cellX = static_cast<int32_t>(cell.first >> 32);
+		auto cellZ = static_cast<int32_t>(static_cast<uint32_t>(cell.first));
+		for (auto offset : {std::pair{1, -1}, std::pair{1, 0}, std::pair{1, 1}, std::pair{0, 1}})
+		{
+			auto neighbour = cellIndex.find(getCellKey(cellX + offset.first, cellZ + offset.second));
+			if (neighbour != cellIndex.end())
+			{
+				auto lhs = find(cell.second);
+				auto rhs = find(neighbour->second);
+				if (lhs != rhs)
+				{
+					parents[std::max(lhs, rhs)] = std::min(lhs, rhs);
+				}
+			}
+		}
+	}
+
+	regions.clear();
+	std::vector<uint32_t> regionOfRoot(parents.size(), UINT32_MAX);
+	auto regionOf = [&](uint32_t cell, size_t order) -> Region&
+	{
+		auto root = find(cell);
+		if (regionOfRoot[root] == UINT32_MAX)
+		{
+			regionOfRoot[root] = static_cast<uint32_t>(regions.size());
+			regions.push_back({order, {}, {}, {}, pcg32(random())});
+		}
+
+		return regions[regionOfRoot[root]];
+	};
+
+	for (size_t i = 0; i < entities.size(); ++i)
+	{
+		regionOf(entityCells[i], i).entities.emplace_back(entities[i]);
+	}
+
+	for (size_t i = 0; i < tileEntities.size(); ++i)
+	{
+		regionOf(tileEntityCells[i], entities.size() + i).tileEntities.emplace_back(tileEntities[i]);
+	}
+
+	// regions were created in list order already, the schedule hands out the biggest ones first
+	schedule.resize(regions.size());
+	for (size_t i = 0; i < schedule.size(); ++i)
+	{
+		schedule[i] = i;
+	}
+
+	std::stable_sort(schedule.begin(), schedule.end(), [this](size_t lhs, size_t rhs)
+	{
+		return regions[lhs].entities.size() + regions[lhs].tileEntities.size() > regions[rhs].entities.size() + regions[rhs].tileEntities.size();
+	});
+}
+
+void RegionTicker::tick(const std::function<void(Entity*)>& entityTick, const std::function<void(TileEntity*)>& tileEntityTick)
+{
+	if (regions.size() <= 1)
+	{
+		// nothing to overlap with, tick in place so the order is exactly the sequential one
+		for (auto& region : regions)
+		{
+			std::for_each(region.entities.begin(), region.entities.end(), entityTick);
+			std::for_each(region.tileEntities.begin(), region.tileEntities.end(), tileEntityTick);
+		}
+
+		return;
+	}
+
+	nextRegion = 0;
+	error = nullptr;
+	auto helpers = std::min<size_t>(pool->getThreadCount(), regions.size() - 1);
+	std::vector<std::future<void>> futures;
+	futures.reserve(helpers);
+	for (size_t i = 0; i < helpers; ++i)
+	{
+		futures.emplace_back(pool->submit([&]()
+		{
+			runRegions(entityTick, tileEntityTick);
+		}));
+	}
+
+	// the tick thread takes regions too, idle threads keep pulling the next one until all are done
+	runRegions(entityTick, tileEntityTick);
+	for (auto& future : futures)
+	{
+		future.get();
+	}
+
+	if (error)
+	{
+		std::rethrow_exception(error);
+	}
+}
+
+void RegionTicker::merge()
+{
+	lastDeferred = 0;
+	for (auto& region : regions)
+	{
+		lastDeferred += region.deferred.size();
+		for (auto& action : region.deferred)
+		{
+			action();
+		}
+
+		region.deferred.clear();
+	}
+}
+
+RegionTicker::Statistics RegionTicker::getStatistics() const
+{
+	size_t largest = 0;
+	for (auto& region : regions)
+	{
+		largest = std::max(largest, region.entities.size() + region.tileEntities.size());
+	}
+
+	return {regions.size(), largest, lastDeferred};
+}
+
+uint32_t RegionTicker::getCell(int32_t blockX, int32_t blockZ)
+{
+	auto key = getCellKey(floorDiv(blockX >> 4, margin), floorDiv(blockZ >> 4, margin));
+	auto cell = cellIndex.try_emplace(key, static_cast<uint32_t>(parents.size()));
+	if (cell.second)
+	{
+		parents.emplace_back(cell.first->second);
+	}
+
+	return cell.first->second;
+}
+
+uint32_t RegionTicker::find(uint32_t cell)
+{
+	while (parents[cell] != cell)
+	{
+		parents[cell] = parents[parents[cell]];
+		cell = parents[cell];
+	}
+
+	return cell;
+}
+
+void RegionTicker::runRegions(const std::function<void(Entity*)>& entityTick, const std::function<void(TileEntity*)>& tileEntityTick)
+{
+	for (auto index = nextRegion++; index < schedule.size(); index = nextRegion++)
+	{
+		auto& region = regions[schedule[index]];
+		currentRegion = &region;
+		try
+		{
+			std::for_each(region.entities.begin(), region.entities.end(), entityTick);
+			std::for_each(region.tileEntities.begin(), region.tileEntities.end(), tileEntityTick);
+		}
+		catch (...)
+		{
+			std::lock_guard<std::mutex> guard(errorLock);
+			if (!error)
+			{
+				error = std::current_exception();
+			}
+		}
+
+		currentRegion = nullptr;
+	}
+}
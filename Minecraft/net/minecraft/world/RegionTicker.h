@@ -0,0 +1,99 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "pcg_random.hpp"
+
+class Entity;
+class TileEntity;
+class WorkerPool;
+
+// Splits the loaded entities and tickable tile entities of a world into islands of chunks that lie more than
+// a margin apart, and ticks the islands concurrently. Anything that reaches state shared between islands
+// (chunk entity lists, the entity index, spawns and removals, listeners, the block tick queue) is queued
+// through deferIfTicking() while an island ticks and replayed on the tick thread afterwards, island by island
+// in loadedEntityList order, so the merge is deterministic. Each island draws from its own random generator,
+// seeded from the world's in island order, so rolls do not depend on which thread ticks which island.
+class RegionTicker
+{
+public:
+	struct Statistics
+	{
+		size_t regions;
+		size_t largestRegion;
+		size_t deferredActions;
+	};
+
+	static constexpr int32_t DEFAULT_MARGIN = 4;
+	// below this many entities the hand-off to the workers costs more than it saves
+	static constexpr size_t MIN_PARALLEL_ENTITIES = 256;
+
+	explicit RegionTicker(uint32_t threadCount = 0);
+	~RegionTicker();
+	RegionTicker(const RegionTicker&) = delete;
+	RegionTicker& operator=(const RegionTicker&) = delete;
+
+	// Runs action later on the tick thread if called from inside a region tick and returns true, otherwise returns false.
+	// The std::function is only built once a region is known to be ticking, so the common path does not allocate.
+	template <typename Action>
+	static bool deferIfTicking(Action&& action);
+	static bool isTickingRegion();
+	// The generator of the island ticking on this thread, nullptr outside a region tick.
+	static pcg32* getRegionRandom();
+
+	void setMargin(int32_t chunks);
+	int32_t getMargin() const;
+	void partition(const std::vector<Entity*>& entities, const std::vector<TileEntity*>& tileEntities, pcg32& random);
+	void tick(const std::function<void(Entity*)>& entityTick, const std::function<void(TileEntity*)>& tileEntityTick);
+	void merge();
+	Statistics getStatistics() const;
+private:
+	struct Region
+	{
+		size_t order;
+		std::vector<Entity*> entities;
+		std::vector<TileEntity*> tileEntities;
+		std::vector<std::function<void()>> deferred;
+		pcg32 random;
+	};
+
+	static thread_local Region* currentRegion;
+
+	static void defer(std::function<void()> action);
+
+	std::unique_ptr<WorkerPool> pool;
+	int32_t margin = DEFAULT_MARGIN;
+	std::vector<Region> regions;
+	std::vector<size_t> schedule;
+	std::unordered_map<int64_t, uint32_t> cellIndex;
+	std::vector<uint32_t> parents;
+	std::vector<uint32_t> entityCells;
+	std::vector<uint32_t> tileEntityCells;
+	size_t lastDeferred = 0;
+
+	std::atomic<size_t> nextRegion{0};
+	std::mutex errorLock;
+	std::exception_ptr error;
+
+	uint32_t getCell(int32_t blockX, int32_t blockZ);
+	uint32_t find(uint32_t cell);
+	void runRegions(const std::function<void(Entity*)>& entityTick, const std::function<void(TileEntity*)>& tileEntityTick);
+};
+
+template <typename Action>
+bool RegionTicker::deferIfTicking(Action&& action)
+{
+	if (!isTickingRegion())
+	{
+		return false;
+	}
+
+	defer(std::function<void()>(std::forward<Action>(action)));
+	return true;
+}
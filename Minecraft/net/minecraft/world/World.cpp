@@ -8,6 +8,8 @@
 #include "../util/ITickable.h"
 #include "../util/EntitySelectors.h"
 #include "math/AxisAlignedBB.h"
+#include "RegionTicker.h"
+#include "../block/state/CollisionShapeCache.h"
 
 World& World::init()
 {
@@ -22,6 +24,14 @@ World::World(ISaveHandler saveHandlerIn, WorldInfo info, WorldProvider providerI
 
 void World::onEntityAdded(Entity* entityIn)
 {
+	entitySlots.add(entityIn);
+	if (entityIn->hasDirtyData())
+	{
+		dirtyEntities.emplace_back(entityIn->getHandle());
+	}
+
+	entitySpatialIndex.add(entityIn);
+	itemMergeIndex.add(entityIn);
 	for (auto event : eventListeners)
 	{
 		event->onEntityAdded(entityIn);
@@ -30,6 +40,15 @@ void World::onEntityAdded(Entity* entityIn)
 
 void World::onEntityRemoved(Entity* entityIn)
 {
+	entitySlots.remove(entityIn);
+	entitySpatialIndex.remove(entityIn);
+	itemMergeIndex.remove(entityIn);
+	if (entityIn->dormant)
+	{
+		dormantEntities.remove(entityIn);
+		entityIn->dormant = false;
+	}
+
 	for (auto event : eventListeners)
 	{
 		event->onEntityRemoved(entityIn);
@@ -40,6 +59,33 @@ void World::tickPlayers()
 {
 }
 
+void World::markEntityForRemoval(Entity* entityIn)
+{
+	entityIn->removalPending = true;
+	entityRemovalsPending = true;
+}
+
+void World::compactEntityList()
+{
+	if (!entityRemovalsPending)
+	{
+		return;
+	}
+
+	// remove_if is stable, the survivors keep their tick order
+	loadedEntityList.erase(std::remove_if(loadedEntityList.begin(), loadedEntityList.end(), [](Entity* entity)
+	{
+		if (!entity->removalPending)
+		{
+			return false;
+		}
+
+		entity->removalPending = false;
+		return true;
+	}), loadedEntityList.end());
+	entityRemovalsPending = false;
+}
+
 void World::calculateInitialWeather()
 {
 	if (worldInfo.isRaining()) 
@@ -193,8 +239,7 @@ void World::spawnParticle(int particleID, bool ignoreRange, double xCood, double
 	}
 }
 
-bool World::getCollisionBoxes(Entity* entityIn, AxisAlignedBB aabb, bool p_191504_3_,
-	std::optional<std::vector<AxisAlignedBB>>& outList)
+bool World::getCollisionBoxes(Entity* entityIn, const AxisAlignedBB& aabb, bool p_191504_3_, std::vector<AxisAlignedBB>& outList)
 {
 	auto i = MathHelper::floor(aabb.getminX()) - 1;
 	auto j = MathHelper::ceil(aabb.getmaxX()) + 1;
@@ -245,8 +290,17 @@ bool World::getCollisionBoxes(Entity* entityIn, AxisAlignedBB aabb, bool p_19150
 								iblockstate1 = getBlockState(pooledmutableblockpos);
 							}
 
-							iblockstate1->addCollisionBoxToList(this, pooledmutableblockpos, aabb, outList, entityIn, false);
-							if (p_191504_3_ && !outList.value().empty()) 
+							auto shape = CollisionShapeCache::get(iblockstate1);
+							if (shape != nullptr) 
+							{
+								CollisionShapeCache::addCollisionBoxes(*shape, pooledmutableblockpos, aabb, outList);
+							}
+							else 
+							{
+								addDynamicCollisionBoxes(iblockstate1, entityIn, pooledmutableblockpos, aabb, outList);
+							}
+
+							if (p_191504_3_ && !outList.empty()) 
 							{
 								flag5 = true;
 								bool var23 = flag5;
@@ -258,7 +312,15 @@ bool World::getCollisionBoxes(Entity* entityIn, AxisAlignedBB aabb, bool p_19150
 			}
 		}
 
-	return !outList.value().empty();
+	return !outList.empty();
+}
+
+void World::addDynamicCollisionBoxes(IBlockState* state, Entity* entityIn, const BlockPos& pos, const AxisAlignedBB& aabb, std::vector<AxisAlignedBB>& outList)
+{
+	thread_local std::optional<std::vector<AxisAlignedBB>> boxes;
+	boxes.emplace();
+	state->addCollisionBoxToList(this, pos, aabb, boxes, entityIn, false);
+	outList.insert(outList.end(), boxes->begin(), boxes->end());
 }
 
 bool World::isWater(BlockPos& pos)
@@ -404,6 +466,7 @@ bool World::setBlockState(BlockPos& pos, IBlockState* newState, int32_t flags)
 		}
 		else 
 		{
+			wakeDormantEntitiesAt(pos);
 			if (newState->getLightOpacity() != iblockstate.getLightOpacity() || newState->getLightValue() != iblockstate.getLightValue()) 
 			{
 				profiler.startSection("checkLight");
@@ -465,6 +528,11 @@ bool World::setBlockState(BlockPos& pos, IBlockState* state)
 
 void World::notifyBlockUpdate(BlockPos& pos, IBlockState* oldState, IBlockState* newState, int32_t flags)
 {
+	if (RegionTicker::deferIfTicking([this, pos, oldState, newState, flags]() mutable { notifyBlockUpdate(pos, oldState, newState, flags); }))
+	{
+		return;
+	}
+
 	for (auto i = 0; i < eventListeners.size(); ++i) 
 	{
 		eventListeners[i]->notifyBlockUpdate(this, pos, oldState, newState, flags);
@@ -504,6 +572,11 @@ void World::markBlockRangeForRenderUpdate(BlockPos& rangeMin, BlockPos& rangeMax
 
 void World::markBlockRangeForRenderUpdate(int32_t x1, int32_t y1, int32_t z1, int32_t x2, int32_t y2, int32_t z2)
 {
+	if (RegionTicker::deferIfTicking([=, this]() { markBlockRangeForRenderUpdate(x1, y1, z1, x2, y2, z2); }))
+	{
+		return;
+	}
+
 	for(auto event : eventListeners)
 	{
 		event->markBlockRangeForRenderUpdate(x1, y1, z1, x2, y2, z2);
@@ -863,6 +936,11 @@ void World::setLightFor(EnumSkyBlock type, BlockPos& pos, int32_t lightValue)
 
 void World::notifyLightSet(BlockPos& pos)
 {
+	if (RegionTicker::deferIfTicking([this, pos]() mutable { notifyLightSet(pos); }))
+	{
+		return;
+	}
+
 	for(auto event : eventListeners)
 	{
 		event->notifyLightSet(pos);
@@ -1084,6 +1162,11 @@ void World::playSound(EntityPlayer* player, BlockPos pos, SoundEvent soundIn, So
 void World::playSound(EntityPlayer* player, double x, double y, double z, SoundEvent soundIn,
 	SoundCategory category, float volume, float pitch)
 {
+	if (RegionTicker::deferIfTicking([=, this]() { playSound(player, x, y, z, soundIn, category, volume, pitch); }))
+	{
+		return;
+	}
+
 	for(auto event : eventListeners)
 	{
 		event->playSoundToAllNearExcept(player, soundIn, category, x, y, z, volume, pitch);
@@ -1097,6 +1180,11 @@ void World::playSound(double x, double y, double z, SoundEvent soundIn, SoundCat
 
 void World::playRecord(BlockPos& blockPositionIn, std::optional<SoundEvent> soundEventIn)
 {
+	if (RegionTicker::deferIfTicking([this, blockPositionIn, soundEventIn]() mutable { playRecord(blockPositionIn, soundEventIn); }))
+	{
+		return;
+	}
+
 	for (auto event : eventListeners)
 	{
 		event->playRecord(soundEventIn, blockPositionIn);
@@ -1132,6 +1220,12 @@ bool World::addWeatherEffect(Entity* entityIn)
 
 bool World::spawnEntity(Entity* entityIn)
 {
+	// queued until the merge, it is not in the world yet and may still be refused then
+	if (RegionTicker::deferIfTicking([this, entityIn]() { spawnEntity(entityIn); }))
+	{
+		return false;
+	}
+
 	auto i = MathHelper::floor(entityIn->posX / 16.0);
 	auto j = MathHelper::floor(entityIn->posZ / 16.0);
 	bool flag = entityIn->forceSpawn;
@@ -1150,6 +1244,7 @@ bool World::spawnEntity(Entity* entityIn)
 		{
 			auto entityplayer = reinterpret_cast<EntityPlayer>(entityIn);
 			playerEntities.emplace_back(entityplayer);
+			playerProximityIndex.markDirty();
 			updateAllPlayersSleepingFlag();
 		}
 
@@ -1162,6 +1257,11 @@ bool World::spawnEntity(Entity* entityIn)
 
 void World::removeEntity(Entity* entityIn)
 {
+	if (RegionTicker::deferIfTicking([this, entityIn]() { removeEntity(entityIn); }))
+	{
+		return;
+	}
+
 	if (entityIn->isBeingRidden()) 
 	{
 		entityIn->removePassengers();
@@ -1176,6 +1276,7 @@ void World::removeEntity(Entity* entityIn)
 	if (Util::instanceof< EntityPlayer>(entityIn)) 
 	{
 		playerEntities.erase(std::find(playerEntities.begin(), playerEntities.end(), entityIn));
+		playerProximityIndex.markDirty();
 		updateAllPlayersSleepingFlag();
 		onEntityRemoved(entityIn);
 	}
@@ -1183,11 +1284,17 @@ void World::removeEntity(Entity* entityIn)
 
 void World::removeEntityDangerously(Entity* entityIn)
 {
+	if (RegionTicker::deferIfTicking([this, entityIn]() { removeEntityDangerously(entityIn); }))
+	{
+		return;
+	}
+
 	entityIn->setDropItemsWhenDead(false);
 	entityIn->setDead();
 	if (Util::instanceof<EntityPlayer>(entityIn)) 
 	{
 		playerEntities.erase(std::find(playerEntities.begin(), playerEntities.end(), entityIn));
+		playerProximityIndex.markDirty();
 		updateAllPlayersSleepingFlag();
 	}
 
@@ -1198,7 +1305,7 @@ void World::removeEntityDangerously(Entity* entityIn)
 		getChunk(i, j).removeEntity(entityIn);
 	}
 
-	loadedEntityList.erase(std::find(loadedEntityList.begin(), loadedEntityList.end(), entityIn));
+	markEntityForRemoval(entityIn);
 	onEntityRemoved(entityIn);
 }
 
@@ -1214,31 +1321,37 @@ void World::removeEventListener(IWorldEventListener* listener)
 
 std::optional<std::vector<AxisAlignedBB>> World::getCollisionBoxes(Entity* entityIn, AxisAlignedBB& aabb)
 {
-	std::optional<std::vector<AxisAlignedBB>> list;
-	getCollisionBoxes(entityIn, aabb, false, list);
+	std::optional<std::vector<AxisAlignedBB>> list = std::vector<AxisAlignedBB>();
+	getCollisionBoxes(entityIn, aabb, *list);
+	return list;
+}
+
+void World::getCollisionBoxes(Entity* entityIn, const AxisAlignedBB& aabb, std::vector<AxisAlignedBB>& listToFill)
+{
+	getCollisionBoxes(entityIn, aabb, false, listToFill);
 	if (entityIn != nullptr) 
 	{
-		auto list1 = getEntitiesWithinAABBExcludingEntity(entityIn, aabb.grow(0.25));
+		thread_local std::vector<Entity*> list1;
+		list1.clear();
+		getEntitiesInAABBexcluding(entityIn, aabb.grow(0.25), nullptr, list1);
 		for(auto entity : list1)
 		{
 			if (!entityIn->isRidingSameEntity(entity)) 
 			{
 				auto axisalignedbb = entity->getCollisionBoundingBox();
-				if (axisalignedbb && axisalignedbb.intersects(aabb)) 
+				if (axisalignedbb && axisalignedbb->intersects(aabb)) 
 				{
-					list->emplace_back(axisalignedbb);
+					listToFill.emplace_back(*axisalignedbb);
 				}
 
 				axisalignedbb = entityIn->getCollisionBox(entity);
-				if (axisalignedbb && axisalignedbb.intersects(aabb)) 
+				if (axisalignedbb && axisalignedbb->intersects(aabb)) 
 				{
-					list->emplace_back(axisalignedbb);
+					listToFill.emplace_back(*axisalignedbb);
 				}
 			}
 		}
 	}
-
-	return list;
 }
 
 bool World::isInsideWorldBorder(Entity* entityToCheck)
@@ -1267,8 +1380,9 @@ bool World::isInsideWorldBorder(Entity* entityToCheck)
 
 bool World::collidesWithAnyBlock(AxisAlignedBB& bbox)
 {
-	std::optional<std::vector<AxisAlignedBB>> opt;
-	return getCollisionBoxes(nullptr, bbox, true, opt);
+	thread_local std::vector<AxisAlignedBB> boxes;
+	boxes.clear();
+	return getCollisionBoxes(nullptr, bbox, true, boxes);
 }
 
 int32_t World::calculateSkylightSubtracted(float partialTicks)
@@ -1386,7 +1500,15 @@ void World::scheduleBlockUpdate(BlockPos& pos, Block* blockIn, int32_t delay, in
 void World::updateEntities()
 {
 	profiler.startSection("entities");
-	profiler.startSection("global");
+	playerProximityIndex.rebuild(playerEntities);
+	profiler.startSection("activation");
+	if (!isRemote)
+	{
+		entityActivationRange.readRanges(getGameRules());
+		entityActivationRange.activateEntities(entitySpatialIndex, playerEntities, getTotalWorldTime());
+	}
+
+	profiler.endStartSection("global");
 
 	Entity* entity2;
 	for (auto i1 = 0; i1 < weatherEffects.size(); ++i1) 
@@ -1418,11 +1540,16 @@ void World::updateEntities()
 	}
 
 	profiler.endStartSection("remove");
-	Util::removeAll(loadedEntityList, unloadedEntityList);
-
+	// the unloaded entities were tombstoned by unloadEntities; one replaced by a re-added copy has left the list,
+	// one compacted already is no longer pending
 	for (auto i1 = 0; i1 < unloadedEntityList.size(); ++i1) 
 	{
 		entity2 = unloadedEntityList[i1];
+		if (!entity2->removalPending)
+		{
+			continue;
+		}
+
 		auto j = entity2->chunkCoordX;
 		auto l1 = entity2->chunkCoordZ;
 		if (entity2->addedToChunk && isChunkLoaded(j, l1, true)) 
@@ -1433,7 +1560,17 @@ void World::updateEntities()
 
 	for (auto i1 = 0; i1 < unloadedEntityList.size(); ++i1) 
 	{
-		onEntityRemoved(unloadedEntityList[i1]);
+		if (unloadedEntityList[i1]->removalPending)
+		{
+			onEntityRemoved(unloadedEntityList[i1]);
+		}
+	}
+
+	compactEntityList();
+	// entities the chunks held without them being loaded never reach the compaction
+	for (auto entity : unloadedEntityList)
+	{
+		entity->removalPending = false;
 	}
 
 	unloadedEntityList.clear();
@@ -1442,9 +1579,23 @@ void World::updateEntities()
 
 	CrashReportCategory crashreportcategory2;
 	CrashReport crashreport2;
+	auto regionsTicked = false;
+	setParallelEntityTicking(!isRemote && getGameRules().getBoolean("parallelEntityTicking"));
+	setBatchedPhysics(!isRemote && getGameRules().getBoolean("batchedEntityPhysics"));
+	if (regionTicker != nullptr && loadedEntityList.size() >= RegionTicker::MIN_PARALLEL_ENTITIES)
+	{
+		tickRegions();
+		regionsTicked = true;
+	}
+
 	for (auto i1 = 0; i1 < loadedEntityList.size(); ++i1) 
 	{
 		entity2 = loadedEntityList[i1];
+		if (entity2->removalPending)
+		{
+			continue;
+		}
+
 		auto entity3 = entity2.getRidingEntity();
 		if (entity3 != nullptr) 
 		{
@@ -1456,7 +1607,7 @@ void World::updateEntities()
 		}
 
 		profiler.startSection("tick");
-		if (!entity2.isDead && !(Util::instanceof< EntityPlayerMP>(entity2))) 
+		if (!regionsTicked && !entity2.dormant && !entity2.isDead && !(Util::instanceof< EntityPlayerMP>(entity2))) 
 		{
 			try {
 				updateEntity(entity2);
@@ -1479,43 +1630,30 @@ void World::updateEntities()
 				getChunk(l1, i2).removeEntity(entity2);
 			}
 
-			loadedEntityList.erase(loadedEntityList.begin() + i1--);
+			markEntityForRemoval(entity2);
 			onEntityRemoved(entity2);
 		}
 
 		profiler.endSection();
 	}
 
+	compactEntityList();
+	profiler.endStartSection("physics");
+	entityPhysicsBatch.run(this);
+	profiler.endStartSection("push");
+	entityPushBroadphase.resolve(loadedEntityList, getGameRules().getInt("maxEntityCramming"));
+	profiler.endStartSection("itemMerge");
+	itemMergeIndex.processMerges();
 	profiler.endStartSection("blockEntities");
-	if (!tileEntitiesToBeRemoved.isEmpty()) 
-	{
-		Util::removeAll(tickableTileEntities, tileEntitiesToBeRemoved);
-		Util::removeAll(loadedTileEntityList, tileEntitiesToBeRemoved);
-		tileEntitiesToBeRemoved.clear();
-	}
+	compactTileEntityLists();
 
 	processingLoadedTiles = true;
 
 	for(auto tileentity : tickableTileEntities)
 	{
-		if (!tileentity.isInvalid() && tileentity.hasWorld()) {
-			BlockPos blockpos = tileentity.getPos();
-			if (isBlockLoaded(blockpos) && worldBorder.contains(blockpos)) 
-			{
-				try {
-					profiler.func_194340_a(() -> {
-						return String.valueOf(TileEntity.getKey(tileentity.getClass()));
-					});
-					((ITickable)tileentity).update();
-					profiler.endSection();
-				}
-				catch (Throwable var7) {
-					crashreport2 = CrashReport.makeCrashReport(var7, "Ticking block entity");
-					crashreportcategory2 = crashreport2.makeCategory("Block entity being ticked");
-					tileentity.addInfoToCrashReport(crashreportcategory2);
-					throw new ReportedException(crashreport2);
-				}
-			}
+		if (!regionsTicked)
+		{
+			tickTileEntity(tileentity);
 		}
 
 		if (tileentity->isInvalid()) 
@@ -1556,6 +1694,158 @@ void World::updateEntities()
 	profiler.endSection();
 }
 
+void World::setParallelEntityTicking(bool enabled)
+{
+	if (!enabled)
+	{
+		regionTicker.reset();
+	}
+	else if (regionTicker == nullptr)
+	{
+		regionTicker = std::make_unique<RegionTicker>();
+	}
+}
+
+bool World::isParallelEntityTicking() const
+{
+	return regionTicker != nullptr;
+}
+
+void World::setBatchedPhysics(bool enabled)
+{
+	batchedPhysics = enabled;
+}
+
+bool World::isBatchedPhysics() const
+{
+	return batchedPhysics;
+}
+
+bool World::queuePhysics(Entity* entityIn, double gravity, const EntityPhysicsBatch::Drag& drag)
+{
+	// region ticks already spread these entities over the workers and must not touch the shared batch
+	if (!batchedPhysics || RegionTicker::isTickingRegion())
+	{
+		return false;
+	}
+
+	entityPhysicsBatch.add(entityIn, gravity, drag);
+	return true;
+}
+
+EntityPhysicsBatch& World::getEntityPhysicsBatch()
+{
+	return entityPhysicsBatch;
+}
+
+void World::tickRegions()
+{
+	profiler.startSection("regions");
+	compactTileEntityLists();
+
+	regionTicker->partition(loadedEntityList, tickableTileEntities, rand);
+	// the regions only read the player index, a player leaving during tickPlayers() has to be applied here
+	if (playerProximityIndex.isDirty())
+	{
+		playerProximityIndex.rebuild(playerEntities);
+	}
+
+	// the profiler keeps one section stack, the regions must not push onto it concurrently
+	auto profiling = profiler.profilingEnabled;
+	profiler.profilingEnabled = false;
+	try
+	{
+		regionTicker->tick([this](Entity* entityIn)
+		{
+			if (entityIn->dormant)
+			{
+				return;
+			}
+
+			auto entity3 = entityIn->getRidingEntity();
+			if (entity3 != nullptr) 
+			{
+				if (!entity3->isDead && entity3->isPassenger(entityIn))
+				{
+					return;
+				}
+
+				entityIn->dismountRidingEntity();
+			}
+
+			if (!entityIn->isDead && !(Util::instanceof<EntityPlayerMP>(entityIn))) 
+			{
+				try
+				{
+					updateEntity(entityIn);
+				}
+				catch (std::exception& var8)
+				{
+					CrashReport crashreport = CrashReport::makeCrashReport(var8, "Ticking entity");
+					CrashReportCategory& crashreportcategory = crashreport.makeCategory("Entity being ticked");
+					entityIn->addEntityCrashInfo(crashreportcategory);
+					throw ReportedException(crashreport);
+				}
+			}
+		}, [this](TileEntity* tileEntityIn)
+		{
+			tickTileEntity(tileEntityIn);
+		});
+	}
+	catch (...)
+	{
+		profiler.profilingEnabled = profiling;
+		regionTicker->merge();
+		throw;
+	}
+
+	profiler.profilingEnabled = profiling;
+	profiler.endStartSection("merge");
+	regionTicker->merge();
+	profiler.endSection();
+}
+
+void World::compactTileEntityLists()
+{
+	if (tileEntitiesToBeRemoved.empty())
+	{
+		return;
+	}
+
+	auto removed = [](TileEntity* tileentity) { return tileentity->removalPending; };
+	tickableTileEntities.erase(std::remove_if(tickableTileEntities.begin(), tickableTileEntities.end(), removed), tickableTileEntities.end());
+	loadedTileEntityList.erase(std::remove_if(loadedTileEntityList.begin(), loadedTileEntityList.end(), removed), loadedTileEntityList.end());
+	for (auto tileentity : tileEntitiesToBeRemoved)
+	{
+		tileentity->removalPending = false;
+	}
+
+	tileEntitiesToBeRemoved.clear();
+}
+
+void World::tickTileEntity(TileEntity* tileentity)
+{
+	if (!tileentity.isInvalid() && tileentity.hasWorld()) {
+		BlockPos blockpos = tileentity.getPos();
+		if (isBlockLoaded(blockpos) && worldBorder.contains(blockpos)) 
+		{
+			try {
+				profiler.func_194340_a(() -> {
+					return String.valueOf(TileEntity.getKey(tileentity.getClass()));
+				});
+				((ITickable)tileentity).update();
+				profiler.endSection();
+			}
+			catch (Throwable var7) {
+				CrashReport crashreport2 = CrashReport.makeCrashReport(var7, "Ticking block entity");
+				CrashReportCategory crashreportcategory2 = crashreport2.makeCategory("Block entity being ticked");
+				tileentity.addInfoToCrashReport(crashreportcategory2);
+				throw new ReportedException(crashreport2);
+			}
+		}
+	}
+}
+
 bool World::addTileEntity(TileEntity* tile)
 {
 	bool flag = loadedTileEntityList.emplace_back(tile);
@@ -1617,9 +1907,12 @@ void World::updateEntityWithOptionalForce(Entity* entityIn, bool forceUpdate)
 		if (entityIn.isRiding()) {
 			entityIn.updateRidden();
 		}
-		else {
+		else if (isRemote || entityActivationRange.checkIfActive(entityIn, getTotalWorldTime())) {
 			entityIn.onUpdate();
 		}
+		else {
+			entityIn->inactiveTick();
+		}
 	}
 
 	profiler.startSection("chunkCheck");
@@ -1648,24 +1941,10 @@ void World::updateEntityWithOptionalForce(Entity* entityIn, bool forceUpdate)
 		entityIn.rotationYaw = entityIn.prevRotationYaw;
 	}
 
-	auto i3 = MathHelper::floor(entityIn.posX / 16.0);
-	auto j3 = MathHelper::floor(entityIn.posY / 16.0);
-	auto k3 = MathHelper::floor(entityIn.posZ / 16.0);
-	if (!entityIn.addedToChunk || entityIn.chunkCoordX != i3 || entityIn.chunkCoordY != j3 || entityIn.chunkCoordZ != k3) 
+	// chunk entity lists and the entity index are shared between regions
+	if (!RegionTicker::deferIfTicking([this, entityIn]() { updateEntityChunk(entityIn); }))
 	{
-		if (entityIn.addedToChunk && isChunkLoaded(entityIn.chunkCoordX, entityIn.chunkCoordZ, true)) 
-		{
-			getChunk(entityIn.chunkCoordX, entityIn.chunkCoordZ).removeEntityAtIndex(entityIn, entityIn.chunkCoordY);
-		}
-
-		if (!entityIn.setPositionNonDirty() && !isChunkLoaded(i3, k3, true)) 
-		{
-			entityIn.addedToChunk = false;
-		}
-		else 
-		{
-			getChunk(i3, k3).addEntity(entityIn);
-		}
+		updateEntityChunk(entityIn);
 	}
 
 	profiler.endSection();
@@ -1690,6 +1969,33 @@ void World::updateEntityWithOptionalForce(Entity* entityIn, bool forceUpdate)
 	}
 }
 
+void World::updateEntityChunk(Entity* entityIn)
+{
+	auto i3 = MathHelper::floor(entityIn.posX / 16.0);
+	auto j3 = MathHelper::floor(entityIn.posY / 16.0);
+	auto k3 = MathHelper::floor(entityIn.posZ / 16.0);
+	if (!entityIn.addedToChunk || entityIn.chunkCoordX != i3 || entityIn.chunkCoordY != j3 || entityIn.chunkCoordZ != k3) 
+	{
+		if (entityIn.addedToChunk && isChunkLoaded(entityIn.chunkCoordX, entityIn.chunkCoordZ, true)) 
+		{
+			getChunk(entityIn.chunkCoordX, entityIn.chunkCoordZ).removeEntityAtIndex(entityIn, entityIn.chunkCoordY);
+		}
+
+		if (!entityIn.setPositionNonDirty() && !isChunkLoaded(i3, k3, true)) 
+		{
+			entityIn.addedToChunk = false;
+		}
+		else 
+		{
+			getChunk(i3, k3).addEntity(entityIn);
+		}
+
+		itemMergeIndex.update(entityIn);
+	}
+
+	entitySpatialIndex.update(entityIn);
+}
+
 bool World::checkNoEntityCollision(AxisAlignedBB& bb)
 {
 	return checkNoEntityCollision(bb, std::nullopt);
@@ -1986,6 +2292,11 @@ TileEntity* World::getPendingTileEntityAt(BlockPos& pos)
 
 void World::setTileEntity(BlockPos& pos, TileEntity* tileEntityIn)
 {
+	if (RegionTicker::deferIfTicking([this, pos, tileEntityIn]() mutable { setTileEntity(pos, tileEntityIn); }))
+	{
+		return;
+	}
+
 	if (!isOutsideBuildHeight(pos) && tileEntityIn != nullptr && !tileEntityIn.isInvalid()) {
 		if (processingLoadedTiles) 
 		{
@@ -2014,6 +2325,11 @@ void World::setTileEntity(BlockPos& pos, TileEntity* tileEntityIn)
 
 void World::removeTileEntity(BlockPos& pos)
 {
+	if (RegionTicker::deferIfTicking([this, pos]() mutable { removeTileEntity(pos); }))
+	{
+		return;
+	}
+
 	auto tileentity2 = getTileEntity(pos);
 	if (tileentity2 != nullptr && processingLoadedTiles) 
 	{
@@ -2025,8 +2341,7 @@ void World::removeTileEntity(BlockPos& pos)
 		if (tileentity2 != nullptr) 
 		{
 			addedTileEntityList.erase(std::find(addedTileEntityList.begin(), addedTileEntityList.end(), tileentity2));
-			loadedTileEntityList.erase(std::find(loadedTileEntityList.begin(), loadedTileEntityList.end(), tileentity2));
-			tickableTileEntities.erase(std::find(tickableTileEntities.begin(), tickableTileEntities.end(), tileentity2));
+			markTileEntityForRemoval(tileentity2);
 		}
 
 		getChunk(pos).removeTileEntity(pos);
@@ -2035,7 +2350,11 @@ void World::removeTileEntity(BlockPos& pos)
 
 void World::markTileEntityForRemoval(TileEntity* tileEntityIn)
 {
-	tileEntitiesToBeRemoved.emplace_back(tileEntityIn);
+	if (!tileEntityIn->removalPending)
+	{
+		tileEntityIn->removalPending = true;
+		tileEntitiesToBeRemoved.emplace_back(tileEntityIn);
+	}
 }
 
 bool World::isBlockFullCube(BlockPos& pos)
@@ -2244,6 +2563,12 @@ int32_t World::getRawLight(BlockPos pos, EnumSkyBlock lightType)
 
 bool World::checkLightFor(EnumSkyBlock lightType, BlockPos& pos)
 {
+	// queued until the merge, nothing has been relit yet
+	if (RegionTicker::deferIfTicking([this, lightType, pos]() mutable { checkLightFor(lightType, pos); }))
+	{
+		return false;
+	}
+
 	if (!isAreaLoaded(pos, 17, false)) 
 	{
 		return false;
@@ -2414,34 +2739,168 @@ std::vector<NextTickListEntry> World::getPendingBlockUpdates(StructureBoundingBo
 std::vector<Entity*> World::getEntitiesInAABBexcluding(Entity* entityIn, AxisAlignedBB& boundingBox, std::function<bool(Entity*)> predicate)
 {
 	std::vector<Entity*> list;
-	auto j2 = MathHelper::floor((boundingBox.getminX() - 2.0) / 16.0);
-	auto k2 = MathHelper::floor((boundingBox.getmaxX() + 2.0) / 16.0);
-	auto l2 = MathHelper::floor((boundingBox.getminZ() - 2.0) / 16.0);
-	auto i3 = MathHelper::floor((boundingBox.getmaxZ() + 2.0) / 16.0);
+	getEntitiesInAABBexcluding(entityIn, boundingBox, predicate, list);
+	return list;
+}
 
-	for (auto j3 = j2; j3 <= k2; ++j3) 
+void World::getEntitiesInAABBexcluding(Entity* entityIn, const AxisAlignedBB& boundingBox, const std::function<bool(Entity*)>& predicate, std::vector<Entity*>& listToFill)
+{
+	entitySpatialIndex.forEachEntityWithinAABB(boundingBox, EntitySpatialIndex::ALL, [&](Entity* entity)
 	{
-		for (auto k3 = l2; k3 <= i3; ++k3) 
+		if (entity == entityIn)
+		{
+			return;
+		}
+
+		if (!predicate || predicate(entity))
 		{
-			if (isChunkLoaded(j3, k3, true)) 
+			listToFill.emplace_back(entity);
+		}
+
+		for (auto part : entity->getParts())
+		{
+			if (part != entityIn && part->getEntityBoundingBox().intersects(boundingBox) && (!predicate || predicate(part)))
 			{
-				getChunk(j3, k3).getEntitiesWithinAABBForEntity(entityIn, boundingBox, list, predicate);
+				listToFill.emplace_back(part);
 			}
 		}
+	});
+}
+
+const EntitySpatialIndex& World::getEntitySpatialIndex() const
+{
+	return entitySpatialIndex;
+}
+
+EntityActivationRange& World::getEntityActivationRange()
+{
+	return entityActivationRange;
+}
+
+void World::setEntityDormant(Entity* entityIn, const std::vector<BlockPos>& supportPositions)
+{
+	// the closure copies the positions, so it is only built inside a region tick
+	if (RegionTicker::isTickingRegion() && RegionTicker::deferIfTicking([this, entityIn, supportPositions]() { setEntityDormant(entityIn, supportPositions); }))
+	{
+		return;
 	}
 
-	return list;
+	if (entityIn->dormant || entityIn->isDead || !entityIn->addedToChunk)
+	{
+		return;
+	}
+
+	dormantEntities.add(entityIn, supportPositions);
+	entityIn->dormant = true;
+}
+
+void World::wakeEntity(Entity* entityIn)
+{
+	if (RegionTicker::deferIfTicking([this, entityIn]() { wakeEntity(entityIn); }))
+	{
+		return;
+	}
+
+	if (entityIn->dormant)
+	{
+		dormantEntities.remove(entityIn);
+		entityIn->dormant = false;
+		entityIn->onWake();
+	}
+}
+
+size_t World::getDormantEntityCount() const
+{
+	return dormantEntities.size();
+}
+
+void World::requestItemMerge(Entity* entityIn)
+{
+	if (RegionTicker::deferIfTicking([this, entityIn]() { requestItemMerge(entityIn); }))
+	{
+		return;
+	}
+
+	itemMergeIndex.requestMerge(entityIn);
+}
+
+ItemMergeIndex& World::getItemMergeIndex()
+{
+	return itemMergeIndex;
+}
+
+void World::requestEntityPush(EntityLivingBase* entityIn)
+{
+	if (RegionTicker::deferIfTicking([this, entityIn]() { requestEntityPush(entityIn); }))
+	{
+		return;
+	}
+
+	entityPushBroadphase.requestPush(entityIn);
+}
+
+EntityPushBroadphase& World::getEntityPushBroadphase()
+{
+	return entityPushBroadphase;
+}
+
+void World::wakeDormantEntitiesAt(const BlockPos& pos)
+{
+	if (dormantEntities.empty())
+	{
+		return;
+	}
+
+	if (RegionTicker::deferIfTicking([this, pos]() { wakeDormantEntitiesAt(pos); }))
+	{
+		return;
+	}
+
+	std::vector<Entity*> woken;
+	dormantEntities.takeSupportedBy(pos, woken);
+	for (auto entity : woken)
+	{
+		entity->dormant = false;
+		entity->onWake();
+	}
 }
 
 Entity* World::getEntityByID(int32_t id)
 {
-	const auto ite = entitiesById.find(id);
-	if (ite != entitiesById.end())
+	return entitySlots.getById(id);
+}
+
+Entity* World::getEntityByHandle(EntityHandle handle) const
+{
+	return entitySlots.get(handle);
+}
+
+void World::markEntityDataDirty(Entity* entityIn, uint32_t field)
+{
+	auto bit = field == ATTRIBUTES_DATA_FIELD ? field : std::min(field, ATTRIBUTES_DATA_FIELD - 1);
+	auto handle = entityIn->getHandle();
+	// an entity outside the world is queued by onEntityAdded
+	if (!entityIn->markDataDirty(uint64_t{1} << bit) || !handle.isValid())
 	{
-		return ite->second;
+		return;
 	}
-	else
-		return nullptr;
+
+	if (RegionTicker::deferIfTicking([this, handle]() { dirtyEntities.emplace_back(handle); }))
+	{
+		return;
+	}
+
+	dirtyEntities.emplace_back(handle);
+}
+
+const std::vector<EntityHandle>& World::getDirtyEntities() const
+{
+	return dirtyEntities;
+}
+
+void World::clearDirtyEntities()
+{
+	dirtyEntities.clear();
 }
 
 std::vector<Entity*> World::getLoadedEntityList() const
@@ -2470,7 +2929,12 @@ void World::loadEntities(std::initializer_list<Entity*> entityCollection)
 
 void World::unloadEntities(std::initializer_list<Entity*> entityCollection)
 {
-	unloadedEntityList.insert(unloadedEntityList.end(),entityCollection);
+	// the chunk hands over its own entity lists, nothing here searches loadedEntityList
+	for (auto entity4 : entityCollection)
+	{
+		markEntityForRemoval(entity4);
+		unloadedEntityList.emplace_back(entity4);
+	}
 }
 
 bool World::mayPlace(Block* blockIn, BlockPos& pos, bool skipCollisionCheck, EnumFacing sidePlacedOn, Entity* placer)
@@ -2630,19 +3094,28 @@ EntityPlayer* World::getClosestPlayer(double posX, double posY, double posZ, dou
 
 bool World::isAnyPlayerWithinRangeAt(double x, double y, double z, double range)
 {
-	for (auto entityplayer : playerEntities)
+	if (range < 0.0)
 	{
-		if (EntitySelectors::NOT_SPECTATING(entityplayer)) 
-		{
-			double d0 = entityplayer.getDistanceSq(x, y, z);
-			if (range < 0.0 || d0 < range * range) 
-			{
-				return true;
-			}
-		}
+		return std::any_of(playerEntities.begin(), playerEntities.end(), EntitySelectors::NOT_SPECTATING);
 	}
 
-	return false;
+	auto found = false;
+	getPlayerProximityIndex().forEachPlayerNear(x, z, range, [&](EntityPlayer* entityplayer, uint32_t)
+	{
+		found = found || (EntitySelectors::NOT_SPECTATING(entityplayer) && entityplayer->getDistanceSq(x, y, z) < range * range);
+	});
+	return found;
+}
+
+PlayerProximityIndex& World::getPlayerProximityIndex()
+{
+	// tickRegions() rebuilds it before the regions start, rebuilding from a worker would race the others
+	if (playerProximityIndex.isDirty() && !RegionTicker::isTickingRegion())
+	{
+		playerProximityIndex.rebuild(playerEntities);
+	}
+
+	return playerProximityIndex;
 }
 
 EntityPlayer* World::getNearestAttackablePlayer(Entity* entityIn, double maxXZDistance, double maxYDistance)
@@ -2780,7 +3253,7 @@ WorldInfo World::getWorldInfo()
 	return worldInfo;
 }
 
-GameRules World::getGameRules()
+GameRules& World::getGameRules()
 {
 	return worldInfo.getGameRulesInstance();
 }
@@ -2872,6 +3345,11 @@ int32_t World::getUniqueDataId(std::string key)
 
 void World::playBroadcastSound(int32_t id, BlockPos& pos, int32_t data)
 {
+	if (RegionTicker::deferIfTicking([this, id, pos, data]() mutable { playBroadcastSound(id, pos, data); }))
+	{
+		return;
+	}
+
 	for (auto ev : eventListeners)
 	{
 		ev.broadcastSound(id, pos, data);
@@ -2885,6 +3363,11 @@ void World::playEvent(int32_t type, BlockPos& pos, int32_t data)
 
 void World::playEvent(EntityPlayer* player, int32_t type, BlockPos& pos, int32_t data)
 {
+	if (RegionTicker::deferIfTicking([this, player, type, pos, data]() mutable { playEvent(player, type, pos, data); }))
+	{
+		return;
+	}
+
 	try {
 		for (auto ev : eventListeners)
 		{
@@ -2916,8 +3399,15 @@ int32_t World::getActualHeight()
 pcg32& World::setRandomSeed(int32_t seedX, int32_t seedY, int32_t seedZ)
 {
 	uint64_t j2 = static_cast<uint64_t>(seedX) * 341873128712 + static_cast<uint64_t>(seedY) * 132897987541 + getWorldInfo().getSeed() + static_cast<uint64_t>(seedZ);
-	rand.seed(j2);
-	return rand;
+	auto& random = getRandom();
+	random.seed(j2);
+	return random;
+}
+
+pcg32& World::getRandom()
+{
+	auto random = RegionTicker::getRegionRandom();
+	return random != nullptr ? *random : rand;
 }
 
 double World::getHorizon()
@@ -2927,6 +3417,11 @@ double World::getHorizon()
 
 void World::sendBlockBreakProgress(int32_t breakerId, BlockPos& pos, int32_t progress)
 {
+	if (RegionTicker::deferIfTicking([this, breakerId, pos, progress]() mutable { sendBlockBreakProgress(breakerId, pos, progress); }))
+	{
+		return;
+	}
+
 	for (auto iworldeventlistener : eventListeners)
 	{
 		iworldeventlistener.sendBlockBreakProgress(breakerId, pos, progress);
@@ -8,7 +8,16 @@
 #include "DimensionType.h"
 #include "GameRules.h"
 #include "DifficultyInstance.h"
+#include "DormantEntityIndex.h"
+#include "EntityActivationRange.h"
+#include "EntitySpatialIndex.h"
+#include "PlayerProximityIndex.h"
+#include "RegionTicker.h"
 #include "EnumDifficulty.h"
+#include "ItemMergeIndex.h"
+#include "EntityPushBroadphase.h"
+#include "EntityPhysicsBatch.h"
+#include "EntitySlotMap.h"
 #include "WorldType.h"
 #include "WorldSettings.h"
 #include "../pathfinding/PathWorldListener.h"
@@ -27,6 +36,7 @@
 #include "gen/ChunkGeneratorEnd.h"
 
 
+class EntityLivingBase;
 class NextTickListEntry;
 class Packet;
 class StructureBoundingBox;
@@ -40,6 +50,8 @@ class SoundCategory;
 class World :public IBlockAccess
 {
 public:
+	// the dirty bit of an entity's watched attributes, past the DataParameter ids
+	static constexpr uint32_t ATTRIBUTES_DATA_FIELD = 63;
 	std::vector<Entity*> loadedEntityList;
 	std::vector<TileEntity*> loadedTileEntityList;
 	std::vector<TileEntity*> tickableTileEntities;
@@ -117,6 +129,8 @@ public:
 	void addEventListener(IWorldEventListener* listener);
 	void removeEventListener(IWorldEventListener* listener);
 	std::optional<std::vector<AxisAlignedBB>> getCollisionBoxes(Entity* entityIn, AxisAlignedBB& aabb);
+	// Appends the block and entity boxes entityIn collides with inside aabb; no allocation once listToFill has grown.
+	void getCollisionBoxes(Entity* entityIn, const AxisAlignedBB& aabb, std::vector<AxisAlignedBB>& listToFill);
 	bool isInsideWorldBorder(Entity* entityToCheck);
 	bool collidesWithAnyBlock(AxisAlignedBB& bbox);
 	int32_t calculateSkylightSubtracted(float partialTicks);
@@ -170,6 +184,9 @@ public:
     virtual std::vector<NextTickListEntry> getPendingBlockUpdates(StructureBoundingBox& structureBB, bool remove);
 	std::vector<Entity*> getEntitiesWithinAABBExcludingEntity(Entity* entityIn, AxisAlignedBB& bb);
 	std::vector<Entity*> getEntitiesInAABBexcluding(Entity* entityIn, AxisAlignedBB& boundingBox, std::function<bool(Entity*)> predicate);
+	void getEntitiesInAABBexcluding(Entity* entityIn, const AxisAlignedBB& boundingBox, const std::function<bool(Entity*)>& predicate, std::vector<Entity*>& listToFill);
+	template<class Class, typename Visitor>
+	void forEachEntityWithinAABB(const AxisAlignedBB& aabb, Visitor&& visitor);
 	template<class Class,typename Predicate>
 	std::vector<Entity*> getEntities(Predicate filter);
 	template<class Class, typename Predicate>
@@ -178,9 +195,31 @@ public:
 	std::vector<Class*> getEntitiesWithinAABB(const AxisAlignedBB& bb);
 	template<class Class, typename Predicate>
 	std::vector<Class*> getEntitiesWithinAABB(const AxisAlignedBB& aabb, Predicate filter);
+	template<class Class, typename Predicate>
+	void getEntitiesWithinAABB(const AxisAlignedBB& aabb, Predicate filter, std::vector<Class*>& listToFill);
+	const EntitySpatialIndex& getEntitySpatialIndex() const;
+	EntityActivationRange& getEntityActivationRange();
+	// Leaves entityIn out of the entity tick until a block at one of supportPositions changes or it is woken.
+	void setEntityDormant(Entity* entityIn, const std::vector<BlockPos>& supportPositions);
+	void wakeEntity(Entity* entityIn);
+	size_t getDormantEntityCount() const;
+	// Queues a dropped item or XP orb to merge with compatible neighbours at the end of the entity tick.
+	void requestItemMerge(Entity* entityIn);
+	ItemMergeIndex& getItemMergeIndex();
+	// Queues entityIn to be pushed by the entities it touches once the entity tick is over.
+	void requestEntityPush(EntityLivingBase* entityIn);
+	EntityPushBroadphase& getEntityPushBroadphase();
 	template<class Class>
 	Entity* findNearestEntityWithinAABB(AxisAlignedBB& aabb, Entity* closestTo);
 	Entity* getEntityByID(int32_t id);
+	// The entity behind handle, or nullptr once it left this world.
+	Entity* getEntityByHandle(EntityHandle handle) const;
+	// Flags a watched field of entityIn, its DataParameter id or ATTRIBUTES_DATA_FIELD, as changed since the entity
+	// tracker last flushed it. The first change queues the entity on the dirty entity list.
+	void markEntityDataDirty(Entity* entityIn, uint32_t field);
+	// The entities with changed watched data, in the order they changed; entries may no longer resolve.
+	const std::vector<EntityHandle>& getDirtyEntities() const;
+	void clearDirtyEntities();
 	std::vector<Entity*> getLoadedEntityList() const;
 	void markChunkDirty(BlockPos& pos, TileEntity* unusedTileEntity);
 	template<class Class>
@@ -208,6 +247,18 @@ public:
 	template<class Predicate, class Function>
 	EntityPlayer* getNearestAttackablePlayer(double posX, double posY, double posZ, double maxXZDistance, double maxYDistance, std::optional<Function> playerToDouble, Predicate predicate);
 	EntityPlayer* getPlayerEntityByName(std::string name);
+	PlayerProximityIndex& getPlayerProximityIndex();
+	// Ticks far apart groups of entities and tile entities on worker threads; follows the parallelEntityTicking
+	// game rule each tick, off by default.
+	void setParallelEntityTicking(bool enabled);
+	bool isParallelEntityTicking() const;
+	// Moves items, XP orbs, falling blocks and primed TNT together after the entity tick; follows the
+	// batchedEntityPhysics game rule each tick, off by default.
+	void setBatchedPhysics(bool enabled);
+	bool isBatchedPhysics() const;
+	// Queues the gravity and move step of entityIn on the physics batch; false when the caller must run it itself.
+	bool queuePhysics(Entity* entityIn, double gravity, const EntityPhysicsBatch::Drag& drag);
+	EntityPhysicsBatch& getEntityPhysicsBatch();
 	EntityPlayer* getPlayerEntityByUUID(xg::Guid& uuid);
 	void sendQuittingDisconnectingPacket();
 	void checkSessionLock();
@@ -225,7 +276,7 @@ public:
 	virtual void addBlockEvent(BlockPos& pos, Block* blockIn, int32_t eventID, int32_t eventParam);
 	ISaveHandler* getSaveHandler();
 	WorldInfo getWorldInfo();
-	GameRules getGameRules();
+	GameRules& getGameRules();
 	virtual void updateAllPlayersSleepingFlag();
 	float getThunderStrength(float delta);
 	void setThunderStrength(float strength);
@@ -238,7 +289,7 @@ public:
 	MapStorage* getMapStorage();
 	void setData(std::string dataID, WorldSavedData* worldSavedDataIn);
 	template<class Class>
-	WorldSavedData* loadData(std::string_view dataID);
+	std::shared_ptr<WorldSavedData> loadData(std::string_view dataID);
 	int32_t getUniqueDataId(std::string key);
 	void playBroadcastSound(int32_t id, BlockPos& pos, int32_t data);
 	void playEvent(int32_t type, BlockPos& pos, int32_t data);
@@ -246,6 +297,8 @@ public:
 	int32_t getHeight() const;
 	int32_t getActualHeight();
 	pcg32& setRandomSeed(int32_t seedX, int32_t seedY, int32_t seedZ);
+	// rand, or the generator of the region being ticked on this thread while regions tick in parallel
+	pcg32& getRandom();
 	double getHorizon();
 	CrashReportCategory addWorldInfoToCrashReport(CrashReport report);
 	void sendBlockBreakProgress(int32_t breakerId, BlockPos& pos, int32_t progress);
@@ -269,7 +322,18 @@ public:
 protected:
 	bool scheduledUpdatesAreImmediate;
 	std::vector<Entity*> unloadedEntityList;
-	std::unordered_map<uint32_t, Entity*>entitiesById;
+	bool entityRemovalsPending = false;
+	EntitySlotMap entitySlots;
+	std::vector<EntityHandle> dirtyEntities;
+	EntitySpatialIndex entitySpatialIndex;
+	PlayerProximityIndex playerProximityIndex;
+	EntityActivationRange entityActivationRange;
+	DormantEntityIndex dormantEntities;
+	ItemMergeIndex itemMergeIndex;
+	EntityPushBroadphase entityPushBroadphase;
+	EntityPhysicsBatch entityPhysicsBatch;
+	bool batchedPhysics = false;
+	std::unique_ptr<RegionTicker> regionTicker;
 	uint32_t updateLCG;
 	uint32_t DIST_HASH_MAGIC = 1013904223;
 	float prevRainingStrength;
@@ -296,6 +360,10 @@ protected:
 	virtual void onEntityAdded(Entity* entityIn);
 	virtual void onEntityRemoved(Entity* entityIn);
 	virtual void tickPlayers();
+	// Tombstones an entity, it stays in loadedEntityList until compactEntityList drops it.
+	void markEntityForRemoval(Entity* entityIn);
+	// Drops every tombstoned entity from loadedEntityList in one stable pass.
+	void compactEntityList();
 	void calculateInitialWeather();
 	virtual void updateWeather();
 	void playMoodSoundAndCheckLight(int32_t x, int32_t z, Chunk& chunkIn);
@@ -315,9 +383,15 @@ private:
 	bool isOutsideBuildHeight(BlockPos& pos) const;
 	bool isAreaLoaded(int32_t xStart, int32_t yStart, int32_t zStart, int32_t xEnd, int32_t yEnd, int32_t zEnd, bool allowEmpty);
 	void spawnParticle(int32_t particleID, bool ignoreRange, double xCood, double yCoord, double zCoord, double xSpeed, double ySpeed, double zSpeed, std::initializer_list<int32_t> parameters);
-	bool getCollisionBoxes(Entity* entityIn, AxisAlignedBB aabb, bool p_191504_3_, std::optional<std::vector<AxisAlignedBB>>& outList);
+	bool getCollisionBoxes(Entity* entityIn, const AxisAlignedBB& aabb, bool p_191504_3_, std::vector<AxisAlignedBB>& outList);
+	void addDynamicCollisionBoxes(IBlockState* state, Entity* entityIn, const BlockPos& pos, const AxisAlignedBB& aabb, std::vector<AxisAlignedBB>& outList);
 	bool isWater(BlockPos& pos);
 	int32_t getRawLight(BlockPos pos, EnumSkyBlock lightType);
+	void updateEntityChunk(Entity* entityIn);
+	void wakeDormantEntitiesAt(const BlockPos& pos);
+	void tickRegions();
+	void compactTileEntityLists();
+	void tickTileEntity(TileEntity* tileentity);
 };
 
 template <class Class, class Predicate>
@@ -326,7 +400,7 @@ std::vector<Entity*> World::getEntities(Predicate filter)
 	std::vector<Entity*> list;
 	for (auto entity4 : loadedEntityList)
 	{
-		if (Util::instanceof<Class>(entity4) && filter(entity4))
+		if (!entity4->removalPending && Util::instanceof<Class>(entity4) && filter(entity4))
 		{
 			list.emplace_back(entity4);
 		}
@@ -357,37 +431,49 @@ std::vector<Class*> World::getEntitiesWithinAABB(const AxisAlignedBB& bb)
 	return getEntitiesWithinAABB<Class>(bb, EntitySelectors::NOT_SPECTATING);
 }
 
+template <class Class, typename Visitor>
+void World::forEachEntityWithinAABB(const AxisAlignedBB& aabb, Visitor&& visitor)
+{
+	entitySpatialIndex.forEachEntityWithinAABB(aabb, EntitySpatialIndex::getCategories<Class>(), [&visitor](Entity* entity)
+	{
+		if constexpr (EntitySpatialIndex::isExactCategory<Class>() && std::is_base_of_v<Entity, Class>)
+		{
+			visitor(static_cast<Class*>(entity));
+		}
+		else if (auto t = dynamic_cast<Class*>(entity))
+		{
+			visitor(t);
+		}
+	});
+}
+
 template <class Class, typename Predicate>
 std::vector<Class*> World::getEntitiesWithinAABB(const AxisAlignedBB& aabb, Predicate filter)
 {
-	auto j2 = MathHelper::floor((aabb.getminX() - 2.0) / 16.0);
-	auto k2 = MathHelper::ceil((aabb.getmaxX() + 2.0) / 16.0);
-	auto l2 = MathHelper::floor((aabb.getminZ() - 2.0) / 16.0);
-	auto i3 = MathHelper::ceil((aabb.getmaxZ() + 2.0) / 16.0);
-	std::vector<Entity*> list;
+	std::vector<Class*> list;
+	getEntitiesWithinAABB<Class>(aabb, filter, list);
+	return list;
+}
 
-	for (auto j3 = j2; j3 < k2; ++j3) 
+template <class Class, typename Predicate>
+void World::getEntitiesWithinAABB(const AxisAlignedBB& aabb, Predicate filter, std::vector<Class*>& listToFill)
+{
+	forEachEntityWithinAABB<Class>(aabb, [&](Class* t)
 	{
-		for (auto k3 = l2; k3 < i3; ++k3) 
+		if (filter(t))
 		{
-			if (isChunkLoaded(j3, k3, true)) 
-			{
-				getChunk(j3, k3).getEntitiesOfTypeWithinAABB<Class>(aabb, list, filter);
-			}
+			listToFill.emplace_back(t);
 		}
-	}
-
-	return list;
+	});
 }
 
 template <class Class>
 Entity* World::findNearestEntityWithinAABB(AxisAlignedBB& aabb, Entity* closestTo)
 {
-	auto list = getEntitiesWithinAABB<Class>(aabb);
-	auto t = nullptr;
+	Class* t = nullptr;
 	double d0 = std::numeric_limits<double>::max();
 
-	for (auto t1 : list)
+	forEachEntityWithinAABB<Class>(aabb, [&](Class* t1)
 	{
 		if (t1 != closestTo && EntitySelectors::NOT_SPECTATING(t1)) 
 		{
@@ -398,7 +484,7 @@ Entity* World::findNearestEntityWithinAABB(AxisAlignedBB& aabb, Entity* closestT
 				d0 = d1;
 			}
 		}
-	}
+	});
 
 	return t;
 }
@@ -432,18 +518,33 @@ EntityPlayer* World::getClosestPlayer(double x, double y, double z, double dista
 {
 	double d0 = -1.0;
 	EntityPlayer* entityplayer = nullptr;
+	uint32_t order = 0;
 
-	for (auto entityplayer1 : playerEntities)
+	// the index visits players out of list order, ties go to the earlier player as the plain scan did
+	auto test = [&](EntityPlayer* entityplayer1, uint32_t order1)
 	{
 		if (predicate(entityplayer1)) 
 		{
 			double d1 = entityplayer1->getDistanceSq(x, y, z);
-			if ((distance < 0.0 || d1 < distance * distance) && (d0 == -1.0 || d1 < d0)) 
+			if ((distance < 0.0 || d1 < distance * distance) && (d0 == -1.0 || d1 < d0 || (d1 == d0 && order1 < order))) 
 			{
 				d0 = d1;
 				entityplayer = entityplayer1;
+				order = order1;
 			}
 		}
+	};
+
+	if (distance < 0.0)
+	{
+		for (uint32_t i = 0; i < playerEntities.size(); ++i)
+		{
+			test(playerEntities[i], i);
+		}
+	}
+	else
+	{
+		getPlayerProximityIndex().forEachPlayerNear(x, z, distance, test);
 	}
 
 	return entityplayer;
@@ -455,8 +556,9 @@ EntityPlayer* World::getNearestAttackablePlayer(double posX, double posY, double
 {
 	double d0 = -1.0;
 	EntityPlayer* entityplayer = nullptr;
+	uint32_t order = 0;
 
-	for (auto entityplayer1 : playerEntities)
+	auto test = [&](EntityPlayer* entityplayer1, uint32_t order1)
 	{
 		if (!entityplayer1->capabilities.disableDamage && entityplayer1->isEntityAlive() && !entityplayer1->isSpectator() && (!predicate || predicate(entityplayer1))) 
 		{
@@ -479,19 +581,33 @@ EntityPlayer* World::getNearestAttackablePlayer(double posX, double posY, double
 				d2 *= (Double)MoreObjects.firstNonNull(playerToDouble(entityplayer1), 1.0);
 			}
 
-			if ((maxYDistance < 0.0 || MathHelper::abs(entityplayer1->posY - posY) < maxYDistance * maxYDistance) && (maxXZDistance < 0.0 || d1 < d2 * d2) && (d0 == -1.0 || d1 < d0)) 
+			if ((maxYDistance < 0.0 || MathHelper::abs(entityplayer1->posY - posY) < maxYDistance * maxYDistance) && (maxXZDistance < 0.0 || d1 < d2 * d2) && (d0 == -1.0 || d1 < d0 || (d1 == d0 && order1 < order))) 
 			{
 				d0 = d1;
 				entityplayer = entityplayer1;
+				order = order1;
 			}
 		}
+	};
+
+	// sneaking, invisibility and the per-player modifiers (skulls) only ever shrink the reach below maxXZDistance
+	if (maxXZDistance < 0.0)
+	{
+		for (uint32_t i = 0; i < playerEntities.size(); ++i)
+		{
+			test(playerEntities[i], i);
+		}
+	}
+	else
+	{
+		getPlayerProximityIndex().forEachPlayerNear(posX, posZ, maxXZDistance, test);
 	}
 
 	return entityplayer;
 }
 
 template <class Class>
-WorldSavedData* World::loadData(std::string_view dataID)
+std::shared_ptr<WorldSavedData> World::loadData(std::string_view dataID)
 {
 	return mapStorage.getOrLoadData<Class>(dataID);
 }
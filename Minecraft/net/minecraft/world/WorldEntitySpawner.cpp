@@ -73,9 +73,9 @@ int32_t WorldEntitySpawner::findChunksForSpawning(WorldServer& worldServerIn, bo
 										int l3 = MathHelper.ceil(Math.random() * 4.0D);
 
 										for (int i4 = 0; i4 < l3; ++i4) {
-											l2 += worldServerIn.rand.nextInt(6) - worldServerIn.rand.nextInt(6);
-											i3 += worldServerIn.rand.nextInt(1) - worldServerIn.rand.nextInt(1);
-											j3 += worldServerIn.rand.nextInt(6) - worldServerIn.rand.nextInt(6);
+											l2 += worldServerIn.getRandom().nextInt(6) - worldServerIn.getRandom().nextInt(6);
+											i3 += worldServerIn.getRandom().nextInt(1) - worldServerIn.getRandom().nextInt(1);
+											j3 += worldServerIn.getRandom().nextInt(6) - worldServerIn.getRandom().nextInt(6);
 											blockpos$mutableblockpos.setPos(l2, i3, j3);
 											float f = (float)l2 + 0.5F;
 											float f1 = (float)j3 + 0.5F;
@@ -97,7 +97,7 @@ int32_t WorldEntitySpawner::findChunksForSpawning(WorldServer& worldServerIn, bo
 														return j4;
 													}
 
-													entityliving.setLocationAndAngles((double)f, (double)i3, (double)f1, worldServerIn.rand.nextFloat() * 360.0F, 0.0F);
+													entityliving.setLocationAndAngles((double)f, (double)i3, (double)f1, worldServerIn.getRandom().nextFloat() * 360.0F, 0.0F);
 													if (entityliving.getCanSpawnHere() && entityliving.isNotColliding()) {
 														ientitylivingdata = entityliving.onInitialSpawn(worldServerIn.getDifficultyForLocation(new BlockPos(entityliving)), ientitylivingdata);
 														if (entityliving.isNotColliding()) {
@@ -171,10 +171,10 @@ bool WorldEntitySpawner::isValidEmptySpawnBlock(IBlockState* state)
 BlockPos WorldEntitySpawner::getRandomChunkPosition(World* worldIn, int32_t x, int32_t z) const
 {
 	auto chunk = worldIn.getChunk(x, z);
-	int i = x * 16 + worldIn->rand(16);
-	int j = z * 16 + worldIn->rand(16);
+	int i = x * 16 + worldIn->getRandom()(16);
+	int j = z * 16 + worldIn->getRandom()(16);
 	int k = MathHelper::roundUp(chunk.getHeight(BlockPos(i, 0, j)) + 1, 16);
-	int l = worldIn->rand(k > 0 ? k : chunk.getTopFilledSegment() + 16 - 1);
+	int l = worldIn->getRandom()(k > 0 ? k : chunk.getTopFilledSegment() + 16 - 1);
 	return BlockPos(i, l, j);
 }
 
@@ -214,7 +214,7 @@ void WorldEntitySpawner::performWorldGenSpawning(World* worldIn, Biome& biomeIn,
 	{
 		while (randomIn.nextFloat() < biomeIn.getSpawningChance()) 
 		{
-			SpawnListEntry biome$spawnlistentry = (SpawnListEntry)WeightedRandom::getRandomItem(worldIn->rand, list);
+			SpawnListEntry biome$spawnlistentry = (SpawnListEntry)WeightedRandom::getRandomItem(worldIn->getRandom(), list);
 			auto i = biome$spawnlistentry.minGroupCount + randomIn.nextInt(1 + biome$spawnlistentry.maxGroupCount - biome$spawnlistentry.minGroupCount);
 			IEntityLivingData ientitylivingdata = null;
 			auto j = centerX + randomIn(diameterX);
@@ -1,5 +1,6 @@
 #include "WorldServer.h"
 #include "NextTickListEntry.h"
+#include "RegionTicker.h"
 #include "../util/ReportedException.h"
 #include "WorldProvider.h"
 #include "../entity/INpc.h"
@@ -119,19 +120,28 @@ void WorldServer::tick()
 	villageSiege.tick();
 	profiler.endStartSection("portalForcer");
 	worldTeleporter.removeStalePortalLocations(getTotalWorldTime());
+	if (incrementalAutosave && !disableLevelSaving)
+	{
+		profiler.endStartSection("autosave");
+		incrementalSaveScheduler.tick();
+	}
+
+	profiler.endStartSection("mapStorage");
+	mapStorage.evictUnusedData();
 	profiler.endSection();
 	sendQueuedBlockEvents();
+	entityTracker.setParallelEncoding(getGameRules().getBoolean("parallelEntityTracking"));
 }
 
 std::optional<SpawnListEntry> WorldServer::getSpawnListEntryForTypeAt(EnumCreatureType creatureType, BlockPos& pos)
 {
-	auto list = getChunkProvider().getPossibleCreatures(creatureType, pos);
-	return list != nullptr && !list.isEmpty() ? (Biome.SpawnListEntry)WeightedRandom.getRandomItem(rand, list) : std::nullopt;
+	auto list = getChunkProvider()->getPossibleCreatures(creatureType, pos);
+	return list != nullptr && !list.isEmpty() ? (Biome.SpawnListEntry)WeightedRandom.getRandomItem(getRandom(), list) : std::nullopt;
 }
 
 bool WorldServer::canCreatureTypeSpawnHere(EnumCreatureType creatureType, SpawnListEntry spawnListEntry, BlockPos& pos)
 {
-	auto list = getChunkProvider().getPossibleCreatures(creatureType, pos);
+	auto list = getChunkProvider()->getPossibleCreatures(creatureType, pos);
 	return list != nullptr && !list.isEmpty() ? list.contains(spawnListEntry) : false;
 }
 
@@ -201,6 +211,11 @@ void WorldServer::scheduleUpdate(BlockPos& pos, Block* blockIn, int32_t delay)
 
 void WorldServer::updateBlockTick(BlockPos& pos, Block* blockIn, int32_t delay, int32_t priority)
 {
+	if (RegionTicker::deferIfTicking([this, pos, blockIn, delay, priority]() mutable { updateBlockTick(pos, blockIn, delay, priority); }))
+	{
+		return;
+	}
+
 	Material material = blockIn->getDefaultState().getMaterial();
 	if (scheduledUpdatesAreImmediate && material != Material::AIR) 
 	{
@@ -209,7 +224,7 @@ void WorldServer::updateBlockTick(BlockPos& pos, Block* blockIn, int32_t delay,
 			{
 				auto iblockstate = getBlockState(pos);
 				if (iblockstate->getMaterial() != Material::AIR && iblockstate->getBlock() == blockIn) {
-					iblockstate->getBlock()->updateTick(this, pos, iblockstate, rand);
+					iblockstate->getBlock()->updateTick(this, pos, iblockstate, getRandom());
 				}
 			}
 
@@ -237,6 +252,11 @@ void WorldServer::updateBlockTick(BlockPos& pos, Block* blockIn, int32_t delay,
 
 void WorldServer::scheduleBlockUpdate(BlockPos& pos, Block* blockIn, int32_t delay, int32_t priority)
 {
+	if (RegionTicker::deferIfTicking([this, pos, blockIn, delay, priority]() mutable { scheduleBlockUpdate(pos, blockIn, delay, priority); }))
+	{
+		return;
+	}
+
 	NextTickListEntry nextticklistentry(pos, blockIn);
 	nextticklistentry.setPriority(priority);
 	Material material = blockIn->getDefaultState()->getMaterial();
@@ -392,7 +412,7 @@ void WorldServer::wakeAllPlayers()
 
 bool WorldServer::isChunkLoaded(int32_t x, int32_t z, bool allowEmpty)
 {
-	return getChunkProvider().chunkExists(x, z);
+	return getChunkProvider()->chunkExists(x, z);
 }
 
 void WorldServer::playerCheckLight()
@@ -592,7 +612,7 @@ void WorldServer::tickPlayers()
 				getChunk(j, k).removeEntity(entity);
 			}
 
-			loadedEntityList.erase(std::remove_if(loadedEntityList.begin(), loadedEntityList.end(), [](const Entity* lhs) { return lhs == entity; }));
+			markEntityForRemoval(entity);
 			onEntityRemoved(entity);
 		}
 
@@ -735,7 +755,7 @@ std::optional<BlockPos> WorldServer::getSpawnCoordinate() const {
 void WorldServer::saveAllChunks(bool all, IProgressUpdate* progressCallback)
 {
 	auto chunkproviderserver = getChunkProvider();
-	if (chunkproviderserver.canSave()) 
+	if (chunkproviderserver->canSave()) 
 	{
 		if (progressCallback != null) 
 		{
@@ -748,15 +768,12 @@ void WorldServer::saveAllChunks(bool all, IProgressUpdate* progressCallback)
 			progressCallback.displayLoadingString("Saving chunks");
 		}
 
-		chunkproviderserver.saveChunks(all);
-		Iterator var4 = Lists.newArrayList(chunkproviderserver.getLoadedChunks()).iterator();
-
-		while (var4.hasNext()) 
+		chunkproviderserver->saveChunks(all);
+		for (auto& chunk : chunkproviderserver->getLoadedChunks())
 		{
-			auto chunk = (Chunk)var4.next();
-			if (chunk != null && !playerChunkMap.contains(chunk.x, chunk.z)) 
+			if (chunk.second != nullptr && !playerChunkMap.contains(chunk.second->x, chunk.second->z)) 
 			{
-				chunkproviderserver.queueUnload(chunk);
+				chunkproviderserver->queueUnload(chunk.second);
 			}
 		}
 	}
@@ -765,13 +782,34 @@ void WorldServer::saveAllChunks(bool all, IProgressUpdate* progressCallback)
 void WorldServer::flushToDisk()
 {
 	auto chunkproviderserver = getChunkProvider();
-	if (chunkproviderserver.canSave()) 
+	if (chunkproviderserver->canSave()) 
 	{
-		chunkproviderserver.flushToDisk();
+		chunkproviderserver->flushToDisk();
 	}
 }
 
+void WorldServer::setIncrementalAutosave(bool enabled)
+{
+	incrementalAutosave = enabled;
+}
+
+bool WorldServer::isIncrementalAutosaveEnabled() const
+{
+	return incrementalAutosave;
+}
+
+IncrementalSaveScheduler& WorldServer::getIncrementalSaveScheduler()
+{
+	return incrementalSaveScheduler;
+}
+
 void WorldServer::saveLevel()
+{
+	saveLevelInfo();
+	mapStorage.saveAllData();
+}
+
+void WorldServer::saveLevelInfo()
 {
 	checkSessionLock();
 
@@ -793,14 +831,12 @@ void WorldServer::saveLevel()
 	worldInfo.setBorderLerpTarget(getWorldBorder().getTargetSize());
 	worldInfo.setBorderLerpTime(getWorldBorder().getTimeUntilTarget());
 	saveHandler.saveWorldInfoWithPlayer(worldInfo, server.getPlayerList().getHostPlayerData());
-	mapStorage.saveAllData();
 }
 
 void WorldServer::onEntityAdded(Entity* entityIn)
 {
 	World::onEntityAdded(entityIn);
-	entitiesById.emplace(entityIn.getEntityId(), entityIn);
-	entitiesByUuid.emplace(entityIn.getUniqueID(), entityIn);
+	entitiesByUuid.put(entityIn->getUniqueID(), entityIn);
 	auto aentity = entityIn.getParts();
 	if (!aentity.empty()) 
 	{
@@ -810,7 +846,7 @@ void WorldServer::onEntityAdded(Entity* entityIn)
 		for (auto var5 = 0; var5 < var4; ++var5) 
 		{
 			Entity entity = var3[var5];
-			entitiesById.emplace(entity->getEntityId(), entity);
+			entitySlots.add(entity);
 		}
 	}
 }
@@ -818,8 +854,11 @@ void WorldServer::onEntityAdded(Entity* entityIn)
 void WorldServer::onEntityRemoved(Entity* entityIn)
 {
 	World::onEntityRemoved(entityIn);
-	entitiesById.removeObject(entityIn.getEntityId());
-	entitiesByUuid.remove(entityIn.getUniqueID());
+	if (entitiesByUuid.get(entityIn->getUniqueID()) == entityIn)
+	{
+		entitiesByUuid.remove(entityIn->getUniqueID());
+	}
+
 	Entity[] aentity = entityIn.getParts();
 	if (!aentity.empty()) 
 	{
@@ -829,7 +868,7 @@ void WorldServer::onEntityRemoved(Entity* entityIn)
 		for (int var5 = 0; var5 < var4; ++var5) 
 		{
 			Entity entity = var3[var5];
-			entitiesById.removeObject(entity->getEntityId());
+			entitySlots.remove(entity);
 		}
 	}
 }
@@ -917,17 +956,18 @@ bool WorldServer::canAddEntity(Entity* entityIn)
 	else 
 	{
 		auto uuid = entityIn.getUniqueID();
-		auto ite = entitiesByUuid.find(uuid);
-		if (ite != entitiesByUuid.end())
+		auto entity = entitiesByUuid.get(uuid);
+		if (entity != nullptr)
 		{
-			auto entity = ite->second;
-
-			auto findentity = std::find_if(unloadedEntityList.begin(), unloadedEntityList.end(), [&](const Entity * lhs) {return lhs == entity});
-			if (findentity != unloadedEntityList.end())
+			// the old copy is still waiting to be unloaded; removeEntityDangerously below removes it once, so it
+			// leaves the unload list and the unload pass does not remove it a second time
+			auto unloaded = std::find(unloadedEntityList.begin(), unloadedEntityList.end(), entity);
+			if (unloaded != unloadedEntityList.end())
 			{
-				unloadedEntityList.erase(findentity);
+				unloadedEntityList.erase(unloaded);
 			}
-			else {
+			else 
+			{
 				if (!(Util::instanceof<EntityPlayer>(entityIn)))
 				{
 					LOGGER->warn("Keeping entity {} that already exists with UUID {}", EntityList.getKey(entity), uuid.toString());
@@ -1033,9 +1073,9 @@ void WorldServer::sendQueuedBlockEvents()
 	}
 }
 
-ChunkProviderServer WorldServer::getChunkProvider()
+ChunkProviderServer* WorldServer::getChunkProvider()
 {
-	return (ChunkProviderServer)World::getChunkProvider();
+	return static_cast<ChunkProviderServer*>(World::getChunkProvider());
 }
 
 Explosion WorldServer::newExplosion(Entity* entityIn, double x, double y, double z, float strength, bool causesFire,
@@ -1062,6 +1102,11 @@ Explosion WorldServer::newExplosion(Entity* entityIn, double x, double y, double
 
 void WorldServer::addBlockEvent(BlockPos& pos, Block* blockIn, int32_t eventID, int32_t eventParam)
 {
+	if (RegionTicker::deferIfTicking([this, pos, blockIn, eventID, eventParam]() mutable { addBlockEvent(pos, blockIn, eventID, eventParam); }))
+	{
+		return;
+	}
+
 	BlockEventData blockeventdata(pos, blockIn, eventID, eventParam);
 	Iterator var6 = blockEventQueue[blockEventCacheIndex].iterator();
 
@@ -1146,7 +1191,7 @@ void WorldServer::spawnParticle(EntityPlayerMP* player, EnumParticleTypes partic
 
 Entity* WorldServer::getEntityFromUuid(xg::Guid uuid)
 {
-	return entitiesByUuid[uuid];
+	return entitiesByUuid.get(uuid);
 }
 
 void WorldServer::sendPacketWithinDistance(EntityPlayerMP* player, bool longDistance, double x, double y, double z, Packet& packetIn)
@@ -1171,7 +1216,7 @@ bool WorldServer::isCallingFromMinecraftThread()
 
 BlockPos WorldServer::findNearestStructure(std::string_view structureName, BlockPos& position, bool findUnexplored)
 {
-	return getChunkProvider().getNearestStructurePos(this, structureName, position, findUnexplored);
+	return getChunkProvider()->getNearestStructurePos(this, structureName, position, findUnexplored);
 }
 
 AdvancementManager WorldServer::getAdvancementManager()
@@ -5,6 +5,8 @@
 #include "WorldEntitySpawner.h"
 #include "NextTickListEntry.h"
 #include "../entity/EnumCreatureType.h"
+#include "EntityUuidIndex.h"
+#include "storage/IncrementalSaveScheduler.h"
 
 class IProgressUpdate;
 class EntityPlayerMP;
@@ -40,10 +42,14 @@ public:
 	bool canAddEntity(Entity* entityIn);
 	bool addWeatherEffect(Entity* entityIn) override;
 	void setEntityState(Entity* entityIn, std::byte state) override;
-	ChunkProviderServer getChunkProvider() override;
+	ChunkProviderServer* getChunkProvider() override;
 	Explosion newExplosion(Entity* entityIn, double x, double y, double z, float strength, bool causesFire, bool damagesTerrain) override;
 	void addBlockEvent(BlockPos& pos, Block* blockIn, int32_t eventID, int32_t eventParam) override;
 	void flush();
+	void setIncrementalAutosave(bool enabled);
+	bool isIncrementalAutosaveEnabled() const;
+	IncrementalSaveScheduler& getIncrementalSaveScheduler();
+	void saveLevelInfo();
 
 	MinecraftServer* getMinecraftServer() override;
 	EntityTracker* getEntityTracker();
@@ -83,7 +89,7 @@ private:
 	PlayerChunkMap playerChunkMap;
 	std::unordered_set<NextTickListEntry> pendingTickListEntriesHashSet;
 	std::set<NextTickListEntry> pendingTickListEntriesTreeSet;
-	std::unordered_map<xg::Guid, Entity*> entitiesByUuid;
+	EntityUuidIndex entitiesByUuid;
 	bool allPlayersSleeping;
 	int32_t updateEntityTick;
 	Teleporter worldTeleporter;
@@ -91,6 +97,8 @@ private:
 	ServerBlockEventList[] blockEventQueue = new WorldServer.ServerBlockEventList[]{ new WorldServer.ServerBlockEventList(), new WorldServer.ServerBlockEventList() };
 	int32_t blockEventCacheIndex;
 	std::vector<NextTickListEntry> pendingTickListEntriesThisTick;
+	IncrementalSaveScheduler incrementalSaveScheduler{this};
+	bool incrementalAutosave = false;
 
 	void resetRainAndThunder() const;
 	bool canSpawnNPCs();
@@ -946,6 +946,11 @@ void Chunk::setLastSaveTime(int64_t saveTime)
 	lastSaveTime = saveTime;
 }
 
+int64_t Chunk::getLastSaveTime() const
+{
+	return lastSaveTime;
+}
+
 int32_t Chunk::getLowestHeight() const
 {
 	return heightMapMinimum;
@@ -52,9 +52,9 @@ public:
 	void onUnload();
 	void markDirty();
 	template<typename Predicate>
-	void getEntitiesWithinAABBForEntity(Entity* entityIn, AxisAlignedBB& aabb, std::vector<Entity*> listToFill, Predicate filter);
+	void getEntitiesWithinAABBForEntity(Entity* entityIn, AxisAlignedBB& aabb, std::vector<Entity*>& listToFill, Predicate filter);
 	template<typename T,typename Predicate>
-	void getEntitiesOfTypeWithinAABB(AxisAlignedBB aabb, std::vector<Entity*> listToFill, Predicate filter);
+	void getEntitiesOfTypeWithinAABB(AxisAlignedBB aabb, std::vector<Entity*>& listToFill, Predicate filter);
 	bool needsSaving(bool p_76601_1_) const;
 	pcg32 getRandomWithSeed(int64_t seed) const;
 	bool isEmpty();
@@ -87,6 +87,7 @@ public:
 	void setModified(bool modified);
 	void setHasEntities(bool hasEntitiesIn);
 	void setLastSaveTime(int64_t saveTime);
+	int64_t getLastSaveTime() const;
 	int32_t getLowestHeight() const;
 	int64_t getInhabitedTime() const;
 	void setInhabitedTime(int64_t newInhabitedTime);
@@ -132,7 +133,7 @@ private:
 };
 
 template <typename Predicate>
-void Chunk::getEntitiesWithinAABBForEntity(Entity* entityIn, AxisAlignedBB& aabb, std::vector<Entity*> listToFill,
+void Chunk::getEntitiesWithinAABBForEntity(Entity* entityIn, AxisAlignedBB& aabb, std::vector<Entity*>& listToFill,
 	Predicate filter)
 {
 	auto i = MathHelper::floor((aabb.getminY() - 2.0) / 16.0);
@@ -194,7 +195,7 @@ label67:
 }
 
 template <typename T, typename Predicate>
-void Chunk::getEntitiesOfTypeWithinAABB(AxisAlignedBB aabb, std::vector<Entity*> listToFill, Predicate filter)
+void Chunk::getEntitiesOfTypeWithinAABB(AxisAlignedBB aabb, std::vector<Entity*>& listToFill, Predicate filter)
 {
 	auto i = MathHelper::floor((aabb.getminY() - 2.0) / 16.0);
 	auto j = MathHelper::floor((aabb.getmaxY() + 2.0) / 16.0);
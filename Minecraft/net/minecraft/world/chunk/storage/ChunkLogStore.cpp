@@ -0,0 +1,630 @@
+#include "ChunkLogStore.h"
+#include <algorithm>
+#include <charconv>
+#include <fstream>
+#include <stdexcept>
+#include <vector>
+#include <zlib.h>
+#include "spdlog/spdlog.h"
+#include "../../../util/Util.h"
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+std::shared_ptr<spdlog::logger> ChunkLogStore::LOGGER = Util::getLogger("ChunkLogStore");
+
+namespace
+{
+	constexpr size_t MAX_PENDING_WRITES = 4096;
+
+	template<typename T>
+	void putLE(std::string& out, T value)
+	{
+		for (size_t i = 0; i < sizeof(T); ++i)
+		{
+			out.push_back(static_cast<char>(static_cast<uint64_t>(value) >> (8 * i) & 0xFF));
+		}
+	}
+
+	template<typename T>
+	T getLE(std::string_view in, size_t offset)
+	{
+		uint64_t value = 0;
+		for (size_t i = 0; i < sizeof(T); ++i)
+		{
+			value |= static_cast<uint64_t>(static_cast<uint8_t>(in[offset + i])) << (8 * i);
+		}
+
+		return static_cast<T>(value);
+	}
+
+	uint32_t checksum(std::string_view record)
+	{
+		return static_cast<uint32_t>(crc32(0L, reinterpret_cast<const Bytef*>(record.data() + 4), static_cast<uInt>(record.size() - 4)));
+	}
+
+	bool syncFile(std::FILE* file)
+	{
+		if (std::fflush(file) != 0)
+		{
+			return false;
+		}
+
+#ifdef _WIN32
+		return _commit(_fileno(file)) == 0;
+#else
+		return fsync(fileno(file)) == 0;
+#endif
+	}
+
+	std::string readFile(const std::filesystem::path& path)
+	{
+		std::ifstream input(path, std::ios::binary);
+		return std::string(std::istreambuf_iterator<char>(input), std::istreambuf_iterator<char>());
+	}
+}
+
+ChunkLogStore::ChunkLogStore(std::filesystem::path directoryIn, uint64_t segmentSizeIn)
+	: directory(std::move(directoryIn)), segmentSize(segmentSizeIn)
+{
+	recover();
+	backgroundThread = std::thread(&ChunkLogStore::run, this);
+}
+
+ChunkLogStore::~ChunkLogStore()
+{
+	{
+		std::lock_guard<std::mutex> guard(indexLock);
+		stopping = true;
+	}
+
+	wakeup.notify_all();
+	backgroundThread.join();
+	if (activeSegment != nullptr)
+	{
+		std::fclose(activeSegment);
+	}
+}
+
+void ChunkLogStore::put(int32_t dimension, int64_t pos, std::string value)
+{
+	std::lock_guard<std::mutex> guard(indexLock);
+	pending.insert_or_assign(Key{ dimension, pos }, std::move(value));
+	if (pending.size() >= MAX_PENDING_WRITES)
+	{
+		commitRequested = true;
+		wakeup.notify_all();
+	}
+}
+
+void ChunkLogStore::remove(int32_t dimension, int64_t pos)
+{
+	std::lock_guard<std::mutex> guard(indexLock);
+	pending.insert_or_assign(Key{ dimension, pos }, std::nullopt);
+}
+
+std::optional<std::string> ChunkLogStore::get(int32_t dimension, int64_t pos)
+{
+	std::shared_lock<std::shared_mutex> files(segmentFilesLock);
+	Location location;
+	{
+		std::lock_guard<std::mutex> guard(indexLock);
+		Key key{ dimension, pos };
+		for (auto batch : { &pending, &committing })
+		{
+			auto buffered = batch->find(key);
+			if (buffered != batch->end())
+			{
+				return buffered->second;
+			}
+		}
+
+		auto indexed = index.find(key);
+		if (indexed == index.end())
+		{
+			return std::nullopt;
+		}
+
+		location = indexed->second;
+	}
+
+	std::ifstream input(getSegmentPath(location.segment), std::ios::binary);
+	std::string record(RECORD_HEADER_SIZE + location.length, '\0');
+	input.seekg(static_cast<std::streamoff>(location.offset));
+	if (!input.read(record.data(), static_cast<std::streamsize>(record.size())) || getLE<uint32_t>(record, 0) != checksum(record))
+	{
+		LOGGER->error("Corrupt chunk record in segment {} at offset {}", location.segment, location.offset);
+		return std::nullopt;
+	}
+
+	return record.substr(RECORD_HEADER_SIZE);
+}
+
+bool ChunkLogStore::contains(int32_t dimension, int64_t pos)
+{
+	std::lock_guard<std::mutex> guard(indexLock);
+	Key key{ dimension, pos };
+	for (auto batch : { &pending, &committing })
+	{
+		auto buffered = batch->find(key);
+		if (buffered != batch->end())
+		{
+			return buffered->second.has_value();
+		}
+	}
+
+	return index.find(key) != index.end();
+}
+
+void ChunkLogStore::commit()
+{
+	std::lock_guard<std::mutex> guard(indexLock);
+	commitRequested = true;
+	wakeup.notify_all();
+}
+
+void ChunkLogStore::flush()
+{
+	std::lock_guard<std::mutex> guard(writeLock);
+	commitLocked();
+}
+
+bool ChunkLogStore::compact()
+{
+	std::lock_guard<std::mutex> guard(writeLock);
+	return compactLocked();
+}
+
+ChunkLogStore::Statistics ChunkLogStore::getStatistics()
+{
+	std::lock_guard<std::mutex> guard(indexLock);
+	Statistics statistics{ index.size(), pending.size() + committing.size(), segments.size(), 0, 0 };
+	for (auto& segment : segments)
+	{
+		statistics.liveBytes += segment.second.liveBytes;
+		statistics.totalBytes += segment.second.size;
+	}
+
+	return statistics;
+}
+
+std::vector<std::pair<int32_t, int64_t>> ChunkLogStore::getKeys()
+{
+	std::vector<std::pair<int32_t, int64_t>> keys;
+	{
+		std::lock_guard<std::mutex> guard(indexLock);
+		std::unordered_map<Key, bool, KeyHash> buffered;
+		for (auto batch : { &committing, &pending })
+		{
+			for (auto& entry : *batch)
+			{
+				buffered.insert_or_assign(entry.first, entry.second.has_value());
+			}
+		}
+
+		keys.reserve(index.size() + buffered.size());
+		for (auto& entry : index)
+		{
+			if (buffered.find(entry.first) == buffered.end())
+			{
+				keys.emplace_back(entry.first.dimension, entry.first.pos);
+			}
+		}
+
+		for (auto& entry : buffered)
+		{
+			if (entry.second)
+			{
+				keys.emplace_back(entry.first.dimension, entry.first.pos);
+			}
+		}
+	}
+
+	std::sort(keys.begin(), keys.end());
+	return keys;
+}
+
+ChunkLogStore::Snapshot ChunkLogStore::acquireSnapshot()
+{
+	std::lock_guard<std::mutex> guard(indexLock);
+	Snapshot snapshot;
+	for (auto& segment : segments)
+	{
+		if (deferredRemovals.find(segment.first) == deferredRemovals.end())
+		{
+			snapshot.segmentSizes.emplace(segment.first, segment.second.size);
+		}
+	}
+
+	// committing predates pending, and a record replayed later wins
+	for (auto batch : { &committing, &pending })
+	{
+		for (auto& entry : *batch)
+		{
+			snapshot.buffered.emplace_back(entry.first.dimension, entry.first.pos, entry.second);
+		}
+	}
+
+	++snapshotPins;
+	return snapshot;
+}
+
+void ChunkLogStore::releaseSnapshot()
+{
+	std::unordered_map<uint32_t, std::vector<Key>> removals;
+	{
+		std::lock_guard<std::mutex> guard(indexLock);
+		if (--snapshotPins != 0)
+		{
+			return;
+		}
+
+		removals.swap(deferredRemovals);
+	}
+
+	{
+		std::unique_lock<std::shared_mutex> files(segmentFilesLock);
+		for (auto& removal : removals)
+		{
+			std::filesystem::remove(getSegmentPath(removal.first));
+		}
+	}
+
+	std::lock_guard<std::mutex> guard(indexLock);
+	for (auto& removal : removals)
+	{
+		forgetDeadValues(removal.second);
+		segments.erase(removal.first);
+	}
+}
+
+std::filesystem::path ChunkLogStore::getSegmentPath(uint32_t segment) const
+{
+	auto name = std::to_string(segment);
+	return directory / ("segment-" + std::string(8 - std::min<size_t>(8, name.size()), '0') + name + ".log");
+}
+
+void ChunkLogStore::recover()
+{
+	std::filesystem::create_directories(directory);
+	std::vector<uint32_t> ids;
+	for (auto& entry : std::filesystem::directory_iterator(directory))
+	{
+		// anything that is not exactly a segment name is left alone
+		auto name = entry.path().filename().string();
+		uint32_t id;
+		if (name.size() == 20 && name.rfind("segment-", 0) == 0 && name.compare(16, 4, ".log") == 0)
+		{
+			auto digits = name.data() + 8;
+			auto [end, error] = std::from_chars(digits, digits + 8, id);
+			if (error == std::errc() && end == digits + 8)
+			{
+				ids.emplace_back(id);
+			}
+		}
+	}
+
+	std::sort(ids.begin(), ids.end());
+	for (auto id : ids)
+	{
+		auto path = getSegmentPath(id);
+		auto contents = readFile(path);
+		std::string_view view(contents);
+		uint64_t offset = 0;
+		segments[id];
+		while (offset + RECORD_HEADER_SIZE <= view.size())
+		{
+			auto length = getLE<uint32_t>(view, offset + 4);
+			if (offset + RECORD_HEADER_SIZE + length > view.size()
+				|| getLE<uint32_t>(view, offset) != checksum(view.substr(offset, RECORD_HEADER_SIZE + length)))
+			{
+				break;
+			}
+
+			Key key{ getLE<int32_t>(view, offset + 8), getLE<int64_t>(view, offset + 12) };
+			auto tombstone = (static_cast<uint8_t>(view[offset + 20]) & FLAG_TOMBSTONE) != 0;
+			applyRecord(key, tombstone, id, offset, length);
+			offset += RECORD_HEADER_SIZE + length;
+		}
+
+		if (offset != view.size())
+		{
+			LOGGER->warn("Discarding {} bytes of incomplete writes at the end of {}", view.size() - offset, path.string());
+			std::filesystem::resize_file(path, offset);
+		}
+
+		segments[id].size = offset;
+	}
+
+	auto active = ids.empty() ? 0 : ids.back();
+	openActiveSegment(!ids.empty() && segments[active].size >= segmentSize ? active + 1 : active);
+}
+
+void ChunkLogStore::openActiveSegment(uint32_t segment)
+{
+	if (activeSegment != nullptr)
+	{
+		std::fclose(activeSegment);
+	}
+
+	activeSegment = std::fopen(getSegmentPath(segment).string().c_str(), "ab");
+	if (activeSegment == nullptr)
+	{
+		throw std::runtime_error("Failed to open chunk log segment " + getSegmentPath(segment).string());
+	}
+
+	std::lock_guard<std::mutex> guard(indexLock);
+	segments[segment];
+	activeSegmentId = segment;
+}
+
+void ChunkLogStore::commitLocked()
+{
+	{
+		std::lock_guard<std::mutex> guard(indexLock);
+		if (pending.empty())
+		{
+			return;
+		}
+
+		committing.swap(pending);
+	}
+
+	struct Written
+	{
+		Key key;
+		bool tombstone;
+		uint64_t offset;
+		uint32_t length;
+	};
+
+	uint64_t base;
+	{
+		std::lock_guard<std::mutex> guard(indexLock);
+		base = segments[activeSegmentId].size;
+	}
+
+	std::string batch;
+	std::vector<Written> written;
+	written.reserve(committing.size());
+	for (auto& entry : committing)
+	{
+		auto offset = batch.size();
+		auto length = static_cast<uint32_t>(entry.second ? entry.second->size() : 0);
+		putLE<uint32_t>(batch, 0);
+		putLE<uint32_t>(batch, length);
+		putLE<int32_t>(batch, entry.first.dimension);
+		putLE<int64_t>(batch, entry.first.pos);
+		batch.push_back(static_cast<char>(entry.second ? 0 : FLAG_TOMBSTONE));
+		if (entry.second)
+		{
+			batch.append(*entry.second);
+		}
+
+		auto crc = checksum(std::string_view(batch).substr(offset));
+		for (size_t i = 0; i < 4; ++i)
+		{
+			batch[offset + i] = static_cast<char>(crc >> (8 * i) & 0xFF);
+		}
+
+		written.push_back({ entry.first, !entry.second, base + offset, length });
+	}
+
+	if (std::fwrite(batch.data(), 1, batch.size(), activeSegment) != batch.size() || !syncFile(activeSegment))
+	{
+		LOGGER->error("Failed to write {} chunks to {}, will retry", written.size(), getSegmentPath(activeSegmentId).string());
+		std::lock_guard<std::mutex> guard(indexLock);
+		for (auto& entry : committing)
+		{
+			pending.try_emplace(entry.first, std::move(entry.second));
+		}
+
+		committing.clear();
+		std::filesystem::resize_file(getSegmentPath(activeSegmentId), base);
+		return;
+	}
+
+	bool roll;
+	{
+		std::lock_guard<std::mutex> guard(indexLock);
+		for (auto& record : written)
+		{
+			applyRecord(record.key, record.tombstone, activeSegmentId, record.offset, record.length);
+		}
+
+		segments[activeSegmentId].size += batch.size();
+		roll = segments[activeSegmentId].size >= segmentSize;
+		committing.clear();
+	}
+
+	if (roll)
+	{
+		openActiveSegment(activeSegmentId + 1);
+	}
+}
+
+void ChunkLogStore::applyRecord(const Key& key, bool tombstone, uint32_t segment, uint64_t offset, uint32_t length)
+{
+	auto previous = index.find(key);
+	if (previous != index.end())
+	{
+		segments[previous->second.segment].liveBytes -= RECORD_HEADER_SIZE + previous->second.length;
+		++deadValues[key];
+	}
+
+	if (tombstone)
+	{
+		if (previous != index.end())
+		{
+			index.erase(previous);
+		}
+	}
+	else
+	{
+		index.insert_or_assign(key, Location{ offset, segment, length });
+		segments[segment].liveBytes += RECORD_HEADER_SIZE + length;
+	}
+}
+
+bool ChunkLogStore::compactLocked()
+{
+	std::optional<uint32_t> candidate;
+	uint32_t oldestSegment;
+	{
+		std::lock_guard<std::mutex> guard(indexLock);
+		auto lowestRatio = COMPACTION_THRESHOLD;
+		for (auto& segment : segments)
+		{
+			if (segment.first != activeSegmentId && deferredRemovals.find(segment.first) == deferredRemovals.end())
+			{
+				auto ratio = segment.second.size == 0 ? 0.0 : static_cast<double>(segment.second.liveBytes) / static_cast<double>(segment.second.size);
+				if (ratio < lowestRatio)
+				{
+					lowestRatio = ratio;
+					candidate = segment.first;
+				}
+			}
+		}
+
+		oldestSegment = segments.begin()->first;
+	}
+
+	if (!candidate)
+	{
+		return false;
+	}
+
+	struct Record
+	{
+		Key key;
+		bool tombstone;
+		uint64_t offset;
+		uint32_t length;
+	};
+
+	auto path = getSegmentPath(*candidate);
+	auto contents = readFile(path);
+	std::string_view view(contents);
+	std::vector<Record> records;
+	std::unordered_map<Key, uint32_t, KeyHash> valuesInCandidate;
+	uint64_t offset = 0;
+	while (offset + RECORD_HEADER_SIZE <= view.size())
+	{
+		auto length = getLE<uint32_t>(view, offset + 4);
+		if (offset + RECORD_HEADER_SIZE + length > view.size())
+		{
+			break;
+		}
+
+		Key key{ getLE<int32_t>(view, offset + 8), getLE<int64_t>(view, offset + 12) };
+		auto tombstone = (static_cast<uint8_t>(view[offset + 20]) & FLAG_TOMBSTONE) != 0;
+		records.push_back({ key, tombstone, offset, length });
+		if (!tombstone)
+		{
+			++valuesInCandidate[key];
+		}
+
+		offset += RECORD_HEADER_SIZE + length;
+	}
+
+	size_t rewritten = 0;
+	std::vector<Key> values;
+	for (auto& record : records)
+	{
+		std::lock_guard<std::mutex> guard(indexLock);
+		if (!record.tombstone)
+		{
+			values.emplace_back(record.key);
+		}
+
+		if (pending.find(record.key) != pending.end())
+		{
+			continue;
+		}
+
+		auto indexed = index.find(record.key);
+		if (record.tombstone)
+		{
+			// an older segment may still hold a value for this key, so the tombstone has to survive until every
+			// superseded value outside this segment is gone
+			auto dead = deadValues.find(record.key);
+			if (indexed == index.end() && oldestSegment < *candidate && dead != deadValues.end()
+				&& dead->second > valuesInCandidate[record.key])
+			{
+				pending.emplace(record.key, std::nullopt);
+				++rewritten;
+			}
+		}
+		else if (indexed != index.end() && indexed->second.segment == *candidate && indexed->second.offset == record.offset)
+		{
+			pending.emplace(record.key, std::string(view.substr(record.offset + RECORD_HEADER_SIZE, record.length)));
+			++rewritten;
+		}
+	}
+
+	commitLocked();
+	{
+		std::lock_guard<std::mutex> guard(indexLock);
+		if (segments[*candidate].liveBytes != 0)
+		{
+			return false;
+		}
+
+		// hidden from new snapshots from here on; a pinned segment is deleted by the last releaseSnapshot
+		deferredRemovals.emplace(*candidate, std::move(values));
+		if (snapshotPins != 0)
+		{
+			return true;
+		}
+	}
+
+	{
+		std::unique_lock<std::shared_mutex> files(segmentFilesLock);
+		std::filesystem::remove(path);
+	}
+
+	std::lock_guard<std::mutex> guard(indexLock);
+	auto removal = deferredRemovals.find(*candidate);
+	forgetDeadValues(removal->second);
+	deferredRemovals.erase(removal);
+	segments.erase(*candidate);
+	LOGGER->debug("Compacted chunk log segment {}, carried over {} records", *candidate, rewritten);
+	return true;
+}
+
+void ChunkLogStore::forgetDeadValues(const std::vector<Key>& keys)
+{
+	for (auto& key : keys)
+	{
+		auto dead = deadValues.find(key);
+		if (dead != deadValues.end() && --dead->second == 0)
+		{
+			deadValues.erase(dead);
+		}
+	}
+}
+
+void ChunkLogStore::run()
+{
+	while (true)
+	{
+		bool stop;
+		{
+			std::unique_lock<std::mutex> guard(indexLock);
+			wakeup.wait_for(guard, std::chrono::seconds(5), [this]() { return commitRequested || stopping; });
+			stop = stopping;
+			commitRequested = false;
+		}
+
+		std::lock_guard<std::mutex> guard(writeLock);
+		commitLocked();
+		if (stop)
+		{
+			return;
+		}
+
+		compactLocked();
+	}
+}
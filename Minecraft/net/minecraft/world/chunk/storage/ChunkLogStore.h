@@ -0,0 +1,131 @@
+#pragma once
+#include <condition_variable>
+#include <cstdio>
+#include <filesystem>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
+namespace spdlog {
+	class logger;
+}
+
+// Append-only, log-structured key/value store for chunk payloads keyed by dimension and ChunkPos::asLong.
+// Writes are buffered and made durable in group commits (one fsync per batch); superseded records are
+// reclaimed by a background compactor that rewrites the live records of mostly dead segments.
+class ChunkLogStore
+{
+public:
+	struct Statistics
+	{
+		size_t indexedChunks;
+		size_t pendingWrites;
+		size_t segmentCount;
+		uint64_t liveBytes;
+		uint64_t totalBytes;
+	};
+
+	// Committed prefix of every segment plus a copy of the writes not yet committed when it was taken.
+	// Segments are append-only, so the prefixes stay valid until releaseSnapshot lets compaction delete them.
+	struct Snapshot
+	{
+		std::map<uint32_t, uint64_t> segmentSizes;
+		std::vector<std::tuple<int32_t, int64_t, std::optional<std::string>>> buffered;
+	};
+
+	static constexpr uint64_t DEFAULT_SEGMENT_SIZE = 64 * 1024 * 1024;
+	static constexpr double COMPACTION_THRESHOLD = 0.5;
+
+	explicit ChunkLogStore(std::filesystem::path directoryIn, uint64_t segmentSizeIn = DEFAULT_SEGMENT_SIZE);
+	~ChunkLogStore();
+	ChunkLogStore(const ChunkLogStore&) = delete;
+	ChunkLogStore& operator=(const ChunkLogStore&) = delete;
+
+	void put(int32_t dimension, int64_t pos, std::string value);
+	void remove(int32_t dimension, int64_t pos);
+	std::optional<std::string> get(int32_t dimension, int64_t pos);
+	bool contains(int32_t dimension, int64_t pos);
+	void commit();
+	void flush();
+	bool compact();
+	Statistics getStatistics();
+	std::vector<std::pair<int32_t, int64_t>> getKeys();
+	Snapshot acquireSnapshot();
+	void releaseSnapshot();
+	std::filesystem::path getSegmentPath(uint32_t segment) const;
+private:
+	struct Key
+	{
+		int32_t dimension;
+		int64_t pos;
+
+		bool operator==(const Key& other) const
+		{
+			return dimension == other.dimension && pos == other.pos;
+		}
+	};
+
+	struct KeyHash
+	{
+		size_t operator()(const Key& key) const noexcept
+		{
+			auto h = static_cast<uint64_t>(key.pos) ^ static_cast<uint64_t>(static_cast<uint32_t>(key.dimension)) << 32;
+			h = (h ^ h >> 30) * 0xbf58476d1ce4e5b9ULL;
+			h = (h ^ h >> 27) * 0x94d049bb133111ebULL;
+			return h ^ h >> 31;
+		}
+	};
+
+	struct Location
+	{
+		uint64_t offset;
+		uint32_t segment;
+		uint32_t length;
+	};
+
+	struct Segment
+	{
+		uint64_t size = 0;
+		uint64_t liveBytes = 0;
+	};
+
+	static std::shared_ptr<spdlog::logger> LOGGER;
+	static constexpr size_t RECORD_HEADER_SIZE = 21;
+	static constexpr uint8_t FLAG_TOMBSTONE = 1;
+
+	std::filesystem::path directory;
+	uint64_t segmentSize;
+	std::unordered_map<Key, Location, KeyHash> index;
+	std::unordered_map<Key, std::optional<std::string>, KeyHash> pending;
+	std::unordered_map<Key, std::optional<std::string>, KeyHash> committing;
+	std::map<uint32_t, Segment> segments;
+	std::FILE* activeSegment = nullptr;
+	uint32_t activeSegmentId = 0;
+	uint32_t snapshotPins = 0;
+	// segments hidden from snapshots, with the keys of their value records to forget once the file is gone
+	std::unordered_map<uint32_t, std::vector<Key>> deferredRemovals;
+	// superseded value records still on disk, per key; a tombstone is only carried over while its key has some
+	std::unordered_map<Key, uint32_t, KeyHash> deadValues;
+
+	std::mutex indexLock;
+	std::mutex writeLock;
+	std::shared_mutex segmentFilesLock;
+	std::condition_variable wakeup;
+	bool commitRequested = false;
+	bool stopping = false;
+	std::thread backgroundThread;
+
+	void recover();
+	void openActiveSegment(uint32_t segment);
+	void commitLocked();
+	void applyRecord(const Key& key, bool tombstone, uint32_t segment, uint64_t offset, uint32_t length);
+	bool compactLocked();
+	void forgetDeadValues(const std::vector<Key>& keys);
+	void run();
+};
@@ -0,0 +1,220 @@
+#include "ChunkSerializer.h"
+#include "../Chunk.h"
+#include "../../World.h"
+#include "../../WorldProvider.h"
+#include "../../NextTickListEntry.h"
+#include "../../../entity/EntityList.h"
+#include "NBTTagCompound.h"
+#include "NBTTagList.h"
+
+namespace ChunkSerializer
+{
+	std::array<unsigned char, 2048> toNibbleStorage(const ByteBuffer& buffer)
+	{
+		std::array<unsigned char, 2048> storage{};
+		for (size_t i = 0; i < std::min(buffer.size(), storage.size()); ++i)
+		{
+			storage[i] = static_cast<unsigned char>(buffer.get(i));
+		}
+
+		return storage;
+	}
+
+	std::unique_ptr<NBTTagCompound> writeChunkToNBT(Chunk* chunkIn, World* worldIn)
+	{
+		auto compound = std::make_unique<NBTTagCompound>();
+		compound->setInteger("xPos", chunkIn->x);
+		compound->setInteger("zPos", chunkIn->z);
+		compound->setLong("LastUpdate", worldIn->getTotalWorldTime());
+		auto heightMap = chunkIn->getHeightMap();
+		std::vector<int32_t> heightMapArray(heightMap.begin(), heightMap.end());
+		compound->setIntArray("HeightMap", heightMapArray);
+		compound->setBoolean("TerrainPopulated", chunkIn->isTerrainPopulated());
+		compound->setBoolean("LightPopulated", chunkIn->isLightPopulated());
+		compound->setLong("InhabitedTime", chunkIn->getInhabitedTime());
+
+		auto nbttaglist = std::make_unique<NBTTagList>();
+		auto flag = worldIn->provider->hasSkyLight();
+		for (auto extendedblockstorage : chunkIn->getBlockStorageArray())
+		{
+			if (extendedblockstorage != Chunk::NULL_BLOCK_STORAGE)
+			{
+				auto nbttagcompound = std::make_shared<NBTTagCompound>();
+				nbttagcompound->setByte("Y", extendedblockstorage->getYLocation() >> 4 & 255);
+				std::vector<unsigned char> abyte(4096);
+				NibbleArray nibblearray;
+				auto nibblearray1 = extendedblockstorage->getData().getDataForNBT(abyte, nibblearray);
+				auto blocks = ByteBuffer(reinterpret_cast<std::byte*>(abyte.data()), abyte.size());
+				nbttagcompound->setByteArray("Blocks", blocks);
+				auto data = nibblearray.getData();
+				auto databuffer = ByteBuffer(reinterpret_cast<std::byte*>(data.data()), data.size());
+				nbttagcompound->setByteArray("Data", databuffer);
+				if (nibblearray1)
+				{
+					auto add = nibblearray1->getData();
+					auto addbuffer = ByteBuffer(reinterpret_cast<std::byte*>(add.data()), add.size());
+					nbttagcompound->setByteArray("Add", addbuffer);
+				}
+
+				auto blockLight = extendedblockstorage->getBlockLight().getData();
+				auto blockLightBuffer = ByteBuffer(reinterpret_cast<std::byte*>(blockLight.data()), blockLight.size());
+				nbttagcompound->setByteArray("BlockLight", blockLightBuffer);
+				auto skyLight = flag ? extendedblockstorage->getSkyLight().getData() : std::array<unsigned char, 2048>{};
+				auto skyLightBuffer = ByteBuffer(reinterpret_cast<std::byte*>(skyLight.data()), skyLight.size());
+				nbttagcompound->setByteArray("SkyLight", skyLightBuffer);
+				nbttaglist->appendTag(nbttagcompound);
+			}
+		}
+
+		compound->setTag("Sections", std::move(nbttaglist));
+		auto biomes = chunkIn->getBiomeArray();
+		auto biomebuffer = ByteBuffer(reinterpret_cast<std::byte*>(biomes.data()), biomes.size());
+		compound->setByteArray("Biomes", biomebuffer);
+
+		chunkIn->setHasEntities(false);
+		auto nbttaglist1 = std::make_unique<NBTTagList>();
+		for (auto& entityList : chunkIn->getEntityLists())
+		{
+			for (auto entity : entityList)
+			{
+				auto nbttagcompound2 = std::make_shared<NBTTagCompound>();
+				if (entity->writeToNBTOptional(nbttagcompound2.get()))
+				{
+					chunkIn->setHasEntities(true);
+					nbttaglist1->appendTag(nbttagcompound2);
+				}
+			}
+		}
+
+		compound->setTag("Entities", std::move(nbttaglist1));
+
+		auto nbttaglist2 = std::make_unique<NBTTagList>();
+		for (auto& tileentity : chunkIn->getTileEntityMap())
+		{
+			auto nbttagcompound3 = std::make_shared<NBTTagCompound>();
+			tileentity.second->writeToNBT(nbttagcompound3.get());
+			nbttaglist2->appendTag(nbttagcompound3);
+		}
+
+		compound->setTag("TileEntities", std::move(nbttaglist2));
+
+		auto list = worldIn->getPendingBlockUpdates(*chunkIn, false);
+		if (!list.empty())
+		{
+			auto j = worldIn->getTotalWorldTime();
+			auto nbttaglist3 = std::make_unique<NBTTagList>();
+			for (auto& nextticklistentry : list)
+			{
+				auto nbttagcompound1 = std::make_shared<NBTTagCompound>();
+				auto resourcelocation = Block::REGISTRY.getNameForObject(nextticklistentry.getBlock());
+				nbttagcompound1->setString("i", resourcelocation ? resourcelocation->to_string() : "");
+				nbttagcompound1->setInteger("x", nextticklistentry.position.getx());
+				nbttagcompound1->setInteger("y", nextticklistentry.position.gety());
+				nbttagcompound1->setInteger("z", nextticklistentry.position.getz());
+				nbttagcompound1->setInteger("t", nextticklistentry.scheduledTime - j);
+				nbttagcompound1->setInteger("p", nextticklistentry.priority);
+				nbttaglist3->appendTag(nbttagcompound1);
+			}
+
+			compound->setTag("TileTicks", std::move(nbttaglist3));
+		}
+
+		return compound;
+	}
+
+	Chunk* readChunkFromNBT(World* worldIn, NBTTagCompound* compound)
+	{
+		auto i = compound->getInteger("xPos");
+		auto j = compound->getInteger("zPos");
+		auto chunk = new Chunk(worldIn, i, j);
+		auto heightMapArray = compound->getIntArray("HeightMap");
+		std::array<int32_t, 256> heightMap{};
+		std::copy_n(heightMapArray.begin(), std::min<size_t>(heightMapArray.size(), heightMap.size()), heightMap.begin());
+		chunk->setHeightMap(heightMap);
+		chunk->setTerrainPopulated(compound->getBoolean("TerrainPopulated"));
+		chunk->setLightPopulated(compound->getBoolean("LightPopulated"));
+		chunk->setInhabitedTime(compound->getLong("InhabitedTime"));
+
+		auto nbttaglist = compound->getTagList("Sections", 10);
+		std::array<ExtendedBlockStorage*, 16> aextendedblockstorage{};
+		aextendedblockstorage.fill(Chunk::NULL_BLOCK_STORAGE);
+		auto flag = worldIn->provider->hasSkyLight();
+		for (auto k = 0; k < nbttaglist->tagCount(); ++k)
+		{
+			auto nbttagcompound = nbttaglist->getCompoundTagAt(k);
+			auto l = nbttagcompound->getByte("Y");
+			auto extendedblockstorage = new ExtendedBlockStorage(l << 4, flag);
+			auto blocks = nbttagcompound->getByteArray("Blocks");
+			std::vector<unsigned char> abyte(4096);
+			blocks.getBytes(reinterpret_cast<std::byte*>(abyte.data()), abyte.size());
+			auto nibblearray = NibbleArray(toNibbleStorage(nbttagcompound->getByteArray("Data")));
+			std::optional<NibbleArray> nibblearray1 = nbttagcompound->hasKey("Add", 7) ? std::make_optional<NibbleArray>(toNibbleStorage(nbttagcompound->getByteArray("Add"))) : std::nullopt;
+			extendedblockstorage->getData().setDataFromNBT(abyte, nibblearray, nibblearray1);
+			extendedblockstorage->setBlockLight(NibbleArray(toNibbleStorage(nbttagcompound->getByteArray("BlockLight"))));
+			if (flag)
+			{
+				extendedblockstorage->setSkyLight(NibbleArray(toNibbleStorage(nbttagcompound->getByteArray("SkyLight"))));
+			}
+
+			extendedblockstorage->recalculateRefCounts();
+			aextendedblockstorage[l] = extendedblockstorage;
+		}
+
+		chunk->setStorageArrays(aextendedblockstorage);
+		if (compound->hasKey("Biomes", 7))
+		{
+			std::array<unsigned char, 256> biomes{};
+			compound->getByteArray("Biomes").getBytes(reinterpret_cast<std::byte*>(biomes.data()), biomes.size());
+			chunk->setBiomeArray(biomes);
+		}
+
+		return chunk;
+	}
+
+	void loadEntities(World* worldIn, NBTTagCompound* compound, Chunk* chunk)
+	{
+		auto nbttaglist1 = compound->getTagList("Entities", 10);
+		for (auto j1 = 0; j1 < nbttaglist1->tagCount(); ++j1)
+		{
+			auto nbttagcompound1 = nbttaglist1->getCompoundTagAt(j1);
+			auto entity = EntityList::createEntityFromNBT(nbttagcompound1.get(), worldIn);
+			chunk->setHasEntities(true);
+			if (entity != nullptr)
+			{
+				chunk->addEntity(entity);
+			}
+		}
+
+		auto nbttaglist2 = compound->getTagList("TileEntities", 10);
+		for (auto k1 = 0; k1 < nbttaglist2->tagCount(); ++k1)
+		{
+			auto nbttagcompound2 = nbttaglist2->getCompoundTagAt(k1);
+			auto tileentity = TileEntity::create(worldIn, nbttagcompound2.get());
+			if (tileentity != nullptr)
+			{
+				chunk->addTileEntity(tileentity);
+			}
+		}
+
+		if (compound->hasKey("TileTicks", 9))
+		{
+			auto nbttaglist3 = compound->getTagList("TileTicks", 10);
+			for (auto l1 = 0; l1 < nbttaglist3->tagCount(); ++l1)
+			{
+				auto nbttagcompound3 = nbttaglist3->getCompoundTagAt(l1);
+				Block* block;
+				if (nbttagcompound3->hasKey("i", 8))
+				{
+					block = Block::getBlockFromName(nbttagcompound3->getString("i"));
+				}
+				else
+				{
+					block = Block::getBlockById(nbttagcompound3->getInteger("i"));
+				}
+
+				BlockPos pos(nbttagcompound3->getInteger("x"), nbttagcompound3->getInteger("y"), nbttagcompound3->getInteger("z"));
+				worldIn->scheduleBlockUpdate(pos, block, nbttagcompound3->getInteger("t"), nbttagcompound3->getInteger("p"));
+			}
+		}
+	}
+}
@@ -0,0 +1,14 @@
+#pragma once
+#include <memory>
+
+class Chunk;
+class World;
+class NBTTagCompound;
+
+// Chunk <-> "Level" tag conversion shared by every IChunkLoader backend, in the Anvil layout.
+namespace ChunkSerializer
+{
+	std::unique_ptr<NBTTagCompound> writeChunkToNBT(Chunk* chunkIn, World* worldIn);
+	Chunk* readChunkFromNBT(World* worldIn, NBTTagCompound* compound);
+	void loadEntities(World* worldIn, NBTTagCompound* compound, Chunk* chunk);
+}
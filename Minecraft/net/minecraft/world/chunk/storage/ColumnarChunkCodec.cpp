@@ -0,0 +1,472 @@
+#include "ColumnarChunkCodec.h"
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+#include <zlib.h>
+#include "CompressedStreamTools.h"
+#include "NBTSizeTracker.h"
+#include "NBTTagCompound.h"
+#include "NBTTagList.h"
+#include "ParallelDeflate.h"
+
+namespace ColumnarChunkCodec
+{
+	constexpr size_t SECTION_VOLUME = 4096;
+	constexpr size_t NIBBLE_SIZE = SECTION_VOLUME / 2;
+	constexpr uint8_t SECTIONS_IN_NBT = 0xFF;
+	constexpr uint8_t NO_SECTIONS = 0xFE;
+	constexpr uint8_t FLAG_HAS_ADD = 1;
+
+	enum class LightMode : uint8_t
+	{
+		ABSENT,
+		UNIFORM,
+		RLE,
+		RAW
+	};
+
+	class Writer
+	{
+	public:
+		std::string out;
+
+		void putByte(uint8_t value)
+		{
+			out.push_back(static_cast<char>(value));
+		}
+
+		template<typename T>
+		void put(T value)
+		{
+			for (size_t i = 0; i < sizeof(T); ++i)
+			{
+				putByte(static_cast<uint8_t>(static_cast<uint64_t>(value) >> (8 * i)));
+			}
+		}
+
+		void putBytes(const uint8_t* data, size_t length)
+		{
+			out.append(reinterpret_cast<const char*>(data), length);
+		}
+	};
+
+	class Reader
+	{
+	public:
+		explicit Reader(std::string_view inputIn)
+			: input(inputIn)
+		{
+		}
+
+		uint8_t getByte()
+		{
+			require(1);
+			return static_cast<uint8_t>(input[position++]);
+		}
+
+		template<typename T>
+		T get()
+		{
+			uint64_t value = 0;
+			for (size_t i = 0; i < sizeof(T); ++i)
+			{
+				value |= static_cast<uint64_t>(getByte()) << (8 * i);
+			}
+
+			return static_cast<T>(value);
+		}
+
+		std::string_view getBytes(size_t length)
+		{
+			require(length);
+			auto view = input.substr(position, length);
+			position += length;
+			return view;
+		}
+	private:
+		std::string_view input;
+		size_t position = 0;
+
+		void require(size_t length) const
+		{
+			if (position + length > input.size())
+			{
+				throw std::runtime_error("Truncated columnar chunk data");
+			}
+		}
+	};
+
+	template<typename T>
+	T checkedCast(size_t value, const char* what)
+	{
+		if (value > std::numeric_limits<T>::max())
+		{
+			throw std::length_error(what);
+		}
+
+		return static_cast<T>(value);
+	}
+
+	std::vector<uint8_t> toBytes(const ByteBuffer& buffer)
+	{
+		std::vector<uint8_t> bytes(buffer.size());
+		for (size_t i = 0; i < bytes.size(); ++i)
+		{
+			bytes[i] = static_cast<uint8_t>(buffer.get(i));
+		}
+
+		return bytes;
+	}
+
+	ByteBuffer toBuffer(std::vector<uint8_t>& bytes)
+	{
+		return ByteBuffer(reinterpret_cast<std::byte*>(bytes.data()), bytes.size());
+	}
+
+	int32_t nibbleAt(const std::vector<uint8_t>& nibbles, size_t index)
+	{
+		auto value = nibbles[index >> 1];
+		return (index & 1) == 0 ? value & 15 : value >> 4 & 15;
+	}
+
+	void setNibbleAt(std::vector<uint8_t>& nibbles, size_t index, int32_t value)
+	{
+		auto& target = nibbles[index >> 1];
+		target = static_cast<uint8_t>((index & 1) == 0 ? (target & 0xF0) | (value & 15) : (target & 0x0F) | (value & 15) << 4);
+	}
+
+	bool hasArray(NBTTagCompound* section, const std::string& key, size_t length)
+	{
+		return section->hasKey(key, 7) && section->getByteArray(key).size() == length;
+	}
+
+	// Only sections in the exact layout written by the Anvil loader are stored natively; anything else
+	// keeps the whole Sections list as NBT so no unknown data is lost.
+	bool isPlainSection(NBTTagCompound* section)
+	{
+		for (auto& entry : section->getCompoundMap())
+		{
+			auto& key = entry.first;
+			if (key != "Y" && key != "Blocks" && key != "Data" && key != "Add" && key != "BlockLight" && key != "SkyLight")
+			{
+				return false;
+			}
+		}
+
+		return section->hasKey("Y", 1) && hasArray(section, "Blocks", SECTION_VOLUME) && hasArray(section, "Data", NIBBLE_SIZE)
+			&& (!section->hasKey("Add") || hasArray(section, "Add", NIBBLE_SIZE))
+			&& hasArray(section, "BlockLight", NIBBLE_SIZE)
+			&& (!section->hasKey("SkyLight") || hasArray(section, "SkyLight", NIBBLE_SIZE));
+	}
+
+	void writeLight(Writer& writer, NBTTagCompound* section, const std::string& key)
+	{
+		if (!section->hasKey(key))
+		{
+			writer.putByte(static_cast<uint8_t>(LightMode::ABSENT));
+			return;
+		}
+
+		auto light = toBytes(section->getByteArray(key));
+		if (std::all_of(light.begin(), light.end(), [&light](uint8_t value) { return value == light[0]; }))
+		{
+			writer.putByte(static_cast<uint8_t>(LightMode::UNIFORM));
+			writer.putByte(light[0]);
+			return;
+		}
+
+		Writer runs;
+		for (size_t i = 0; i < light.size();)
+		{
+			size_t run = 1;
+			while (run < 255 && i + run < light.size() && light[i + run] == light[i])
+			{
+				++run;
+			}
+
+			runs.putByte(static_cast<uint8_t>(run));
+			runs.putByte(light[i]);
+			i += run;
+		}
+
+		if (runs.out.size() + 2 < light.size())
+		{
+			writer.putByte(static_cast<uint8_t>(LightMode::RLE));
+			writer.put<uint16_t>(static_cast<uint16_t>(runs.out.size() / 2));
+			writer.out.append(runs.out);
+		}
+		else
+		{
+			writer.putByte(static_cast<uint8_t>(LightMode::RAW));
+			writer.putBytes(light.data(), light.size());
+		}
+	}
+
+	void readLight(Reader& reader, NBTTagCompound* section, const std::string& key)
+	{
+		auto mode = static_cast<LightMode>(reader.getByte());
+		if (mode == LightMode::ABSENT)
+		{
+			return;
+		}
+
+		std::vector<uint8_t> light(NIBBLE_SIZE);
+		if (mode == LightMode::UNIFORM)
+		{
+			std::fill(light.begin(), light.end(), reader.getByte());
+		}
+		else if (mode == LightMode::RLE)
+		{
+			auto runCount = reader.get<uint16_t>();
+			size_t index = 0;
+			for (auto i = 0; i < runCount; ++i)
+			{
+				auto run = reader.getByte();
+				auto value = reader.getByte();
+				if (index + run > light.size())
+				{
+					throw std::runtime_error("Corrupt light run in columnar chunk data");
+				}
+
+				std::fill_n(light.begin() + static_cast<std::ptrdiff_t>(index), run, value);
+				index += run;
+			}
+		}
+		else
+		{
+			auto raw = reader.getBytes(NIBBLE_SIZE);
+			std::copy(raw.begin(), raw.end(), light.begin());
+		}
+
+		auto buffer = toBuffer(light);
+		section->setByteArray(key, buffer);
+	}
+
+	void writeSection(Writer& writer, NBTTagCompound* section)
+	{
+		auto blocks = toBytes(section->getByteArray("Blocks"));
+		auto data = toBytes(section->getByteArray("Data"));
+		auto hasAdd = section->hasKey("Add");
+		auto add = hasAdd ? toBytes(section->getByteArray("Add")) : std::vector<uint8_t>();
+
+		writer.putByte(section->getByte("Y"));
+		writer.putByte(hasAdd ? FLAG_HAS_ADD : 0);
+
+		thread_local std::vector<uint16_t> paletteLookup(65536, 0xFFFF);
+		std::vector<uint16_t> palette;
+		std::array<uint16_t, SECTION_VOLUME> indices;
+		for (size_t i = 0; i < SECTION_VOLUME; ++i)
+		{
+			auto id = static_cast<uint16_t>((hasAdd ? nibbleAt(add, i) << 12 : 0) | blocks[i] << 4 | nibbleAt(data, i));
+			auto& slot = paletteLookup[id];
+			if (slot == 0xFFFF)
+			{
+				slot = static_cast<uint16_t>(palette.size());
+				palette.emplace_back(id);
+			}
+
+			indices[i] = slot;
+		}
+
+		for (auto id : palette)
+		{
+			paletteLookup[id] = 0xFFFF;
+		}
+
+		writer.put<uint16_t>(static_cast<uint16_t>(palette.size()));
+		for (auto id : palette)
+		{
+			writer.put<uint16_t>(id);
+		}
+
+		if (palette.size() > 1)
+		{
+			auto bits = std::bit_width(palette.size() - 1);
+			std::vector<uint64_t> packed(SECTION_VOLUME * bits / 64);
+			for (size_t i = 0; i < SECTION_VOLUME; ++i)
+			{
+				auto bitIndex = i * bits;
+				auto word = bitIndex / 64;
+				auto offset = bitIndex % 64;
+				packed[word] |= static_cast<uint64_t>(indices[i]) << offset;
+				if (offset + bits > 64)
+				{
+					packed[word + 1] |= static_cast<uint64_t>(indices[i]) >> (64 - offset);
+				}
+			}
+
+			for (auto value : packed)
+			{
+				writer.put<uint64_t>(value);
+			}
+		}
+
+		writeLight(writer, section, "BlockLight");
+		writeLight(writer, section, "SkyLight");
+	}
+
+	std::shared_ptr<NBTTagCompound> readSection(Reader& reader)
+	{
+		auto section = std::make_shared<NBTTagCompound>();
+		section->setByte("Y", reader.getByte());
+		auto hasAdd = (reader.getByte() & FLAG_HAS_ADD) != 0;
+
+		std::vector<uint16_t> palette(reader.get<uint16_t>());
+		if (palette.empty())
+		{
+			throw std::runtime_error("Empty palette in columnar chunk data");
+		}
+
+		for (auto& id : palette)
+		{
+			id = reader.get<uint16_t>();
+		}
+
+		std::vector<uint8_t> blocks(SECTION_VOLUME);
+		std::vector<uint8_t> data(NIBBLE_SIZE);
+		std::vector<uint8_t> add(NIBBLE_SIZE);
+		auto setState = [&](size_t index, uint16_t id)
+		{
+			blocks[index] = static_cast<uint8_t>(id >> 4 & 255);
+			setNibbleAt(data, index, id & 15);
+			setNibbleAt(add, index, id >> 12 & 15);
+		};
+
+		if (palette.size() == 1)
+		{
+			for (size_t i = 0; i < SECTION_VOLUME; ++i)
+			{
+				setState(i, palette[0]);
+			}
+		}
+		else
+		{
+			auto bits = std::bit_width(palette.size() - 1);
+			uint64_t mask = (1ULL << bits) - 1;
+			std::vector<uint64_t> packed(SECTION_VOLUME * bits / 64);
+			for (auto& value : packed)
+			{
+				value = reader.get<uint64_t>();
+			}
+
+			for (size_t i = 0; i < SECTION_VOLUME; ++i)
+			{
+				auto bitIndex = i * bits;
+				auto word = bitIndex / 64;
+				auto offset = bitIndex % 64;
+				auto index = packed[word] >> offset;
+				if (offset + bits > 64)
+				{
+					index |= packed[word + 1] << (64 - offset);
+				}
+
+				index &= mask;
+				if (index >= palette.size())
+				{
+					throw std::runtime_error("Palette index out of range in columnar chunk data");
+				}
+
+				setState(i, palette[index]);
+			}
+		}
+
+		auto blocksBuffer = toBuffer(blocks);
+		section->setByteArray("Blocks", blocksBuffer);
+		auto dataBuffer = toBuffer(data);
+		section->setByteArray("Data", dataBuffer);
+		if (hasAdd)
+		{
+			auto addBuffer = toBuffer(add);
+			section->setByteArray("Add", addBuffer);
+		}
+
+		readLight(reader, section.get(), "BlockLight");
+		readLight(reader, section.get(), "SkyLight");
+		return section;
+	}
+
+	std::string encode(NBTTagCompound* chunkTag)
+	{
+		Writer body;
+		auto level = chunkTag->getCompoundTag("Level");
+		if (level == nullptr || !level->hasKey("Sections", 9))
+		{
+			body.putByte(NO_SECTIONS);
+		}
+		else
+		{
+			auto sections = level->getTagList("Sections", 10);
+			auto plain = sections->tagCount() < NO_SECTIONS;
+			for (auto i = 0; plain && i < sections->tagCount(); ++i)
+			{
+				plain = isPlainSection(sections->getCompoundTagAt(i).get());
+			}
+
+			if (plain)
+			{
+				body.putByte(static_cast<uint8_t>(sections->tagCount()));
+				for (auto i = 0; i < sections->tagCount(); ++i)
+				{
+					writeSection(body, sections->getCompoundTagAt(i).get());
+				}
+
+				level->removeTag("Sections");
+			}
+			else
+			{
+				body.putByte(SECTIONS_IN_NBT);
+			}
+		}
+
+		std::ostringstream nbtstream(std::ios::binary);
+		CompressedStreamTools::write(chunkTag, nbtstream);
+		auto nbt = nbtstream.str();
+		body.put<uint32_t>(checkedCast<uint32_t>(nbt.size(), "Chunk NBT too large for columnar chunk data"));
+		body.out.append(nbt);
+
+		Writer header;
+		header.put<uint32_t>(MAGIC);
+		header.putByte(VERSION);
+		return header.out + ParallelDeflate::compress(body.out, Z_BEST_SPEED);
+	}
+
+	std::unique_ptr<NBTTagCompound> decode(std::string_view encoded)
+	{
+		if (!isEncoded(encoded) || static_cast<uint8_t>(encoded[4]) != VERSION)
+		{
+			throw std::runtime_error("Not a columnar chunk or unsupported version");
+		}
+
+		auto body = ParallelDeflate::decompress(encoded.substr(5));
+		Reader reader(body);
+		auto sectionCount = reader.getByte();
+		std::unique_ptr<NBTTagList> sections;
+		if (sectionCount != NO_SECTIONS && sectionCount != SECTIONS_IN_NBT)
+		{
+			sections = std::make_unique<NBTTagList>();
+			for (auto i = 0; i < sectionCount; ++i)
+			{
+				sections->appendTag(readSection(reader));
+			}
+		}
+
+		auto nbt = reader.getBytes(reader.get<uint32_t>());
+		std::istringstream nbtstream(std::string(nbt), std::ios::binary);
+		auto chunkTag = CompressedStreamTools::read(nbtstream, NBTSizeTracker::Infinite.get());
+		if (sections != nullptr)
+		{
+			chunkTag->getCompoundTag("Level")->setTag("Sections", std::move(sections));
+		}
+
+		return chunkTag;
+	}
+
+	bool isEncoded(std::string_view data)
+	{
+		return data.size() > 5 && Reader(data).get<uint32_t>() == MAGIC;
+	}
+}
@@ -0,0 +1,27 @@
+#pragma once
+#include <memory>
+#include <string>
+#include <string_view>
+
+class NBTTagCompound;
+
+enum class ChunkStorageFormat
+{
+	NBT,
+	COLUMNAR
+};
+
+// Opt-in chunk encoding that stores each 16x16x16 section natively instead of as NBT byte arrays:
+// a palette of block state ids plus bit packed indices (a single id for uniform sections), and light
+// nibbles that are elided when uniform or run-length coded. Everything outside Level.Sections is kept
+// as plain NBT, so encode/decode round-trips losslessly with the Anvil chunk tag.
+namespace ColumnarChunkCodec
+{
+	constexpr uint32_t MAGIC = 0x31434342; // "BCC1"
+	constexpr uint8_t VERSION = 1;
+
+	// consumes chunkTag: its Level.Sections list is moved into the encoding
+	std::string encode(NBTTagCompound* chunkTag);
+	std::unique_ptr<NBTTagCompound> decode(std::string_view encoded);
+	bool isEncoded(std::string_view data);
+}
@@ -0,0 +1,17 @@
+#pragma once
+#include <cstdint>
+
+class Chunk;
+class World;
+
+class IChunkLoader
+{
+public:
+	virtual ~IChunkLoader() = default;
+	virtual Chunk* loadChunk(World* worldIn, int32_t x, int32_t z) = 0;
+	virtual void saveChunk(World* worldIn, Chunk* chunkIn) = 0;
+	virtual void saveExtraChunkData(World* worldIn, Chunk* chunkIn) = 0;
+	virtual void chunkTick() = 0;
+	virtual void flush() = 0;
+	virtual bool isChunkGeneratedAt(int32_t x, int32_t z) = 0;
+};
@@ -0,0 +1,165 @@
+#include "LogStructuredChunkLoader.h"
+#include "ChunkSerializer.h"
+#include "../Chunk.h"
+#include "../../World.h"
+#include "CompressedStreamTools.h"
+#include "NBTTagCompound.h"
+#include "ParallelDeflate.h"
+#include "WorkerPool.h"
+#include "datafix/DataFixer.h"
+#include "datafix/FixTypes.h"
+#include "math/ChunkPos.h"
+
+std::shared_ptr<spdlog::logger> LogStructuredChunkLoader::LOGGER = spdlog::get("Minecraft")->clone("LogStructuredChunkLoader");
+
+LogStructuredChunkLoader::LogStructuredChunkLoader(std::shared_ptr<ChunkLogStore> storeIn, int32_t dimensionIn, DataFixer& dataFixerIn, ChunkStorageFormat formatIn)
+	: store(std::move(storeIn)), dimension(dimensionIn), dataFixer(dataFixerIn), format(formatIn)
+{
+}
+
+Chunk* LogStructuredChunkLoader::loadChunk(World* worldIn, int32_t x, int32_t z)
+{
+	auto key = ChunkPos::asLong(x, z);
+	std::optional<std::string> data;
+	auto encoding = pendingEncodes.find(key);
+	if (encoding != pendingEncodes.end())
+	{
+		data = encoding->second.get();
+	}
+	else
+	{
+		data = store->get(dimension, key);
+	}
+
+	if (!data)
+	{
+		return nullptr;
+	}
+
+	auto nbttagcompound = dataFixer.process(FixTypes::CHUNK, std::shared_ptr<NBTTagCompound>(decode(*data)));
+	if (!nbttagcompound->hasKey("Level", 10))
+	{
+		LOGGER->error("Chunk file at {},{} is missing level data, skipping", x, z);
+		return nullptr;
+	}
+
+	auto level = nbttagcompound->getCompoundTag("Level");
+	if (!level->hasKey("Sections", 9))
+	{
+		LOGGER->error("Chunk file at {},{} is missing block data, skipping", x, z);
+		return nullptr;
+	}
+
+	auto chunk = ChunkSerializer::readChunkFromNBT(worldIn, level);
+	if (!chunk->isAtLocation(x, z))
+	{
+		LOGGER->error("Chunk file at {},{} is in the wrong location; relocating. (Expected {}, {}, got {}, {})", x, z, x, z, chunk->x, chunk->z);
+		delete chunk;
+		level->setInteger("xPos", x);
+		level->setInteger("zPos", z);
+		chunk = ChunkSerializer::readChunkFromNBT(worldIn, level);
+	}
+
+	ChunkSerializer::loadEntities(worldIn, level, chunk);
+	return chunk;
+}
+
+void LogStructuredChunkLoader::saveChunk(World* worldIn, Chunk* chunkIn)
+{
+	worldIn->checkSessionLock();
+
+	auto nbttagcompound = std::make_unique<NBTTagCompound>();
+	nbttagcompound->setTag("Level", ChunkSerializer::writeChunkToNBT(chunkIn, worldIn));
+	nbttagcompound->setInteger("DataVersion", 1343);
+
+	// the tag is a private copy now, so serialising and compressing it can leave the tick thread
+	auto storageFormat = format;
+	pendingEncodes.insert_or_assign(ChunkPos::asLong(chunkIn->x, chunkIn->z), CompressedStreamTools::getCompressionPool()->submit(
+		[tag = std::move(nbttagcompound), storageFormat]()
+		{
+			// already on a compression worker: deflate as one stream, fanning out into this pool and waiting
+			// could park every worker on blocks no thread is left to run
+			if (storageFormat == ChunkStorageFormat::COLUMNAR)
+			{
+				return ColumnarChunkCodec::encode(tag.get());
+			}
+
+			return ParallelDeflate::compress(CompressedStreamTools::serialize(tag.get()), CompressedStreamTools::getCompressionLevel());
+		}).share());
+}
+
+void LogStructuredChunkLoader::saveExtraChunkData(World* worldIn, Chunk* chunkIn)
+{
+}
+
+void LogStructuredChunkLoader::chunkTick()
+{
+	drainEncodes(false);
+	store->commit();
+}
+
+void LogStructuredChunkLoader::flush()
+{
+	drainEncodes(true);
+	store->flush();
+}
+
+bool LogStructuredChunkLoader::isChunkGeneratedAt(int32_t x, int32_t z)
+{
+	auto key = ChunkPos::asLong(x, z);
+	return pendingEncodes.find(key) != pendingEncodes.end() || store->contains(dimension, key);
+}
+
+int32_t LogStructuredChunkLoader::getDimension() const
+{
+	return dimension;
+}
+
+std::vector<std::pair<int64_t, std::shared_future<std::string>>> LogStructuredChunkLoader::getPendingEncodes() const
+{
+	return { pendingEncodes.begin(), pendingEncodes.end() };
+}
+
+std::string LogStructuredChunkLoader::encode(NBTTagCompound* compound, ChunkStorageFormat formatIn)
+{
+	if (formatIn == ChunkStorageFormat::COLUMNAR)
+	{
+		return ColumnarChunkCodec::encode(compound);
+	}
+
+	return CompressedStreamTools::compress(compound);
+}
+
+std::unique_ptr<NBTTagCompound> LogStructuredChunkLoader::decode(std::string_view data)
+{
+	if (ColumnarChunkCodec::isEncoded(data))
+	{
+		return ColumnarChunkCodec::decode(data);
+	}
+
+	return CompressedStreamTools::decompress(data);
+}
+
+void LogStructuredChunkLoader::drainEncodes(bool wait)
+{
+	for (auto iterator = pendingEncodes.begin(); iterator != pendingEncodes.end();)
+	{
+		auto& encoding = iterator->second;
+		if (!wait && encoding.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+		{
+			++iterator;
+			continue;
+		}
+
+		try
+		{
+			store->put(dimension, iterator->first, encoding.get());
+		}
+		catch (std::exception& var3)
+		{
+			LOGGER->error("Couldn't save chunk: {}", var3.what());
+		}
+
+		iterator = pendingEncodes.erase(iterator);
+	}
+}
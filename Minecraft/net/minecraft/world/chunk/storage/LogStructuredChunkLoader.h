@@ -0,0 +1,35 @@
+#pragma once
+#include <future>
+#include <unordered_map>
+#include <vector>
+#include "IChunkLoader.h"
+#include "ChunkLogStore.h"
+#include "ColumnarChunkCodec.h"
+
+class DataFixer;
+class NBTTagCompound;
+
+class LogStructuredChunkLoader :public IChunkLoader
+{
+public:
+	LogStructuredChunkLoader(std::shared_ptr<ChunkLogStore> storeIn, int32_t dimensionIn, DataFixer& dataFixerIn, ChunkStorageFormat formatIn);
+	Chunk* loadChunk(World* worldIn, int32_t x, int32_t z) override;
+	void saveChunk(World* worldIn, Chunk* chunkIn) override;
+	void saveExtraChunkData(World* worldIn, Chunk* chunkIn) override;
+	void chunkTick() override;
+	void flush() override;
+	bool isChunkGeneratedAt(int32_t x, int32_t z) override;
+	int32_t getDimension() const;
+	std::vector<std::pair<int64_t, std::shared_future<std::string>>> getPendingEncodes() const;
+	static std::string encode(NBTTagCompound* compound, ChunkStorageFormat formatIn);
+	static std::unique_ptr<NBTTagCompound> decode(std::string_view data);
+private:
+	static std::shared_ptr<spdlog::logger> LOGGER;
+	std::shared_ptr<ChunkLogStore> store;
+	int32_t dimension;
+	DataFixer& dataFixer;
+	ChunkStorageFormat format;
+	std::unordered_map<int64_t, std::shared_future<std::string>> pendingEncodes;
+
+	void drainEncodes(bool wait);
+};
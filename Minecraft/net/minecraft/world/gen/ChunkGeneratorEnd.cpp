@@ -155,7 +155,7 @@ void ChunkGeneratorEnd::populate(int32_t x, int32_t z)
 		endCityGen.generateStructure(world, rand, ChunkPos(x, z));
 	}
 
-	world->getBiome(blockpos.add(16, 0, 16)).decorate(world, world->rand, blockpos);
+	world->getBiome(blockpos.add(16, 0, 16)).decorate(world, world->getRandom(), blockpos);
 	auto i = (long)x * (long)x + (long)z * (long)z;
 	if (i > 4096L) 
 	{
@@ -1,9 +1,26 @@
 #include "ChunkProviderServer.h"
 #include "ReportedException.h"
 #include "MinecraftException.h"
+#include "../RegionTicker.h"
 
 std::shared_ptr<spdlog::logger> ChunkProviderServer::LOGGER = spdlog::get("Minecraft")->clone("ChunkProviderServer");
 
+namespace
+{
+	// only region ticks reach the provider from several threads at once, the tick thread alone needs no lock
+	template <typename Lock>
+	Lock lockIfTicking(std::shared_mutex& mutex)
+	{
+		Lock lock(mutex, std::defer_lock);
+		if (RegionTicker::isTickingRegion())
+		{
+			lock.lock();
+		}
+
+		return lock;
+	}
+}
+
 ChunkProviderServer::ChunkProviderServer(WorldServer* worldObjIn, IChunkLoader* chunkLoaderIn, IChunkGenerator* chunkGeneratorIn)
 	: world (worldObjIn), chunkLoader(chunkLoaderIn), chunkGenerator(chunkGeneratorIn)
 {	
@@ -34,14 +51,8 @@ void ChunkProviderServer::queueUnloadAll()
 
 Chunk* ChunkProviderServer::getLoadedChunk(int32_t x, int32_t z)
 {
-	auto i = ChunkPos::asLong(x, z);
-	auto chunk = loadedChunks.at(i);
-	if (chunk != nullptr) 
-	{
-		chunk->unloadQueued = false;
-	}
-
-	return chunk;
+	auto guard = lockIfTicking<std::shared_lock<std::shared_mutex>>(chunkLock);
+	return findLoadedChunk(ChunkPos::asLong(x, z));
 }
 
 Chunk* ChunkProviderServer::loadChunk(int32_t x, int32_t z)
@@ -49,13 +60,8 @@ Chunk* ChunkProviderServer::loadChunk(int32_t x, int32_t z)
 	auto chunk = getLoadedChunk(x, z);
 	if (chunk == nullptr) 
 	{
-		chunk = loadChunkFromFile(x, z);
-		if (chunk != nullptr)
-		{
-			loadedChunks.emplace(ChunkPos::asLong(x, z), chunk);
-			chunk->onLoad();
-			chunk->populate(this, chunkGenerator);
-		}
+		auto guard = lockIfTicking<std::unique_lock<std::shared_mutex>>(chunkLock);
+		chunk = loadChunkLocked(x, z);
 	}
 
 	return chunk;
@@ -63,7 +69,14 @@ Chunk* ChunkProviderServer::loadChunk(int32_t x, int32_t z)
 
 Chunk* ChunkProviderServer::provideChunk(int32_t x, int32_t z)
 {
-	auto chunk = loadChunk(x, z);
+	auto chunk = getLoadedChunk(x, z);
+	if (chunk != nullptr)
+	{
+		return chunk;
+	}
+
+	auto guard = lockIfTicking<std::unique_lock<std::shared_mutex>>(chunkLock);
+	chunk = loadChunkLocked(x, z);
 	if (chunk == nullptr) 
 	{
 		long i = ChunkPos::asLong(x, z);
@@ -82,30 +95,77 @@ Chunk* ChunkProviderServer::provideChunk(int32_t x, int32_t z)
 			throw ReportedException(crashreport);
 		}
 
-		loadedChunks.emplace(i, chunk);
-		chunk->onLoad();
-		chunk->populate(this, chunkGenerator);
+		addLoadedChunk(i, chunk);
+	}
+
+	return chunk;
+}
+
+Chunk* ChunkProviderServer::findLoadedChunk(int64_t key)
+{
+	auto ite = loadedChunks.find(key);
+	if (ite == loadedChunks.end())
+	{
+		return nullptr;
+	}
+
+	auto chunk = ite->second;
+	// nothing else writes the flag while regions tick, so only a queued chunk defers the write
+	if (chunk->unloadQueued && !RegionTicker::deferIfTicking([chunk]() { chunk->unloadQueued = false; }))
+	{
+		chunk->unloadQueued = false;
+	}
+
+	return chunk;
+}
+
+Chunk* ChunkProviderServer::loadChunkLocked(int32_t x, int32_t z)
+{
+	// another region may have loaded it while this one waited for the lock
+	auto i = ChunkPos::asLong(x, z);
+	auto chunk = findLoadedChunk(i);
+	if (chunk == nullptr)
+	{
+		chunk = loadChunkFromFile(x, z);
+		if (chunk != nullptr)
+		{
+			addLoadedChunk(i, chunk);
+		}
 	}
 
 	return chunk;
 }
 
+void ChunkProviderServer::addLoadedChunk(int64_t key, Chunk* chunkIn)
+{
+	loadedChunks.emplace(key, chunkIn);
+	// onLoad() hands the chunk's entities to the world and populate() reaches into the neighbours, a region
+	// leaves both to the merge
+	auto finishLoad = [this, chunkIn]()
+	{
+		chunkIn->onLoad();
+		chunkIn->populate(this, chunkGenerator);
+	};
+	if (!RegionTicker::deferIfTicking(finishLoad))
+	{
+		finishLoad();
+	}
+}
+
 bool ChunkProviderServer::saveChunks(bool all)
 {
 	auto i = 0;
 
-	for(auto& list : droppedChunks)
+	for(auto& entry : loadedChunks)
 	{
-		auto chunk = list->second();
+		auto chunk = entry.second;
 		if (all) 
 		{
 			saveChunkExtraData(chunk);
 		}
 
-		if (chunk->needsSaving(all)) 
+		if (saveChunkIfModified(chunk, all)) 
 		{
-			saveChunkData(chunk);
-			chunk->setModified(false);
 			++i;
 			if (i == 24 && !all) 
 			{
@@ -117,6 +177,18 @@ bool ChunkProviderServer::saveChunks(bool all)
 	return true;
 }
 
+bool ChunkProviderServer::saveChunkIfModified(Chunk* chunkIn, bool all)
+{
+	if (!chunkIn->needsSaving(all))
+	{
+		return false;
+	}
+
+	saveChunkData(chunkIn);
+	chunkIn->setModified(false);
+	return true;
+}
+
 void ChunkProviderServer::flushToDisk()
 {
 	chunkLoader->flush();
@@ -180,11 +252,13 @@ int32_t ChunkProviderServer::getLoadedChunkCount() const
 
 bool ChunkProviderServer::chunkExists(int32_t x, int32_t z)
 {
+	auto guard = lockIfTicking<std::shared_lock<std::shared_mutex>>(chunkLock);
 	return loadedChunks.find(ChunkPos::asLong(x, z)) != loadedChunks.end();
 }
 
 bool ChunkProviderServer::isChunkGeneratedAt(int32_t x, int32_t z)
 {
+	auto guard = lockIfTicking<std::shared_lock<std::shared_mutex>>(chunkLock);
 	return loadedChunks.find(ChunkPos::asLong(x, z)) != loadedChunks.end() || chunkLoader->isChunkGeneratedAt(x, z);
 }
 
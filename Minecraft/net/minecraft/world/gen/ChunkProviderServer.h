@@ -1,4 +1,5 @@
 #pragma once
+#include <shared_mutex>
 #include "chunk/IChunkProvider.h"
 #include "WorldServer.h"
 
@@ -13,6 +14,7 @@ public:
 	Chunk* loadChunk(int32_t x, int32_t z);
 	Chunk* provideChunk(int32_t x, int32_t z) override;
 	bool saveChunks(bool all);
+	bool saveChunkIfModified(Chunk* chunkIn, bool all);
 	void flushToDisk();
 	bool tick() override;
 	bool canSave() const;
@@ -29,8 +31,13 @@ private:
 	IChunkGenerator* chunkGenerator;
 	IChunkLoader* chunkLoader;
 	std::unordered_map<int64_t, Chunk*> loadedChunks;
+	// guards loadedChunks while region ticks look up and load chunks concurrently, see RegionTicker
+	std::shared_mutex chunkLock;
 	WorldServer* world;
 
+	Chunk* findLoadedChunk(int64_t key);
+	Chunk* loadChunkLocked(int32_t x, int32_t z);
+	void addLoadedChunk(int64_t key, Chunk* chunkIn);
 	Chunk* loadChunkFromFile(int32_t x, int32_t z);
 	void saveChunkExtraData(Chunk* chunkIn);
 	void saveChunkData(Chunk* chunkIn);
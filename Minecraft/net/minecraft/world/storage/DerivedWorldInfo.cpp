@@ -135,7 +135,7 @@ void DerivedWorldInfo::setServerInitialized(bool initializedIn)
 {
 }
 
-GameRules DerivedWorldInfo::getGameRulesInstance() const
+GameRules& DerivedWorldInfo::getGameRulesInstance()
 {
 	return delegate.getGameRulesInstance();
 }
@@ -80,7 +80,7 @@ public:
 
 	void setServerInitialized(bool initializedIn) override;
 
-	GameRules getGameRulesInstance() const override;
+	GameRules& getGameRulesInstance() override;
 
 	EnumDifficulty getDifficulty() const override;
 
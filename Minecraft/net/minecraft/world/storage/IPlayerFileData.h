@@ -2,12 +2,15 @@
 #include "NBTTagCompound.h"
 #include <vector>
 #include <string>
+#include <string_view>
 class EntityPlayer;
 
 class IPlayerFileData
 {
 public:
+	virtual ~IPlayerFileData() = default;
 	virtual void writePlayerData(EntityPlayer* var1) = 0;
-	virtual std::unique_ptr<NBTTagCompound> readPlayerData(EntityPlayer* var1) = 0;
+	virtual std::shared_ptr<NBTTagCompound> readPlayerData(EntityPlayer* var1) = 0;
+	virtual void prefetchPlayerData(std::string_view uuid) = 0;
 	virtual std::vector<std::string> getAvailablePlayerDat() = 0;
 };
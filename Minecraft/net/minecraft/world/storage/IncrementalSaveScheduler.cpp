@@ -0,0 +1,183 @@
+#include "IncrementalSaveScheduler.h"
+#include "../WorldServer.h"
+#include "../chunk/Chunk.h"
+#include "../gen/ChunkProviderServer.h"
+#include "../../entity/player/EntityPlayer.h"
+#include "MapStorage.h"
+
+#include <algorithm>
+#include <chrono>
+
+IncrementalSaveScheduler::IncrementalSaveScheduler(WorldServer* worldIn)
+	:world(worldIn)
+{
+}
+
+void IncrementalSaveScheduler::setInterval(int32_t ticks)
+{
+	interval = std::max(ticks, 1);
+	ticksUntilCycle = std::min(ticksUntilCycle, interval);
+}
+
+int32_t IncrementalSaveScheduler::getInterval() const
+{
+	return interval;
+}
+
+void IncrementalSaveScheduler::setTickBudget(double millis)
+{
+	tickBudgetMillis = std::max(millis, 0.0);
+}
+
+double IncrementalSaveScheduler::getTickBudget() const
+{
+	return tickBudgetMillis;
+}
+
+void IncrementalSaveScheduler::tick()
+{
+	if (--ticksUntilCycle <= 0)
+	{
+		startCycle();
+		ticksUntilCycle = interval;
+	}
+
+	if (queue.empty())
+	{
+		return;
+	}
+
+	auto start = std::chrono::steady_clock::now();
+	auto budget = std::chrono::duration<double, std::milli>(tickBudgetMillis);
+	size_t processed = 0;
+	while (!queue.empty() && processed < itemsPerTick)
+	{
+		auto entry = std::move(queue.front());
+		queue.pop_front();
+		process(entry);
+		++processed;
+		if (std::chrono::steady_clock::now() - start >= budget)
+		{
+			break;
+		}
+	}
+}
+
+void IncrementalSaveScheduler::saveAll()
+{
+	startCycle();
+	while (!queue.empty())
+	{
+		auto entry = std::move(queue.front());
+		queue.pop_front();
+		process(entry);
+	}
+
+	ticksUntilCycle = interval;
+}
+
+IncrementalSaveScheduler::Backlog IncrementalSaveScheduler::getBacklog() const
+{
+	Backlog backlog{queuedChunks.size(), queuedData.size(), queuedPlayers.size(), 0};
+	if (!queue.empty())
+	{
+		auto oldest = std::min_element(queue.begin(), queue.end(), [](const Entry& lhs, const Entry& rhs)
+		{
+			return lhs.unsavedSince < rhs.unsavedSince;
+		});
+		backlog.oldestUnsavedTicks = world->getTotalWorldTime() - oldest->unsavedSince;
+	}
+
+	return backlog;
+}
+
+void IncrementalSaveScheduler::startCycle()
+{
+	auto now = world->getTotalWorldTime();
+	if (!levelQueued)
+	{
+		queue.push_back({EntryType::LEVEL, levelSavedAt, 0, {}, {}});
+		levelQueued = true;
+	}
+
+	for (auto& entry : world->getChunkProvider()->getLoadedChunks())
+	{
+		auto chunk = entry.second;
+		if (chunk != nullptr && chunk->needsSaving(false) && queuedChunks.emplace(entry.first).second)
+		{
+			queue.push_back({EntryType::CHUNK, chunk->getLastSaveTime(), entry.first, {}, {}});
+		}
+	}
+
+	for (auto& name : world->getMapStorage()->getDirtyDataNames())
+	{
+		auto since = dataDirtySince.try_emplace(name, now).first->second;
+		if (queuedData.emplace(name).second)
+		{
+			queue.push_back({EntryType::SAVED_DATA, since, 0, name, {}});
+		}
+	}
+
+	for (auto player : world->playerEntities)
+	{
+		auto uuid = player->getUniqueID();
+		auto since = playerSavedAt.try_emplace(uuid, now).first->second;
+		if (queuedPlayers.emplace(uuid).second)
+		{
+			queue.push_back({EntryType::PLAYER, since, 0, {}, uuid});
+		}
+	}
+
+	std::stable_sort(queue.begin(), queue.end(), [](const Entry& lhs, const Entry& rhs)
+	{
+		return lhs.unsavedSince < rhs.unsavedSince;
+	});
+	itemsPerTick = std::max<size_t>(1, (queue.size() + interval - 1) / interval);
+}
+
+void IncrementalSaveScheduler::process(const Entry& entry)
+{
+	auto now = world->getTotalWorldTime();
+	switch (entry.type)
+	{
+	case EntryType::LEVEL:
+		world->saveLevelInfo();
+		levelQueued = false;
+		levelSavedAt = now;
+		break;
+	case EntryType::CHUNK:
+	{
+		queuedChunks.erase(entry.chunkKey);
+		auto chunkprovider = world->getChunkProvider();
+		auto ite = chunkprovider->getLoadedChunks().find(entry.chunkKey);
+		if (ite != chunkprovider->getLoadedChunks().end() && ite->second != nullptr)
+		{
+			chunkprovider->saveChunkIfModified(ite->second, false);
+		}
+		break;
+	}
+	case EntryType::SAVED_DATA:
+		queuedData.erase(entry.dataName);
+		dataDirtySince.erase(entry.dataName);
+		world->getMapStorage()->saveDataIfDirty(entry.dataName);
+		break;
+	case EntryType::PLAYER:
+	{
+		queuedPlayers.erase(entry.player);
+		auto player = std::find_if(world->playerEntities.begin(), world->playerEntities.end(), [&entry](EntityPlayer* playerIn)
+		{
+			return playerIn->getUniqueID() == entry.player;
+		});
+		if (player == world->playerEntities.end())
+		{
+			playerSavedAt.erase(entry.player);
+		}
+		else
+		{
+			world->getSaveHandler()->getPlayerNBTManager()->writePlayerData(*player);
+			playerSavedAt[entry.player] = now;
+		}
+		break;
+	}
+	}
+}
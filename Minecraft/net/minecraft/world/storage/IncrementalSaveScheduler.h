@@ -0,0 +1,69 @@
+#pragma once
+#include <crossguid/guid.hpp>
+#include <deque>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+
+class WorldServer;
+
+// Spreads an autosave over the autosave interval instead of writing everything in one tick. At the start
+// of each cycle the dirty chunks, dirty WorldSavedData and online players are queued oldest-unsaved first;
+// every tick drains that queue until either its share of the cycle or the per-tick time budget is spent.
+class IncrementalSaveScheduler
+{
+public:
+	struct Backlog
+	{
+		size_t chunks;
+		size_t savedData;
+		size_t players;
+		int64_t oldestUnsavedTicks;
+	};
+
+	static constexpr int32_t DEFAULT_INTERVAL = 900;
+	static constexpr double DEFAULT_TICK_BUDGET_MILLIS = 2.0;
+
+	explicit IncrementalSaveScheduler(WorldServer* worldIn);
+	void setInterval(int32_t ticks);
+	int32_t getInterval() const;
+	void setTickBudget(double millis);
+	double getTickBudget() const;
+	void tick();
+	void saveAll();
+	Backlog getBacklog() const;
+private:
+	enum class EntryType
+	{
+		LEVEL,
+		CHUNK,
+		SAVED_DATA,
+		PLAYER
+	};
+
+	struct Entry
+	{
+		EntryType type;
+		int64_t unsavedSince;
+		int64_t chunkKey;
+		std::string dataName;
+		xg::Guid player;
+	};
+
+	WorldServer* world;
+	int32_t interval = DEFAULT_INTERVAL;
+	double tickBudgetMillis = DEFAULT_TICK_BUDGET_MILLIS;
+	int32_t ticksUntilCycle = 0;
+	size_t itemsPerTick = 1;
+	std::deque<Entry> queue;
+	std::unordered_set<int64_t> queuedChunks;
+	std::unordered_set<std::string> queuedData;
+	std::unordered_set<xg::Guid> queuedPlayers;
+	std::unordered_map<std::string, int64_t> dataDirtySince;
+	std::unordered_map<xg::Guid, int64_t> playerSavedAt;
+	bool levelQueued = false;
+	int64_t levelSavedAt = 0;
+
+	void startCycle();
+	void process(const Entry& entry);
+};
@@ -300,6 +300,11 @@ MapData::MapInfo MapData::getMapInfo(EntityPlayer *player)
     return mapdata$mapinfo.value();
 }
 
+bool MapData::canEvict() const
+{
+    return playersArrayList.empty();
+}
+
 Packet *MapData::MapInfo::getPacket(ItemStack stack)
 {
     if (isDirty)
@@ -51,6 +51,7 @@ public:
 	Packet* getMapPacket(ItemStack mapStack, World* worldIn, EntityPlayer* player);
 	void updateMapData(int32_t x, int32_t y);
 	MapData::MapInfo getMapInfo(EntityPlayer* player);
+	bool canEvict() const override;
 private:
 	std::unordered_map<EntityPlayer*, std::optional<MapData::MapInfo>> playersHashMap;
 
@@ -1,9 +1,13 @@
 #include "MapStorage.h"
-
-
+#include "AsyncFileIO.h"
 #include "CompressedStreamTools.h"
 #include "NBTTagCompound.h"
 #include "NBTTagShort.h"
+#include "spdlog/spdlog.h"
+
+#include <algorithm>
+
+std::shared_ptr<spdlog::logger> MapStorage::LOGGER = spdlog::get("Minecraft")->clone("MapStorage");
 
 MapStorage::MapStorage(ISaveHandler* saveHandlerIn)
 	:saveHandler(saveHandlerIn)
@@ -13,14 +17,20 @@ MapStorage::MapStorage(ISaveHandler* saveHandlerIn)
 
 void MapStorage::setData(std::string_view dataIdentifier, WorldSavedData* data)
 {
-	auto ite = loadedDataMap.find(std::string(dataIdentifier));
-	if (ite != loadedDataMap.end())
+	auto key = std::string(dataIdentifier);
+	auto loaded = loadedDataMap.find(key);
+	if (loaded != loadedDataMap.end())
 	{
-		loadedDataMap.erase(ite);
-		loadedDataList.erase(std::remove_if(loadedDataList.begin(),loadedDataList.end(),ite->second()),loadedDataList.end());
+		if (loaded->second == data)
+		{
+			return;
+		}
+
+		removeData(key);
 	}
 
-	loadedDataMap.emplace(dataIdentifier, data);
+	prefetchedData.erase(key);
+	loadedDataMap.emplace(key, data);
 	loadedDataList.emplace_back(data);
 }
 
@@ -36,6 +46,52 @@ void MapStorage::saveAllData()
 	}
 }
 
+std::vector<std::string> MapStorage::getDirtyDataNames() const
+{
+	std::vector<std::string> names;
+	for (auto worldsaveddata : loadedDataList)
+	{
+		if (worldsaveddata->isDirty())
+		{
+			names.emplace_back(worldsaveddata->mapName);
+		}
+	}
+
+	return names;
+}
+
+bool MapStorage::saveDataIfDirty(std::string_view dataIdentifier)
+{
+	auto ite = loadedDataMap.find(std::string(dataIdentifier));
+	if (ite == loadedDataMap.end() || ite->second == nullptr || !ite->second->isDirty())
+	{
+		return false;
+	}
+
+	saveData(ite->second);
+	ite->second->setDirty(false);
+	return true;
+}
+
+std::vector<std::pair<std::filesystem::path, std::shared_ptr<NBTTagCompound>>> MapStorage::snapshotDirtyData() const
+{
+	std::vector<std::pair<std::filesystem::path, std::shared_ptr<NBTTagCompound>>> snapshot;
+	if (saveHandler != nullptr)
+	{
+		for (auto worldsaveddata : loadedDataList)
+		{
+			if (worldsaveddata->isDirty())
+			{
+				auto nbttagcompound = std::make_shared<NBTTagCompound>();
+				nbttagcompound->setTag("data", worldsaveddata->writeToNBT(new NBTTagCompound()));
+				snapshot.emplace_back(saveHandler->getMapFileFromName(worldsaveddata->mapName), nbttagcompound);
+			}
+		}
+	}
+
+	return snapshot;
+}
+
 int32_t MapStorage::getUniqueDataId(std::string_view key)
 {
 	auto oshort = idCounts[std::string(key)];
@@ -76,22 +132,121 @@ void MapStorage::saveData(WorldSavedData* data)
 {
 	if (saveHandler != nullptr) 
 	{
-		try 
+		auto file1 = saveHandler->getMapFileFromName(data->mapName);
+		if (!file1.empty()) 
 		{
-			auto file1 = saveHandler->getMapFileFromName(data->mapName);
-			if (!file1.empty() ) 
+			// snapshot now, compress and write on the file I/O workers
+			auto nbttagcompound = std::make_shared<NBTTagCompound>();
+			nbttagcompound->setTag("data", data->writeToNBT(new NBTTagCompound()));
+			AsyncFileIO::getInstance()->write(file1, [nbttagcompound]()
 			{
-				auto nbttagcompound = std::make_unique<NBTTagCompound>();
-				nbttagcompound->setTag("data", data->writeToNBT(new NBTTagCompound()));
-				std::ofstream fileoutputstream(file1);
-				CompressedStreamTools::writeCompressed(nbttagcompound, fileoutputstream);
-				fileoutputstream.close();
-			}
+				return CompressedStreamTools::compress(nbttagcompound.get());
+			});
 		}
-		catch (std::exception& var5) 
+	}
+}
+
+void MapStorage::prefetchData(std::string_view dataIdentifier)
+{
+	auto key = std::string(dataIdentifier);
+	if (saveHandler == nullptr || loadedDataMap.find(key) != loadedDataMap.end() || prefetchedData.find(key) != prefetchedData.end())
+	{
+		return;
+	}
+
+	// decoded on the I/O worker right after the read, no pool thread ever waits on the I/O queue
+	prefetchedData.emplace(key, AsyncFileIO::getInstance()->read(saveHandler->getMapFileFromName(key), [](std::optional<std::string> data)
+	{
+		return data ? std::shared_ptr<NBTTagCompound>(CompressedStreamTools::decompress(*data)) : nullptr;
+	}).share());
+}
+
+void MapStorage::evictUnusedData()
+{
+	auto iterator = usageOrder.begin();
+	while (cachedData.size() > cacheSize && iterator != usageOrder.end())
+	{
+		auto& cached = cachedData.at(*iterator);
+		// a use count above one means a caller of getOrLoadData still holds it
+		if (cached.data.use_count() > 1 || cached.data->isDirty() || !cached.data->canEvict())
 		{
-			var5.printStackTrace();
+			++iterator;
+			continue;
 		}
+
+		auto key = *iterator++;
+		removeData(key);
+	}
+}
+
+void MapStorage::setCacheSize(size_t size)
+{
+	cacheSize = size;
+}
+
+size_t MapStorage::getCachedDataCount() const
+{
+	return cachedData.size();
+}
+
+std::shared_ptr<WorldSavedData> MapStorage::getLoadedData(const std::string& key)
+{
+	auto cached = cachedData.find(key);
+	if (cached != cachedData.end())
+	{
+		usageOrder.splice(usageOrder.end(), usageOrder, cached->second.usage);
+		return cached->second.data;
+	}
+
+	// registered through setData and owned by the caller, never evicted, so the pointer is handed out unowned
+	auto loaded = loadedDataMap.find(key);
+	return loaded != loadedDataMap.end() ? std::shared_ptr<WorldSavedData>(std::shared_ptr<WorldSavedData>(), loaded->second) : nullptr;
+}
+
+std::shared_ptr<NBTTagCompound> MapStorage::takeDataCompound(const std::string& key)
+{
+	prefetchData(key);
+	auto prefetched = prefetchedData.find(key);
+	if (prefetched == prefetchedData.end())
+	{
+		return nullptr;
+	}
+
+	auto future = std::move(prefetched->second);
+	prefetchedData.erase(prefetched);
+	try 
+	{
+		return future.get();
+	}
+	catch (std::exception& var8)
+	{
+		LOGGER->error("Failed to load {}: {}", key, var8.what());
+		return nullptr;
+	}
+}
+
+void MapStorage::addCachedData(const std::string& key, std::shared_ptr<WorldSavedData> data)
+{
+	loadedDataMap.emplace(key, data.get());
+	loadedDataList.emplace_back(data.get());
+	cachedData.emplace(key, CachedData{std::move(data), usageOrder.insert(usageOrder.end(), key)});
+}
+
+void MapStorage::removeData(const std::string& key)
+{
+	auto loaded = loadedDataMap.find(key);
+	if (loaded == loadedDataMap.end())
+	{
+		return;
+	}
+
+	loadedDataList.erase(std::remove(loadedDataList.begin(), loadedDataList.end(), loaded->second), loadedDataList.end());
+	loadedDataMap.erase(loaded);
+	auto cached = cachedData.find(key);
+	if (cached != cachedData.end())
+	{
+		usageOrder.erase(cached->second.usage);
+		cachedData.erase(cached);
 	}
 }
 
@@ -2,73 +2,88 @@
 #include "ISaveHandler.h"
 #include "WorldSavedData.h"
 #include <fstream>
+#include <future>
+#include <list>
+
+namespace spdlog {
+	class logger;
+}
 
 class MapStorage
 {
 public:
+	static constexpr size_t DEFAULT_CACHE_SIZE = 1024;
+
+	// Data loaded by this storage stays pinned against eviction while a returned pointer is alive.
 	template <class T>
-	std::unique_ptr<T> getOrLoadData(std::string_view dataIdentifier);
+	std::shared_ptr<T> getOrLoadData(std::string_view dataIdentifier);
 	MapStorage(ISaveHandler* saveHandlerIn);
 	virtual void setData(std::string_view dataIdentifier, WorldSavedData* data);
 	virtual void saveAllData();
 	virtual int32_t getUniqueDataId(std::string_view key);
+	std::vector<std::string> getDirtyDataNames() const;
+	bool saveDataIfDirty(std::string_view dataIdentifier);
+	std::vector<std::pair<std::filesystem::path, std::shared_ptr<NBTTagCompound>>> snapshotDirtyData() const;
+	void prefetchData(std::string_view dataIdentifier);
+	void evictUnusedData();
+	void setCacheSize(size_t size);
+	size_t getCachedDataCount() const;
 protected:
 	std::unordered_map<std::string, WorldSavedData*> loadedDataMap;
 
 	
 private:
+	// Data this storage loaded itself, in least recently used order; only these may be evicted again.
+	struct CachedData
+	{
+		std::shared_ptr<WorldSavedData> data;
+		std::list<std::string>::iterator usage;
+	};
+
+	static std::shared_ptr<spdlog::logger> LOGGER;
 	ISaveHandler* saveHandler;
 	std::vector<WorldSavedData*> loadedDataList;
 	std::unordered_map<std::string, int16_t> idCounts;
+	std::unordered_map<std::string, CachedData> cachedData;
+	std::list<std::string> usageOrder;
+	std::unordered_map<std::string, std::shared_future<std::shared_ptr<NBTTagCompound>>> prefetchedData;
+	size_t cacheSize = DEFAULT_CACHE_SIZE;
 
 	void saveData(WorldSavedData* data);
 	void loadIdCounts();
+	std::shared_ptr<WorldSavedData> getLoadedData(const std::string& key);
+	std::shared_ptr<NBTTagCompound> takeDataCompound(const std::string& key);
+	void addCachedData(const std::string& key, std::shared_ptr<WorldSavedData> data);
+	void removeData(const std::string& key);
 };
 
 template <class T>
-std::unique_ptr<T> MapStorage::getOrLoadData(std::string_view dataIdentifier)
+std::shared_ptr<T> MapStorage::getOrLoadData(std::string_view dataIdentifier)
 {
-	T* worldsaveddata = loadedDataMap[dataIdentifier];
-	if (worldsaveddata != nullptr) 
+	auto key = std::string(dataIdentifier);
+	auto loaded = getLoadedData(key);
+	if (loaded != nullptr) 
 	{
-		return worldsaveddata;
+		return std::static_pointer_cast<T>(loaded);
 	}
-	else 
-	{
-		if (saveHandler != nullptr) 
-		{
-			try 
-			{
-				auto file1 = saveHandler->getMapFileFromName(dataIdentifier);
-				if (exists(file1))
-				{
-					try 
-					{
-						worldsaveddata = std::make_unique<T>(dataIdentifier);
-					}
-					catch (std::exception& var7) 
-					{
-						throw std::runtime_error(std::string("Failed to instantiate ") + var7.what());
-					}
-
-					std::ifstream fileinputstream(file1);
-					auto nbttagcompound = CompressedStreamTools::readCompressed(fileinputstream);
-					fileinputstream.close();
-					worldsaveddata->readFromNBT(nbttagcompound->getCompoundTag("data"));
-				}
-			}
-			catch (std::exception& var8)
-			{
-				var8.printStackTrace();
-			}
-		}
 
-		if (worldsaveddata != nullptr) 
-		{
-			loadedDataMap.emplace(dataIdentifier, worldsaveddata);
-			loadedDataList.emplace_back(worldsaveddata);
-		}
+	auto nbttagcompound = takeDataCompound(key);
+	if (nbttagcompound == nullptr) 
+	{
+		return nullptr;
+	}
 
-		return worldsaveddata;
+	std::shared_ptr<T> worldsaveddata;
+	try 
+	{
+		worldsaveddata = std::make_shared<T>(key);
 	}
+	catch (std::exception& var7) 
+	{
+		throw std::runtime_error(std::string("Failed to instantiate ") + var7.what());
+	}
+
+	worldsaveddata->readFromNBT(nbttagcompound->getCompoundTag("data"));
+	addCachedData(key, worldsaveddata);
+	return worldsaveddata;
 }
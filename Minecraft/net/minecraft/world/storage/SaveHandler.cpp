@@ -4,6 +4,7 @@
 #include "WorldProvider.h"
 #include "SaveFormatOld.h"
 #include "CompressedStreamTools.h"
+#include "AsyncFileIO.h"
 #include "datafix/FixTypes.h"
 
 std::shared_ptr<spdlog::logger> BlockAnvil::LOGGER = spdlog::get("Minecraft")->clone("SaveHandler");
@@ -76,7 +77,36 @@ void SaveHandler::setSessionLock() const
 
 IChunkLoader* SaveHandler::getChunkLoader(WorldProvider* provider)
 {
-	throw std::runtime_error("Old Chunk Storage is no longer supported.");
+	if (chunkLogStore == nullptr)
+	{
+		throw std::runtime_error("Old Chunk Storage is no longer supported.");
+	}
+
+	auto dimension = static_cast<int32_t>(provider->getDimensionType().getId());
+	chunkLoaders.emplace_back(std::make_unique<LogStructuredChunkLoader>(chunkLogStore, dimension, dataFixer, chunkStorageFormat));
+	return chunkLoaders.back().get();
+}
+
+void SaveHandler::enableLogStructuredChunkStore(ChunkStorageFormat format)
+{
+	if (chunkLogStore == nullptr)
+	{
+		auto directory = worldDirectory;
+		directory.append("chunklog");
+		chunkLogStore = std::make_shared<ChunkLogStore>(directory);
+	}
+
+	chunkStorageFormat = format;
+}
+
+std::shared_ptr<ChunkLogStore> SaveHandler::getChunkLogStore() const
+{
+	return chunkLogStore;
+}
+
+const std::vector<std::unique_ptr<LogStructuredChunkLoader>>& SaveHandler::getChunkLoaders() const
+{
+	return chunkLoaders;
 }
 
 std::optional<WorldInfo> SaveHandler::loadWorldInfo()
@@ -111,7 +141,7 @@ void SaveHandler::saveWorldInfoWithPlayer(WorldInfo worldInformation, NBTTagComp
 		file2.append("level.dat_old");
 		auto file3 = worldDirectory;
 		file3.append("level.dat");
-		std::ofstream outputfile(file1);
+		std::ofstream outputfile(file1, std::ios::binary);
 		CompressedStreamTools::writeCompressed(nbttagcompound1, outputfile);
 		if (exists(file2)) 
 		{
@@ -144,19 +174,21 @@ void SaveHandler::writePlayerData(EntityPlayer* player)
 {
 	try 
 	{
-		auto nbttagcompound = player->writeToNBT(std::make_unique<NBTTagCompound>());
-		auto file1 = playersDirectory;
-		file1.append(player->getCachedUniqueIdString() + ".dat.tmp");
-		auto file2 = playersDirectory;
-		file1.append(player->getCachedUniqueIdString() + ".dat");
-		std::ofstream outout(file1);
-		CompressedStreamTools::writeCompressed(nbttagcompound, outout);
-		if (exists(file2)) 
+		// the snapshot is taken here; compression and the atomic rename happen on the file I/O workers
+		auto nbttagcompound = std::make_shared<NBTTagCompound>();
+		player->writeToNBT(nbttagcompound.get());
+		auto uuid = std::string(player->getCachedUniqueIdString());
 		{
-			remove(file2);
+			std::lock_guard<std::mutex> guard(prefetchLock);
+			prefetchedPlayers.erase(uuid);
 		}
 
-		rename(file1, file2);
+		auto file1 = playersDirectory;
+		file1.append(uuid + ".dat");
+		AsyncFileIO::getInstance()->write(file1, [nbttagcompound]()
+		{
+			return CompressedStreamTools::compress(nbttagcompound.get());
+		});
 	}
 	catch (std::exception& var5) 
 	{
@@ -164,19 +196,43 @@ void SaveHandler::writePlayerData(EntityPlayer* player)
 	}
 }
 
-std::unique_ptr<NBTTagCompound> SaveHandler::readPlayerData(EntityPlayer* player)
+void SaveHandler::prefetchPlayerData(std::string_view uuid)
+{
+	auto file1 = playersDirectory;
+	file1.append(std::string(uuid) + ".dat");
+	auto fixer = &dataFixer;
+	// decoded on the I/O worker right after the read, no pool thread ever waits on the I/O queue
+	auto nbttagcompound = AsyncFileIO::getInstance()->read(file1, [fixer](std::optional<std::string> data) -> std::shared_ptr<NBTTagCompound>
+	{
+		if (!data)
+		{
+			return nullptr;
+		}
+
+		return fixer->process(FixTypes::PLAYER, std::shared_ptr<NBTTagCompound>(CompressedStreamTools::decompress(*data)));
+	}).share();
+
+	auto now = std::chrono::steady_clock::now();
+	std::lock_guard<std::mutex> guard(prefetchLock);
+	evictStalePrefetchesLocked(now);
+	prefetchedPlayers.insert_or_assign(std::string(uuid), PrefetchedPlayer{nbttagcompound, now});
+}
+
+std::shared_ptr<NBTTagCompound> SaveHandler::readPlayerData(EntityPlayer* player)
 {
-	std::unique_ptr<NBTTagCompound> nbttagcompound = nullptr;
+	std::shared_ptr<NBTTagCompound> nbttagcompound = nullptr;
+	auto uuid = std::string(player->getCachedUniqueIdString());
 
 	try 
 	{
-		auto file1 = playersDirectory;
-		file1.append(player->getCachedUniqueIdString() + ".dat");
-		if (exists(file1) && is_regular_file(file1)) 
+		auto prefetched = takePrefetchedPlayerData(uuid);
+		if (!prefetched.valid())
 		{
-			std::ifstream outout(file1);
-			nbttagcompound = CompressedStreamTools::readCompressed(outout);
+			prefetchPlayerData(uuid);
+			prefetched = takePrefetchedPlayerData(uuid);
 		}
+
+		nbttagcompound = prefetched.get();
 	}
 	catch (std::exception& var4) 
 	{
@@ -185,12 +241,41 @@ std::unique_ptr<NBTTagCompound> SaveHandler::readPlayerData(EntityPlayer* player
 
 	if (nbttagcompound != nullptr) 
 	{
-		player->readFromNBT(dataFixer.process(FixTypes::PLAYER, nbttagcompound));
+		player->readFromNBT(nbttagcompound.get());
 	}
 
 	return nbttagcompound;
 }
 
+std::shared_future<std::shared_ptr<NBTTagCompound>> SaveHandler::takePrefetchedPlayerData(const std::string& uuid)
+{
+	std::lock_guard<std::mutex> guard(prefetchLock);
+	auto entry = prefetchedPlayers.find(uuid);
+	if (entry == prefetchedPlayers.end())
+	{
+		return {};
+	}
+
+	auto prefetched = std::move(entry->second.data);
+	prefetchedPlayers.erase(entry);
+	return prefetched;
+}
+
+void SaveHandler::evictStalePrefetchesLocked(std::chrono::steady_clock::time_point now)
+{
+	for (auto entry = prefetchedPlayers.begin(); entry != prefetchedPlayers.end();)
+	{
+		if (now - entry->second.started > PREFETCH_TIMEOUT)
+		{
+			entry = prefetchedPlayers.erase(entry);
+		}
+		else
+		{
+			++entry;
+		}
+	}
+}
+
 IPlayerFileData* SaveHandler::getPlayerNBTManager()
 {
 	return this;
@@ -213,6 +298,14 @@ std::vector<std::string> SaveHandler::getAvailablePlayerDat()
 
 void SaveHandler::flush()
 {
+	for (auto& chunkLoader : chunkLoaders)
+	{
+		chunkLoader->flush();
+	}
+
+	AsyncFileIO::getInstance()->waitForFinish();
+	std::lock_guard<std::mutex> guard(prefetchLock);
+	evictStalePrefetchesLocked(std::chrono::steady_clock::now());
 }
 
 std::filesystem::path SaveHandler::getMapFileFromName(std::string_view mapName)
@@ -1,7 +1,14 @@
 #pragma once
+#include <chrono>
+#include <future>
+#include <mutex>
+#include <unordered_map>
 #include "IPlayerFileData.h"
 #include "ISaveHandler.h"
 #include "datafix/DataFixer.h"
+#include "../chunk/storage/ChunkLogStore.h"
+#include "../chunk/storage/ColumnarChunkCodec.h"
+#include "../chunk/storage/LogStructuredChunkLoader.h"
 
 class SaveHandler : public ISaveHandler, public IPlayerFileData
 {
@@ -14,12 +21,16 @@ public:
 	void saveWorldInfoWithPlayer(WorldInfo worldInformation, NBTTagCompound* tagCompound) override;
 	void saveWorldInfo(WorldInfo worldInformation) override;
 	void writePlayerData(EntityPlayer* player) override;
-	std::unique_ptr<NBTTagCompound> readPlayerData(EntityPlayer* player) override;
+	std::shared_ptr<NBTTagCompound> readPlayerData(EntityPlayer* player) override;
+	void prefetchPlayerData(std::string_view uuid) override;
 	IPlayerFileData* getPlayerNBTManager() override;
 	std::vector<std::string> getAvailablePlayerDat() override;
 	void flush() override;
 	std::filesystem::path getMapFileFromName(std::string_view mapName) override;
 	TemplateManager getStructureTemplateManager() override;
+	void enableLogStructuredChunkStore(ChunkStorageFormat format);
+	std::shared_ptr<ChunkLogStore> getChunkLogStore() const;
+	const std::vector<std::unique_ptr<LogStructuredChunkLoader>>& getChunkLoaders() const;
 protected:
 	DataFixer dataFixer;
 private:
@@ -30,5 +41,20 @@ private:
 	int64_t initializationTime = MinecraftServer.getCurrentTimeMillis();
 	std::string saveDirectoryName;
 	std::optional<TemplateManager> structureTemplateManager;
+	std::shared_ptr<ChunkLogStore> chunkLogStore;
+	ChunkStorageFormat chunkStorageFormat = ChunkStorageFormat::NBT;
+	std::vector<std::unique_ptr<LogStructuredChunkLoader>> chunkLoaders;
+	struct PrefetchedPlayer
+	{
+		std::shared_future<std::shared_ptr<NBTTagCompound>> data;
+		std::chrono::steady_clock::time_point started;
+	};
+
+	// a prefetch for a login that never completes is dropped after this long
+	static constexpr std::chrono::seconds PREFETCH_TIMEOUT{60};
+	std::mutex prefetchLock;
+	std::unordered_map<std::string, PrefetchedPlayer> prefetchedPlayers;
 	void setSessionLock() const;
+	std::shared_future<std::shared_ptr<NBTTagCompound>> takePrefetchedPlayerData(const std::string& uuid);
+	void evictStalePrefetchesLocked(std::chrono::steady_clock::time_point now);
 };
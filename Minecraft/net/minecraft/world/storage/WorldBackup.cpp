@@ -0,0 +1,345 @@
+#include "WorldBackup.h"
+#include "SaveHandler.h"
+#include "MapStorage.h"
+#include "CompressedStreamTools.h"
+#include "NBTTagCompound.h"
+#include "../WorldServer.h"
+#include "../gen/ChunkProviderServer.h"
+#include "../../entity/player/EntityPlayer.h"
+#include "spdlog/spdlog.h"
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <limits>
+#include <unordered_set>
+
+std::shared_ptr<spdlog::logger> WorldBackup::LOGGER = spdlog::get("Minecraft")->clone("WorldBackup");
+
+namespace
+{
+	constexpr size_t COPY_BUFFER_SIZE = 1024 * 1024;
+
+	bool isWithin(const std::filesystem::path& path, const std::filesystem::path& directory)
+	{
+		auto relative = path.lexically_relative(directory);
+		return !relative.empty() && *relative.begin() != "..";
+	}
+
+	bool isVanished(const std::filesystem::filesystem_error& e)
+	{
+		return e.code() == std::errc::no_such_file_or_directory;
+	}
+}
+
+std::unique_ptr<WorldBackup> WorldBackup::start(const std::vector<WorldServer*>& worlds, std::filesystem::path target)
+{
+	if (worlds.empty())
+	{
+		throw std::runtime_error("Nothing to back up");
+	}
+
+	auto savehandler = worlds.front()->getSaveHandler();
+	auto backup = std::unique_ptr<WorldBackup>(new WorldBackup(savehandler->getWorldDirectory(), std::move(target)));
+	auto levelData = std::make_shared<NBTTagCompound>();
+	levelData->setTag("Data", worlds.front()->getWorldInfo().cloneNBTCompound(nullptr));
+	backup->overlays.push_back({"level.dat", levelData});
+
+	std::unordered_set<MapStorage*> mapStorages;
+	for (auto worldserver : worlds)
+	{
+		// serialisation stays on this thread; encoding and the log append happen off-thread as for any save
+		worldserver->getChunkProvider()->saveChunks(true);
+		auto mapstorage = worldserver->getMapStorage();
+		if (mapStorages.emplace(mapstorage).second)
+		{
+			for (auto& data : mapstorage->snapshotDirtyData())
+			{
+				backup->overlays.push_back({data.first.lexically_relative(backup->source), data.second});
+			}
+		}
+
+		for (auto player : worldserver->playerEntities)
+		{
+			auto nbttagcompound = std::make_shared<NBTTagCompound>();
+			player->writeToNBT(nbttagcompound.get());
+			backup->overlays.push_back({std::filesystem::path("playerdata") / (std::string(player->getCachedUniqueIdString()) + ".dat"), nbttagcompound});
+		}
+	}
+
+	auto savehandlerimpl = dynamic_cast<SaveHandler*>(savehandler);
+	if (savehandlerimpl != nullptr && savehandlerimpl->getChunkLogStore() != nullptr)
+	{
+		backup->chunkLogStore = savehandlerimpl->getChunkLogStore();
+		backup->chunkSnapshot = backup->chunkLogStore->acquireSnapshot();
+		for (auto& loader : savehandlerimpl->getChunkLoaders())
+		{
+			for (auto& pending : loader->getPendingEncodes())
+			{
+				backup->pendingChunks.push_back({loader->getDimension(), pending.first, pending.second});
+			}
+		}
+	}
+
+	LOGGER->info("Starting backup of {} to {}", backup->source.string(), backup->target.string());
+	backup->thread = std::thread(&WorldBackup::run, backup.get());
+	return backup;
+}
+
+WorldBackup::WorldBackup(std::filesystem::path sourceIn, std::filesystem::path targetIn)
+	:source(std::move(sourceIn)), target(std::move(targetIn))
+{
+}
+
+WorldBackup::~WorldBackup()
+{
+	waitForFinish();
+}
+
+WorldBackup::State WorldBackup::getState() const
+{
+	return state;
+}
+
+uint64_t WorldBackup::getBytesWritten() const
+{
+	return bytesWritten;
+}
+
+uint32_t WorldBackup::getFilesWritten() const
+{
+	return filesWritten;
+}
+
+uint32_t WorldBackup::getTotalFiles() const
+{
+	return totalFiles;
+}
+
+std::string WorldBackup::getError()
+{
+	std::lock_guard<std::mutex> guard(errorLock);
+	return error;
+}
+
+void WorldBackup::waitForFinish()
+{
+	if (thread.joinable())
+	{
+		thread.join();
+	}
+}
+
+void WorldBackup::run()
+{
+	auto begin = std::chrono::steady_clock::now();
+	try
+	{
+		std::filesystem::create_directories(target);
+		std::unordered_set<std::string> overlaid;
+		for (auto& overlay : overlays)
+		{
+			overlaid.emplace(overlay.relative.generic_string());
+		}
+
+		auto absoluteTarget = std::filesystem::absolute(target).lexically_normal();
+		std::vector<std::filesystem::path> files;
+		std::error_code errorCode;
+		for (auto& entry : std::filesystem::recursive_directory_iterator(source))
+		{
+			// .tmp files are renamed into place by AsyncFileIO at any moment, the finished file is picked up instead
+			if (!entry.is_regular_file(errorCode) || entry.path().extension() == ".tmp"
+				|| isWithin(std::filesystem::absolute(entry.path()).lexically_normal(), absoluteTarget))
+			{
+				continue;
+			}
+
+			auto relative = entry.path().lexically_relative(source);
+			if (*relative.begin() != "chunklog" && relative != "session.lock" && overlaid.find(relative.generic_string()) == overlaid.end())
+			{
+				files.emplace_back(relative);
+			}
+		}
+
+		totalFiles = static_cast<uint32_t>(files.size() + overlays.size() + chunkSnapshot.segmentSizes.size());
+		for (auto& relative : files)
+		{
+			if (copyFile(source / relative, target / relative, std::numeric_limits<uint64_t>::max()))
+			{
+				++filesWritten;
+				reportProgress();
+			}
+			else
+			{
+				LOGGER->debug("{} was deleted before it could be copied, skipping it", relative.string());
+				--totalFiles;
+			}
+		}
+
+		for (auto& overlay : overlays)
+		{
+			writeFile(target / overlay.relative, CompressedStreamTools::compress(overlay.compound.get()));
+			++filesWritten;
+			reportProgress();
+		}
+
+		writeChunkLog();
+		state = State::DONE;
+		auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - begin);
+		LOGGER->info("Backup finished: {} files, {} bytes in {} ms", filesWritten.load(), bytesWritten.load(), elapsed.count());
+	}
+	catch (std::exception& e)
+	{
+		{
+			std::lock_guard<std::mutex> guard(errorLock);
+			error = e.what();
+		}
+
+		state = State::FAILED;
+		LOGGER->error("Backup to {} failed: {}", target.string(), e.what());
+	}
+
+	if (chunkLogStore != nullptr)
+	{
+		chunkLogStore->releaseSnapshot();
+		chunkLogStore.reset();
+	}
+
+	overlays.clear();
+	pendingChunks.clear();
+}
+
+bool WorldBackup::copyFile(const std::filesystem::path& from, const std::filesystem::path& to, uint64_t limit)
+{
+	try
+	{
+		copyFileOnce(from, to, limit);
+		return true;
+	}
+	catch (std::filesystem::filesystem_error& e)
+	{
+		if (!isVanished(e))
+		{
+			throw;
+		}
+	}
+
+	std::error_code errorCode;
+	std::filesystem::remove(to, errorCode);
+	return false;
+}
+
+void WorldBackup::copyFileOnce(const std::filesystem::path& from, const std::filesystem::path& to, uint64_t limit)
+{
+	std::filesystem::create_directories(to.parent_path());
+	std::vector<char> buffer(COPY_BUFFER_SIZE);
+	for (auto attempt = 1; ; ++attempt)
+	{
+		auto modified = std::filesystem::last_write_time(from);
+		auto size = std::filesystem::file_size(from);
+		std::ifstream input(from, std::ios::binary);
+		if (!input)
+		{
+			// lost the race with a delete or rename after the size was read
+			throw std::filesystem::filesystem_error("Failed to open", from, std::make_error_code(std::errc::no_such_file_or_directory));
+		}
+
+		std::ofstream output(to, std::ios::binary | std::ios::trunc);
+		auto remaining = std::min(limit, static_cast<uint64_t>(size));
+		while (remaining > 0 && input)
+		{
+			input.read(buffer.data(), static_cast<std::streamsize>(std::min<uint64_t>(remaining, buffer.size())));
+			auto count = static_cast<uint64_t>(input.gcount());
+			if (count == 0)
+			{
+				break;
+			}
+
+			output.write(buffer.data(), static_cast<std::streamsize>(count));
+			bytesWritten += count;
+			remaining -= count;
+		}
+
+		if (!output)
+		{
+			throw std::runtime_error("Failed to write " + to.string());
+		}
+
+		// segments are only read below their committed size, which never changes underneath us
+		if (limit != std::numeric_limits<uint64_t>::max()
+			|| (std::filesystem::last_write_time(from) == modified && std::filesystem::file_size(from) == size))
+		{
+			return;
+		}
+
+		if (attempt == COPY_ATTEMPTS)
+		{
+			LOGGER->warn("{} kept changing while it was copied, the backup may hold a partial write", from.string());
+			return;
+		}
+	}
+}
+
+void WorldBackup::writeFile(const std::filesystem::path& to, std::string_view contents)
+{
+	std::filesystem::create_directories(to.parent_path());
+	std::ofstream output(to, std::ios::binary | std::ios::trunc);
+	output.write(contents.data(), static_cast<std::streamsize>(contents.size()));
+	if (!output)
+	{
+		throw std::runtime_error("Failed to write " + to.string());
+	}
+
+	bytesWritten += contents.size();
+}
+
+void WorldBackup::writeChunkLog()
+{
+	if (chunkLogStore == nullptr)
+	{
+		return;
+	}
+
+	auto directory = target / "chunklog";
+	for (auto& segment : chunkSnapshot.segmentSizes)
+	{
+		// pinned by the snapshot, a missing segment is a real failure
+		auto path = chunkLogStore->getSegmentPath(segment.first);
+		copyFileOnce(path, directory / path.filename(), segment.second);
+		++filesWritten;
+		reportProgress();
+	}
+
+	// replaying the writes that were still in flight at snapshot time onto the copied prefixes
+	ChunkLogStore copy(directory);
+	auto before = copy.getStatistics().totalBytes;
+	for (auto& buffered : chunkSnapshot.buffered)
+	{
+		auto& value = std::get<2>(buffered);
+		if (value)
+		{
+			copy.put(std::get<0>(buffered), std::get<1>(buffered), *value);
+		}
+		else
+		{
+			copy.remove(std::get<0>(buffered), std::get<1>(buffered));
+		}
+	}
+
+	for (auto& pending : pendingChunks)
+	{
+		copy.put(pending.dimension, pending.pos, pending.encoded.get());
+	}
+
+	copy.flush();
+	bytesWritten += copy.getStatistics().totalBytes - before;
+}
+
+void WorldBackup::reportProgress()
+{
+	auto step = std::max<uint32_t>(1, totalFiles / 10);
+	if (filesWritten % step == 0)
+	{
+		LOGGER->info("Backup progress: {}/{} files, {} bytes", filesWritten.load(), totalFiles.load(), bytesWritten.load());
+	}
+}
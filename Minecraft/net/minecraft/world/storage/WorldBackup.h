@@ -0,0 +1,84 @@
+#pragma once
+#include <atomic>
+#include <filesystem>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "../chunk/storage/ChunkLogStore.h"
+
+namespace spdlog {
+	class logger;
+}
+
+class NBTTagCompound;
+class WorldServer;
+
+// Online backup of a running world. start() captures a consistent logical snapshot on the calling (tick)
+// thread: dirty chunks are handed to the chunk store, while dirty WorldSavedData, online players and
+// level.dat are copied as NBT. The append-only chunk log is pinned rather than copied. A background
+// thread then streams the snapshot into the target directory, so the tick never waits on disk I/O.
+class WorldBackup
+{
+public:
+	enum class State
+	{
+		RUNNING,
+		DONE,
+		FAILED
+	};
+
+	static std::unique_ptr<WorldBackup> start(const std::vector<WorldServer*>& worlds, std::filesystem::path target);
+	~WorldBackup();
+	WorldBackup(const WorldBackup&) = delete;
+	WorldBackup& operator=(const WorldBackup&) = delete;
+
+	State getState() const;
+	uint64_t getBytesWritten() const;
+	uint32_t getFilesWritten() const;
+	uint32_t getTotalFiles() const;
+	std::string getError();
+	void waitForFinish();
+private:
+	struct Overlay
+	{
+		std::filesystem::path relative;
+		std::shared_ptr<NBTTagCompound> compound;
+	};
+
+	struct PendingChunk
+	{
+		int32_t dimension;
+		int64_t pos;
+		std::shared_future<std::string> encoded;
+	};
+
+	static std::shared_ptr<spdlog::logger> LOGGER;
+	static constexpr int32_t COPY_ATTEMPTS = 3;
+
+	std::filesystem::path source;
+	std::filesystem::path target;
+	std::vector<Overlay> overlays;
+	std::shared_ptr<ChunkLogStore> chunkLogStore;
+	ChunkLogStore::Snapshot chunkSnapshot;
+	std::vector<PendingChunk> pendingChunks;
+
+	std::atomic<State> state{State::RUNNING};
+	std::atomic<uint64_t> bytesWritten{0};
+	std::atomic<uint32_t> filesWritten{0};
+	std::atomic<uint32_t> totalFiles{0};
+	std::mutex errorLock;
+	std::string error;
+	std::thread thread;
+
+	WorldBackup(std::filesystem::path sourceIn, std::filesystem::path targetIn);
+	void run();
+	// false when from was deleted before or while it was copied, which the live world does to its temporary files
+	bool copyFile(const std::filesystem::path& from, const std::filesystem::path& to, uint64_t limit);
+	void copyFileOnce(const std::filesystem::path& from, const std::filesystem::path& to, uint64_t limit);
+	void writeFile(const std::filesystem::path& to, std::string_view contents);
+	void writeChunkLog();
+	void reportProgress();
+};
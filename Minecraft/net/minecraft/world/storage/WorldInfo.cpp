@@ -481,7 +481,7 @@ void WorldInfo::setServerInitialized(bool initializedIn)
 	initialized = initializedIn;
 }
 
-GameRules WorldInfo::getGameRulesInstance() const
+GameRules& WorldInfo::getGameRulesInstance()
 {
 	return gameRules;
 }
@@ -61,7 +61,7 @@ public:
 	virtual void setAllowCommands(bool allow);
 	virtual bool isInitialized() const;
 	virtual void setServerInitialized(bool initializedIn);
-	virtual GameRules getGameRulesInstance() const;
+	virtual GameRules& getGameRulesInstance();
 	double getBorderCenterX() const;
 	double getBorderSize() const;
 	double getBorderCenterZ() const;
@@ -19,3 +19,8 @@ bool WorldSavedData::isDirty() const
 {
 	return dirty;
 }
+
+bool WorldSavedData::canEvict() const
+{
+	return false;
+}
@@ -14,6 +14,8 @@ public:
 	void markDirty();
 	void setDirty(bool isDirty);
 	bool isDirty() const;
+	// Whether MapStorage may drop this instance while clean; reloading it must be indistinguishable.
+	virtual bool canEvict() const;
 private: 
 	bool dirty;
 
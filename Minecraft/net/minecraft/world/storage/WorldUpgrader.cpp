@@ -0,0 +1,302 @@
+#include "WorldUpgrader.h"
+#include "CompressedStreamTools.h"
+#include "NBTTagCompound.h"
+#include "WorkerPool.h"
+#include "datafix/DataFixer.h"
+#include "datafix/FixTypes.h"
+#include "../chunk/storage/ChunkLogStore.h"
+#include "../chunk/storage/LogStructuredChunkLoader.h"
+#include "spdlog/spdlog.h"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <fstream>
+#include <future>
+#include <limits>
+#include <vector>
+
+std::shared_ptr<spdlog::logger> WorldUpgrader::LOGGER = spdlog::get("Minecraft")->clone("WorldUpgrader");
+
+namespace
+{
+	constexpr std::array<std::string_view, 2> STAGES = { "chunks", "players" };
+	constexpr std::string_view CHECKPOINT_FILE = "upgrade.checkpoint";
+	constexpr std::string_view FAILURES_FILE = "upgrade.failures";
+
+	std::string readFile(const std::filesystem::path& path)
+	{
+		std::ifstream input(path, std::ios::binary);
+		return std::string(std::istreambuf_iterator<char>(input), std::istreambuf_iterator<char>());
+	}
+
+	void writeFileAtomically(const std::filesystem::path& path, std::string_view contents)
+	{
+		auto temporary = path;
+		temporary += ".tmp";
+		{
+			std::ofstream output(temporary, std::ios::binary | std::ios::trunc);
+			output.write(contents.data(), static_cast<std::streamsize>(contents.size()));
+			if (!output)
+			{
+				throw std::runtime_error("Failed to write " + temporary.string());
+			}
+		}
+
+		std::filesystem::rename(temporary, path);
+	}
+
+	int32_t getDataVersion(NBTTagCompound* compound)
+	{
+		return compound->hasKey("DataVersion", 99) ? compound->getInteger("DataVersion") : -1;
+	}
+
+	double secondsSince(std::chrono::steady_clock::time_point begin)
+	{
+		return std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+	}
+}
+
+WorldUpgrader::WorldUpgrader(std::filesystem::path worldDirectoryIn, DataFixer& dataFixerIn, uint32_t threadCount)
+	:worldDirectory(std::move(worldDirectoryIn)), dataFixer(dataFixerIn), pool(std::make_unique<WorkerPool>("Upgrade Worker", threadCount))
+{
+}
+
+WorldUpgrader::~WorldUpgrader() = default;
+
+WorldUpgrader::Statistics WorldUpgrader::run()
+{
+	auto begin = std::chrono::steady_clock::now();
+	LOGGER->info("Upgrading {} to data version {} on {} threads", worldDirectory.string(), dataFixer.getVersion(), pool->getThreadCount());
+	std::filesystem::remove(worldDirectory / FAILURES_FILE);
+	upgradeLevel();
+	auto chunks = upgradeChunks();
+	auto players = upgradePlayers();
+	if (failed == 0)
+	{
+		std::filesystem::remove(worldDirectory / CHECKPOINT_FILE);
+	}
+
+	Statistics statistics{chunks, players, upgraded, failed, bytesRead, secondsSince(begin)};
+	LOGGER->info("Upgrade finished: {} chunks and {} players checked, {} rewritten, {:.1f} MiB read in {:.1f} s",
+		statistics.chunks, statistics.players, statistics.upgraded, statistics.bytesRead / (1024.0 * 1024.0), statistics.seconds);
+	if (statistics.failed != 0)
+	{
+		LOGGER->warn("{} files failed to upgrade and are listed in {}; run the upgrade again to retry them", statistics.failed, FAILURES_FILE);
+	}
+
+	return statistics;
+}
+
+void WorldUpgrader::upgradeLevel()
+{
+	auto file = worldDirectory / "level.dat";
+	if (std::filesystem::exists(file) && !upgradeFile(file, FixTypes::LEVEL, true))
+	{
+		recordFailures("level", { file.filename().string() });
+	}
+}
+
+uint64_t WorldUpgrader::upgradeChunks()
+{
+	auto directory = worldDirectory / "chunklog";
+	if (!std::filesystem::exists(directory))
+	{
+		return 0;
+	}
+
+	ChunkLogStore store(directory);
+	auto keys = store.getKeys();
+	auto begin = std::chrono::steady_clock::now();
+	auto first = std::min(loadCheckpoint("chunks"), keys.size());
+	if (first != 0 && first < keys.size())
+	{
+		LOGGER->info("Resuming chunk upgrade at {}/{}", first, keys.size());
+	}
+
+	// index of the first chunk that failed, the checkpoint stays there so a resumed run retries it
+	auto firstFailure = keys.size();
+	for (auto batch = first; batch < keys.size(); batch += BATCH_SIZE)
+	{
+		auto end = std::min(keys.size(), batch + BATCH_SIZE);
+		std::vector<std::future<bool>> tasks;
+		tasks.reserve(end - batch);
+		for (auto i = batch; i < end; ++i)
+		{
+			tasks.emplace_back(pool->submit([this, &store, key = keys[i]]()
+			{
+				try
+				{
+					auto data = store.get(key.first, key.second);
+					if (!data)
+					{
+						return true;
+					}
+
+					bytesRead += data->size();
+					auto compound = std::shared_ptr<NBTTagCompound>(LogStructuredChunkLoader::decode(*data));
+					auto dataVersion = getDataVersion(compound.get());
+					if (!dataFixer.needsFixing(FixTypes::CHUNK, dataVersion))
+					{
+						return true;
+					}
+
+					auto format = ColumnarChunkCodec::isEncoded(*data) ? ChunkStorageFormat::COLUMNAR : ChunkStorageFormat::NBT;
+					compound = dataFixer.process(FixTypes::CHUNK, compound, dataVersion);
+					compound->setInteger("DataVersion", dataFixer.getVersion());
+					store.put(key.first, key.second, LogStructuredChunkLoader::encode(compound.get(), format));
+					++upgraded;
+					return true;
+				}
+				catch (std::exception& e)
+				{
+					LOGGER->error("Failed to upgrade chunk {} in dimension {}: {}", key.second, key.first, e.what());
+					++failed;
+					return false;
+				}
+			}));
+		}
+
+		std::vector<std::string> failures;
+		for (auto i = batch; i < end; ++i)
+		{
+			if (!tasks[i - batch].get())
+			{
+				firstFailure = std::min(firstFailure, i);
+				failures.emplace_back(std::to_string(keys[i].first) + " " + std::to_string(keys[i].second));
+			}
+		}
+
+		store.flush();
+		recordFailures("chunks", failures);
+		saveCheckpoint("chunks", std::min(firstFailure, end));
+		reportThroughput("chunks", end - first, end, keys.size(), secondsSince(begin));
+	}
+
+	return keys.size();
+}
+
+uint64_t WorldUpgrader::upgradePlayers()
+{
+	auto directory = worldDirectory / "playerdata";
+	if (!std::filesystem::exists(directory))
+	{
+		return 0;
+	}
+
+	std::vector<std::filesystem::path> files;
+	for (auto& entry : std::filesystem::directory_iterator(directory))
+	{
+		if (entry.is_regular_file() && entry.path().extension() == ".dat")
+		{
+			files.emplace_back(entry.path());
+		}
+	}
+
+	std::sort(files.begin(), files.end());
+	auto begin = std::chrono::steady_clock::now();
+	auto first = std::min(loadCheckpoint("players"), files.size());
+	auto firstFailure = files.size();
+	for (auto batch = first; batch < files.size(); batch += BATCH_SIZE)
+	{
+		auto end = std::min(files.size(), batch + BATCH_SIZE);
+		std::vector<std::future<bool>> tasks;
+		tasks.reserve(end - batch);
+		for (auto i = batch; i < end; ++i)
+		{
+			tasks.emplace_back(pool->submit([this, &file = files[i]]()
+			{
+				return upgradeFile(file, FixTypes::PLAYER, false);
+			}));
+		}
+
+		std::vector<std::string> failures;
+		for (auto i = batch; i < end; ++i)
+		{
+			if (!tasks[i - batch].get())
+			{
+				firstFailure = std::min(firstFailure, i);
+				failures.emplace_back(files[i].filename().string());
+			}
+		}
+
+		recordFailures("players", failures);
+		saveCheckpoint("players", std::min(firstFailure, end));
+		reportThroughput("players", end - first, end, files.size(), secondsSince(begin));
+	}
+
+	return files.size();
+}
+
+bool WorldUpgrader::upgradeFile(const std::filesystem::path& file, FixTypes type, bool nestedInData)
+{
+	try
+	{
+		auto contents = readFile(file);
+		bytesRead += contents.size();
+		auto root = std::shared_ptr<NBTTagCompound>(CompressedStreamTools::decompress(contents));
+		// level.dat keeps its version inside "Data"; fixes rewrite that compound in place through the alias
+		auto compound = nestedInData ? std::shared_ptr<NBTTagCompound>(root, root->getCompoundTag("Data")) : root;
+		auto dataVersion = getDataVersion(compound.get());
+		if (!dataFixer.needsFixing(type, dataVersion))
+		{
+			return true;
+		}
+
+		auto fixed = dataFixer.process(type, compound, dataVersion);
+		fixed->setInteger("DataVersion", dataFixer.getVersion());
+		writeFileAtomically(file, CompressedStreamTools::compress(nestedInData ? root.get() : fixed.get()));
+		++upgraded;
+		return true;
+	}
+	catch (std::exception& e)
+	{
+		LOGGER->error("Failed to upgrade {}: {}", file.string(), e.what());
+		++failed;
+		return false;
+	}
+}
+
+size_t WorldUpgrader::loadCheckpoint(std::string_view stage) const
+{
+	std::ifstream input(worldDirectory / CHECKPOINT_FILE);
+	std::string recorded;
+	size_t position = 0;
+	if (!(input >> recorded >> position))
+	{
+		return 0;
+	}
+
+	auto current = std::find(STAGES.begin(), STAGES.end(), stage);
+	auto checkpoint = std::find(STAGES.begin(), STAGES.end(), recorded);
+	if (checkpoint == STAGES.end() || checkpoint < current)
+	{
+		return 0;
+	}
+
+	return checkpoint == current ? position : std::numeric_limits<size_t>::max();
+}
+
+void WorldUpgrader::saveCheckpoint(std::string_view stage, size_t position) const
+{
+	writeFileAtomically(worldDirectory / CHECKPOINT_FILE, std::string(stage) + " " + std::to_string(position) + "\n");
+}
+
+void WorldUpgrader::recordFailures(std::string_view stage, const std::vector<std::string>& entries) const
+{
+	if (entries.empty())
+	{
+		return;
+	}
+
+	std::ofstream output(worldDirectory / FAILURES_FILE, std::ios::app);
+	for (auto& entry : entries)
+	{
+		output << stage << " " << entry << "\n";
+	}
+}
+
+void WorldUpgrader::reportThroughput(std::string_view stage, size_t processed, size_t done, size_t total, double seconds) const
+{
+	LOGGER->info("Upgraded {}/{} {} ({:.1f}%), {:.0f}/s", done, total, stage, 100.0 * done / std::max<size_t>(total, 1), seconds > 0.0 ? processed / seconds : 0.0);
+}
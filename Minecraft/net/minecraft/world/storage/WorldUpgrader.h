@@ -0,0 +1,57 @@
+#pragma once
+#include <atomic>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace spdlog {
+	class logger;
+}
+
+class DataFixer;
+class WorkerPool;
+enum class FixTypes;
+
+// Offline upgrade of a stopped world to the current DataVersion: level.dat, every chunk in the chunk log
+// and every player file are run through the DataFixer on all cores. Work is committed in batches behind a
+// checkpoint file, so an interrupted upgrade resumes at the last finished batch. The checkpoint never moves past
+// a chunk or player that failed to upgrade; failures are listed in upgrade.failures and retried by the next run.
+class WorldUpgrader
+{
+public:
+	struct Statistics
+	{
+		uint64_t chunks;
+		uint64_t players;
+		uint64_t upgraded;
+		uint64_t failed;
+		uint64_t bytesRead;
+		double seconds;
+	};
+
+	static constexpr size_t BATCH_SIZE = 1024;
+
+	WorldUpgrader(std::filesystem::path worldDirectoryIn, DataFixer& dataFixerIn, uint32_t threadCount = 0);
+	~WorldUpgrader();
+	Statistics run();
+private:
+	static std::shared_ptr<spdlog::logger> LOGGER;
+
+	std::filesystem::path worldDirectory;
+	DataFixer& dataFixer;
+	std::unique_ptr<WorkerPool> pool;
+	std::atomic<uint64_t> upgraded{0};
+	std::atomic<uint64_t> failed{0};
+	std::atomic<uint64_t> bytesRead{0};
+
+	void upgradeLevel();
+	uint64_t upgradeChunks();
+	uint64_t upgradePlayers();
+	// False when the file could not be read, fixed or written; files already up to date count as success.
+	bool upgradeFile(const std::filesystem::path& file, FixTypes type, bool nestedInData);
+	size_t loadCheckpoint(std::string_view stage) const;
+	void saveCheckpoint(std::string_view stage, size_t position) const;
+	void recordFailures(std::string_view stage, const std::vector<std::string>& entries) const;
+	void reportThroughput(std::string_view stage, size_t processed, size_t done, size_t total, double seconds) const;
+};
@@ -0,0 +1,14 @@
+#pragma once
+#include <cstdlib>
+#include <iostream>
+
+// Minimal assertion for the standalone test executables, kept active in release builds.
+#define CHECK(condition) \
+	do \
+	{ \
+		if (!(condition)) \
+		{ \
+			std::cerr << __FILE__ << ":" << __LINE__ << ": check failed: " #condition << std::endl; \
+			std::exit(EXIT_FAILURE); \
+		} \
+	} while (false)
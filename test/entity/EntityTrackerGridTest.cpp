@@ -0,0 +1,112 @@
+#include "Check.h"
+#include "EntityTrackerGrid.h"
+
+#include <algorithm>
+#include <vector>
+
+namespace
+{
+	// the grid only reads the position of the tracked entity
+	struct TestEntity
+	{
+		double posX;
+		double posZ;
+
+		void moveTo(double x, double z)
+		{
+			posX = x;
+			posZ = z;
+		}
+	};
+
+	class TestEntry
+	{
+	public:
+		explicit TestEntry(TestEntity* entityIn)
+			:entity(entityIn)
+		{
+		}
+
+		TestEntity* getTrackedEntity() const
+		{
+			return entity;
+		}
+	private:
+		TestEntity* entity;
+	};
+
+	using Grid = BasicEntityTrackerGrid<TestEntry>;
+
+	std::vector<TestEntry*> inChunk(const Grid& grid, int32_t chunkX, int32_t chunkZ)
+	{
+		std::vector<TestEntry*> found;
+		grid.forEachEntryInChunk(chunkX, chunkZ, [&](TestEntry* entry) { found.emplace_back(entry); });
+		return found;
+	}
+
+	std::vector<TestEntry*> near(const Grid& grid, double x, double z, double range)
+	{
+		std::vector<TestEntry*> found;
+		grid.forEachEntryNear(x, z, range, [&](TestEntry* entry) { found.emplace_back(entry); });
+		std::sort(found.begin(), found.end());
+		return found;
+	}
+
+	bool contains(const std::vector<TestEntry*>& entries, TestEntry* entry)
+	{
+		return std::find(entries.begin(), entries.end(), entry) != entries.end();
+	}
+}
+
+int main()
+{
+	TestEntity first{1.0, 1.0};
+	TestEntity second{40.0, 1.0};
+	TestEntry firstEntry(&first);
+	TestEntry secondEntry(&second);
+
+	Grid grid;
+	grid.add(&firstEntry);
+	grid.add(&secondEntry);
+	grid.add(&firstEntry);
+	CHECK(grid.size() == 2);
+	CHECK(inChunk(grid, 0, 0) == std::vector<TestEntry*>{&firstEntry});
+	CHECK(inChunk(grid, 2, 0) == std::vector<TestEntry*>{&secondEntry});
+
+	// moving inside the column keeps the cell
+	first.moveTo(15.9, 0.1);
+	CHECK(!grid.update(&firstEntry));
+	CHECK(inChunk(grid, 0, 0) == std::vector<TestEntry*>{&firstEntry});
+
+	// crossing into a negative column moves it and leaves the old cell empty
+	first.moveTo(17.0, -0.5);
+	CHECK(grid.update(&firstEntry));
+	CHECK(inChunk(grid, 0, 0).empty());
+	CHECK(inChunk(grid, 1, -1) == std::vector<TestEntry*>{&firstEntry});
+	CHECK(grid.size() == 2);
+
+	// a query only meets the cells in range of it, however it walks them
+	auto nearFirst = near(grid, 17.0, -0.5, 8.0);
+	CHECK(contains(nearFirst, &firstEntry));
+	CHECK(!contains(nearFirst, &secondEntry));
+	CHECK(near(grid, 0.0, 0.0, 100000.0).size() == 2);
+	CHECK(near(grid, -200.0, -200.0, 16.0).empty());
+
+	// both entries in one cell, then one leaves it again
+	second.moveTo(20.0, -3.0);
+	CHECK(grid.update(&secondEntry));
+	CHECK(inChunk(grid, 1, -1).size() == 2);
+	CHECK(inChunk(grid, 2, 0).empty());
+	first.moveTo(-1.0, 40.0);
+	CHECK(grid.update(&firstEntry));
+	CHECK(inChunk(grid, 1, -1) == std::vector<TestEntry*>{&secondEntry});
+	CHECK(inChunk(grid, -1, 2) == std::vector<TestEntry*>{&firstEntry});
+
+	grid.remove(&firstEntry);
+	grid.remove(&firstEntry);
+	CHECK(!grid.update(&firstEntry));
+	CHECK(grid.size() == 1);
+	CHECK(inChunk(grid, -1, 2).empty());
+	CHECK(near(grid, 0.0, 0.0, 100000.0) == std::vector<TestEntry*>{&secondEntry});
+	return 0;
+}
@@ -0,0 +1,46 @@
+#include "Check.h"
+#include "StatBase.h"
+#include "StatList.h"
+#include "StatisticsManagerServer.h"
+
+#include <limits>
+
+int main()
+{
+	CHECK(StatList::ALL_STATS.size() > 4);
+
+	std::vector<int32_t> stats(StatList::ALL_STATS.size());
+	stats[0] = 1;
+	stats[1] = -7;
+	stats[2] = std::numeric_limits<int32_t>::max();
+	stats[3] = std::numeric_limits<int32_t>::min();
+	stats.back() = 300;
+
+	auto encoded = StatisticsManagerServer::encodeStats(stats);
+	CHECK(encoded.substr(0, 4) == "MCST");
+	CHECK(encoded[4] == 1);
+	// five non-zero counters, a count below 128 is a single varint byte
+	CHECK(encoded[5] == 5);
+
+	auto decoded = StatisticsManagerServer::decodeStats(encoded);
+	CHECK(decoded.has_value());
+	CHECK(*decoded == stats);
+
+	// all zero counters still round-trip to a full sized vector
+	std::vector<int32_t> empty(StatList::ALL_STATS.size());
+	auto decodedEmpty = StatisticsManagerServer::decodeStats(StatisticsManagerServer::encodeStats(empty));
+	CHECK(decodedEmpty.has_value());
+	CHECK(*decodedEmpty == empty);
+
+	// wrong magic, unknown version and every truncation of a valid file are rejected
+	CHECK(!StatisticsManagerServer::decodeStats("MCSX" + encoded.substr(4)).has_value());
+	auto otherVersion = encoded;
+	otherVersion[4] = 2;
+	CHECK(!StatisticsManagerServer::decodeStats(otherVersion).has_value());
+	for (size_t length = 0; length < encoded.size(); ++length)
+	{
+		CHECK(!StatisticsManagerServer::decodeStats(std::string_view(encoded).substr(0, length)).has_value());
+	}
+
+	return 0;
+}
@@ -0,0 +1,110 @@
+#include "Check.h"
+#include "EntitySlotMap.h"
+
+#include <memory>
+#include <vector>
+
+namespace
+{
+	// the slot map only touches the id and the handle, a full Entity would drag in the world
+	class TestEntity
+	{
+	public:
+		explicit TestEntity(int32_t id)
+			:entityId(id)
+		{
+		}
+
+		int32_t getEntityId() const
+		{
+			return entityId;
+		}
+
+		void setEntityId(int32_t id)
+		{
+			entityId = id;
+		}
+
+		EntityHandle getHandle() const
+		{
+			return handle;
+		}
+
+		void setHandle(EntityHandle handleIn)
+		{
+			handle = handleIn;
+		}
+	private:
+		int32_t entityId;
+		EntityHandle handle;
+	};
+}
+
+int main()
+{
+	BasicEntitySlotMap<TestEntity> slots;
+	std::vector<std::unique_ptr<TestEntity>> entities;
+	std::vector<EntityHandle> handles;
+	for (int32_t i = 0; i < 3 * BasicEntitySlotMap<TestEntity>::PAGE_SIZE; ++i)
+	{
+		entities.emplace_back(std::make_unique<TestEntity>(i * 2));
+		handles.emplace_back(slots.add(entities.back().get()));
+		CHECK(entities.back()->getHandle() == handles.back());
+	}
+
+	CHECK(slots.size() == entities.size());
+	for (size_t i = 0; i < entities.size(); ++i)
+	{
+		CHECK(slots.get(handles[i]) == entities[i].get());
+		CHECK(slots.getById(static_cast<int32_t>(i) * 2) == entities[i].get());
+		CHECK(slots.getById(static_cast<int32_t>(i) * 2 + 1) == nullptr);
+	}
+
+	// removing every other entity leaves stale handles and ids that resolve to nothing
+	for (size_t i = 0; i < entities.size(); i += 2)
+	{
+		slots.remove(entities[i].get());
+		CHECK(!entities[i]->getHandle().isValid());
+	}
+
+	CHECK(slots.size() == entities.size() / 2);
+	for (size_t i = 0; i < entities.size(); ++i)
+	{
+		auto expected = i % 2 == 0 ? nullptr : entities[i].get();
+		CHECK(slots.get(handles[i]) == expected);
+		CHECK(slots.getById(static_cast<int32_t>(i) * 2) == expected);
+	}
+
+	// removing twice is harmless
+	slots.remove(entities[0].get());
+	CHECK(slots.size() == entities.size() / 2);
+
+	// freed slots are reused under a new generation, the old handles stay dead
+	for (size_t i = 0; i < entities.size(); i += 2)
+	{
+		entities[i]->setEntityId(1000000 + static_cast<int32_t>(i));
+		auto handle = slots.add(entities[i].get());
+		CHECK(handle.index < entities.size());
+		CHECK(handle != handles[i]);
+		CHECK(slots.get(handle) == entities[i].get());
+		CHECK(slots.get(handles[i]) == nullptr);
+		CHECK(slots.getById(1000000 + static_cast<int32_t>(i)) == entities[i].get());
+	}
+
+	CHECK(slots.size() == entities.size());
+	CHECK(slots.getById(-1) == nullptr);
+	CHECK(slots.getById(1 << 30) == nullptr);
+
+	for (auto& entity : entities)
+	{
+		slots.remove(entity.get());
+	}
+
+	CHECK(slots.size() == 0);
+	for (size_t i = 0; i < entities.size(); ++i)
+	{
+		CHECK(slots.getById(static_cast<int32_t>(i) * 2) == nullptr);
+	}
+
+	return 0;
+}
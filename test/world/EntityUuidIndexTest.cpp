@@ -0,0 +1,106 @@
+#include "Check.h"
+#include "EntityUuidIndex.h"
+
+#include <array>
+#include <map>
+#include <random>
+#include <vector>
+
+namespace
+{
+	xg::Guid makeUuid(std::mt19937_64& random)
+	{
+		std::array<unsigned char, 16> bytes;
+		for (auto& byte : bytes)
+		{
+			byte = static_cast<unsigned char>(random());
+		}
+
+		return xg::Guid(bytes);
+	}
+
+	void checkMatches(const EntityUuidIndex& index, const std::vector<xg::Guid>& uuids, const std::map<size_t, Entity*>& expected)
+	{
+		CHECK(index.size() == expected.size());
+		for (size_t i = 0; i < uuids.size(); ++i)
+		{
+			auto entry = expected.find(i);
+			CHECK(index.get(uuids[i]) == (entry == expected.end() ? nullptr : entry->second));
+		}
+	}
+}
+
+int main()
+{
+	// the index never dereferences the entities, distinct addresses are enough
+	std::vector<char> storage(4096);
+	auto entityAt = [&](size_t i) { return reinterpret_cast<Entity*>(&storage[i % storage.size()]); };
+
+	std::mt19937_64 random(1);
+	std::vector<xg::Guid> uuids;
+	for (size_t i = 0; i < 2000; ++i)
+	{
+		uuids.emplace_back(makeUuid(random));
+	}
+
+	EntityUuidIndex index;
+	std::map<size_t, Entity*> expected;
+	CHECK(index.get(uuids[0]) == nullptr);
+	index.remove(uuids[0]);
+	CHECK(index.size() == 0);
+
+	// fill to just under the growth threshold so clusters are long, then delete from their middles
+	for (size_t i = 0; i < 47; ++i)
+	{
+		index.put(uuids[i], entityAt(i));
+		expected[i] = entityAt(i);
+	}
+
+	checkMatches(index, uuids, expected);
+	for (size_t i = 0; i < 47; i += 3)
+	{
+		index.remove(uuids[i]);
+		expected.erase(i);
+		checkMatches(index, uuids, expected);
+	}
+
+	// putting an indexed uuid again replaces its entity without adding an entry
+	index.put(uuids[1], entityAt(100));
+	expected[1] = entityAt(100);
+	checkMatches(index, uuids, expected);
+
+	// random churn across several growths
+	for (size_t step = 0; step < 20000; ++step)
+	{
+		auto i = random() % uuids.size();
+		if (random() % 3 == 0)
+		{
+			index.remove(uuids[i]);
+			expected.erase(i);
+		}
+		else
+		{
+			index.put(uuids[i], entityAt(step));
+			expected[i] = entityAt(step);
+		}
+
+		if (step % 1000 == 0)
+		{
+			checkMatches(index, uuids, expected);
+		}
+	}
+
+	checkMatches(index, uuids, expected);
+	for (auto& entry : std::map<size_t, Entity*>(expected))
+	{
+		index.remove(uuids[entry.first]);
+		expected.erase(entry.first);
+	}
+
+	checkMatches(index, uuids, expected);
+	index.put(uuids[5], entityAt(5));
+	index.clear();
+	CHECK(index.size() == 0);
+	CHECK(index.get(uuids[5]) == nullptr);
+	return 0;
+}
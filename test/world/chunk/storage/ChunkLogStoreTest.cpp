@@ -0,0 +1,118 @@
+#include "Check.h"
+#include "chunk/storage/ChunkLogStore.h"
+
+#include <filesystem>
+#include <fstream>
+
+namespace
+{
+	std::filesystem::path makeDirectory()
+	{
+		auto directory = std::filesystem::temp_directory_path() / "ChunkLogStoreTest";
+		std::filesystem::remove_all(directory);
+		return directory;
+	}
+
+	void appendBytes(const std::filesystem::path& path, const std::string& bytes)
+	{
+		std::ofstream output(path, std::ios::binary | std::ios::app);
+		output.write(bytes.data(), bytes.size());
+	}
+}
+
+int main()
+{
+	auto directory = makeDirectory();
+	uint64_t committedSize;
+	{
+		ChunkLogStore store(directory);
+		store.put(0, 1, "first");
+		store.put(0, 2, "second");
+		store.put(-1, 1, "nether");
+		store.flush();
+		store.put(0, 2, "second, rewritten");
+		store.remove(-1, 1);
+		store.flush();
+		committedSize = std::filesystem::file_size(store.getSegmentPath(0));
+	}
+
+	// a crash in the middle of a group commit leaves a partial record header and a record whose payload was
+	// cut short behind the last complete record
+	auto segment = directory / "segment-00000000.log";
+	appendBytes(segment, std::string("\x12\x34\x56\x78\xff\xff\x00\x00\x00\x00", 10));
+	{
+		ChunkLogStore store(directory);
+		CHECK(std::filesystem::file_size(segment) == committedSize);
+		CHECK(store.get(0, 1) == std::optional<std::string>("first"));
+		CHECK(store.get(0, 2) == std::optional<std::string>("second, rewritten"));
+		CHECK(!store.contains(-1, 1));
+		CHECK(store.getStatistics().indexedChunks == 2);
+
+		// writes after recovery append behind the truncated tail
+		store.put(0, 3, "third");
+		store.flush();
+	}
+
+	// a torn write whose checksum no longer matches is discarded as well
+	std::string torn(21, '\0');
+	torn[4] = 4;
+	appendBytes(segment, torn + "abcd");
+	{
+		ChunkLogStore store(directory);
+		CHECK(store.get(0, 3) == std::optional<std::string>("third"));
+		CHECK(store.get(0, 1) == std::optional<std::string>("first"));
+		CHECK(store.getStatistics().indexedChunks == 3);
+	}
+
+	// stray files that only look like segments do not stop recovery
+	appendBytes(directory / "segment-0000000x.log", "junk");
+	appendBytes(directory / "segment-00000001.log.bak", "junk");
+	{
+		ChunkLogStore store(directory);
+		CHECK(store.get(0, 3) == std::optional<std::string>("third"));
+	}
+
+	// a one byte segment size rolls to a new segment on every flush
+	directory = makeDirectory();
+	{
+		ChunkLogStore store(directory, 1);
+		store.put(0, 9, std::string(256, 'z'));
+		store.flush();
+		store.put(0, 1, std::string(256, 'a'));
+		store.put(0, 2, "removed");
+		store.flush();
+		store.remove(0, 2);
+		store.flush();
+
+		// segment 2 holds only the tombstone, which has to outlive the dead value in segment 1
+		CHECK(store.compact());
+		CHECK(store.getStatistics().segmentCount == 4);
+	}
+
+	{
+		ChunkLogStore store(directory, 1);
+		CHECK(!store.contains(0, 2));
+		CHECK(store.get(0, 1) == std::optional<std::string>(std::string(256, 'a')));
+		store.put(0, 1, "replaced");
+		store.flush();
+
+		// once segment 1 is gone the carried tombstone shadows nothing and is dropped, not carried again
+		CHECK(store.compact());
+		CHECK(store.compact());
+		CHECK(!store.compact());
+		auto statistics = store.getStatistics();
+		CHECK(statistics.segmentCount == 3);
+		CHECK(statistics.liveBytes == statistics.totalBytes);
+	}
+
+	{
+		ChunkLogStore store(directory, 1);
+		CHECK(!store.contains(0, 2));
+		CHECK(store.get(0, 1) == std::optional<std::string>("replaced"));
+		CHECK(store.get(0, 9) == std::optional<std::string>(std::string(256, 'z')));
+		CHECK(store.getStatistics().indexedChunks == 2);
+	}
+
+	std::filesystem::remove_all(directory);
+	return 0;
+}
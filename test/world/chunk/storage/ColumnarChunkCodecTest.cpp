@@ -0,0 +1,108 @@
+#include "Check.h"
+#include "chunk/storage/ColumnarChunkCodec.h"
+#include "NBTTagCompound.h"
+#include "NBTTagList.h"
+
+#include <vector>
+
+namespace
+{
+	ByteBuffer toBuffer(std::vector<uint8_t> bytes)
+	{
+		return ByteBuffer(reinterpret_cast<std::byte*>(bytes.data()), bytes.size());
+	}
+
+	std::shared_ptr<NBTTagCompound> makeSection(int8_t y, bool uniform, bool withAdd, bool withSkyLight)
+	{
+		std::vector<uint8_t> blocks(4096);
+		std::vector<uint8_t> data(2048);
+		std::vector<uint8_t> add(2048);
+		std::vector<uint8_t> blockLight(2048);
+		std::vector<uint8_t> skyLight(2048, 0xFF);
+		for (size_t i = 0; i < blocks.size(); ++i)
+		{
+			blocks[i] = uniform ? 1 : static_cast<uint8_t>((i * 7) % 13);
+		}
+
+		for (size_t i = 0; i < data.size(); ++i)
+		{
+			data[i] = uniform ? 0 : static_cast<uint8_t>(i % 3);
+			add[i] = static_cast<uint8_t>(i % 512 == 0);
+			// runs of equal bytes so the light goes through the run-length path
+			blockLight[i] = static_cast<uint8_t>(i / 300);
+		}
+
+		auto section = std::make_shared<NBTTagCompound>();
+		section->setByte("Y", y);
+		auto blocksBuffer = toBuffer(blocks);
+		section->setByteArray("Blocks", blocksBuffer);
+		auto dataBuffer = toBuffer(data);
+		section->setByteArray("Data", dataBuffer);
+		if (withAdd)
+		{
+			auto addBuffer = toBuffer(add);
+			section->setByteArray("Add", addBuffer);
+		}
+
+		auto blockLightBuffer = toBuffer(blockLight);
+		section->setByteArray("BlockLight", blockLightBuffer);
+		if (withSkyLight)
+		{
+			auto skyLightBuffer = toBuffer(skyLight);
+			section->setByteArray("SkyLight", skyLightBuffer);
+		}
+
+		return section;
+	}
+
+	std::unique_ptr<NBTTagCompound> makeChunk(bool extraSectionKey)
+	{
+		auto sections = std::make_unique<NBTTagList>();
+		sections->appendTag(makeSection(0, false, true, true));
+		sections->appendTag(makeSection(1, true, false, true));
+		sections->appendTag(makeSection(2, false, false, false));
+		if (extraSectionKey)
+		{
+			sections->getCompoundTagAt(0)->setString("Palette", "custom");
+		}
+
+		auto level = std::make_unique<NBTTagCompound>();
+		level->setInteger("xPos", -3);
+		level->setInteger("zPos", 7);
+		level->setLong("LastUpdate", 123456789);
+		level->setTag("Sections", std::move(sections));
+
+		auto chunk = std::make_unique<NBTTagCompound>();
+		chunk->setTag("Level", std::move(level));
+		chunk->setInteger("DataVersion", 1343);
+		return chunk;
+	}
+
+	void checkRoundTrip(std::unique_ptr<NBTTagCompound> chunk, std::unique_ptr<NBTTagCompound> expected)
+	{
+		auto encoded = ColumnarChunkCodec::encode(chunk.get());
+		CHECK(ColumnarChunkCodec::isEncoded(encoded));
+
+		auto decoded = ColumnarChunkCodec::decode(encoded);
+		CHECK(*decoded == *expected);
+	}
+}
+
+int main()
+{
+	// native sections
+	checkRoundTrip(makeChunk(false), makeChunk(false));
+
+	// a section key the codec does not know keeps the whole list as NBT
+	checkRoundTrip(makeChunk(true), makeChunk(true));
+
+	// no Level.Sections at all
+	auto bare = std::make_unique<NBTTagCompound>();
+	bare->setInteger("DataVersion", 1343);
+	auto bareExpected = std::make_unique<NBTTagCompound>();
+	bareExpected->setInteger("DataVersion", 1343);
+	checkRoundTrip(std::move(bare), std::move(bareExpected));
+
+	CHECK(!ColumnarChunkCodec::isEncoded("not a chunk"));
+	return 0;
+}